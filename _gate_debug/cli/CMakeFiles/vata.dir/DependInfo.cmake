@@ -0,0 +1,22 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/cli/parse_args.cc" "cli/CMakeFiles/vata.dir/parse_args.cc.o" "gcc" "cli/CMakeFiles/vata.dir/parse_args.cc.o.d"
+  "/root/repo/cli/vata.cc" "cli/CMakeFiles/vata.dir/vata.cc.o" "gcc" "cli/CMakeFiles/vata.dir/vata.cc.o.d"
+  "/root/repo/_gate_debug/cli/version.cc" "cli/CMakeFiles/vata.dir/version.cc.o" "gcc" "cli/CMakeFiles/vata.dir/version.cc.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_gate_debug/src/CMakeFiles/libvata.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,15 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/vata.dir/parse_args.cc.o"
+  "CMakeFiles/vata.dir/parse_args.cc.o.d"
+  "CMakeFiles/vata.dir/vata.cc.o"
+  "CMakeFiles/vata.dir/vata.cc.o.d"
+  "CMakeFiles/vata.dir/version.cc.o"
+  "CMakeFiles/vata.dir/version.cc.o.d"
+  "vata"
+  "vata.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/vata.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
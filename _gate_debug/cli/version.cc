@@ -0,0 +1,24 @@
+/*****************************************************************************
+ *  VATA Tree Automata Library
+ *
+ *  Copyright (c) 2015  Ondra Lengal <ilengal@fit.vutbr.cz>
+ *
+ *  Description:
+ *    The command-line interface to the VATA library - versions
+ *
+ *****************************************************************************/
+
+/**
+ * @brief  The version number
+ */
+const char* VATA_VERSION = "0.5";
+
+/**
+ * @brief  The git SHA of the commit
+ */
+const char* VATA_GIT_SHA = "fa522e428b2eb4e44a67aefc7077765c186a6a46";
+
+/**
+ * @brief  The git --describe output
+ */
+const char* VATA_GIT_DESCRIBE = "-128-NOTFOUND";
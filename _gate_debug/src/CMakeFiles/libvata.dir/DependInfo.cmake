@@ -0,0 +1,80 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/src/aut_base.cc" "src/CMakeFiles/libvata.dir/aut_base.cc.o" "gcc" "src/CMakeFiles/libvata.dir/aut_base.cc.o.d"
+  "/root/repo/src/bdd_bu_tree_aut.cc" "src/CMakeFiles/libvata.dir/bdd_bu_tree_aut.cc.o" "gcc" "src/CMakeFiles/libvata.dir/bdd_bu_tree_aut.cc.o.d"
+  "/root/repo/src/bdd_bu_tree_aut_core.cc" "src/CMakeFiles/libvata.dir/bdd_bu_tree_aut_core.cc.o" "gcc" "src/CMakeFiles/libvata.dir/bdd_bu_tree_aut_core.cc.o.d"
+  "/root/repo/src/bdd_bu_tree_aut_incl.cc" "src/CMakeFiles/libvata.dir/bdd_bu_tree_aut_incl.cc.o" "gcc" "src/CMakeFiles/libvata.dir/bdd_bu_tree_aut_incl.cc.o.d"
+  "/root/repo/src/bdd_bu_tree_aut_isect.cc" "src/CMakeFiles/libvata.dir/bdd_bu_tree_aut_isect.cc.o" "gcc" "src/CMakeFiles/libvata.dir/bdd_bu_tree_aut_isect.cc.o.d"
+  "/root/repo/src/bdd_bu_tree_aut_sim.cc" "src/CMakeFiles/libvata.dir/bdd_bu_tree_aut_sim.cc.o" "gcc" "src/CMakeFiles/libvata.dir/bdd_bu_tree_aut_sim.cc.o.d"
+  "/root/repo/src/bdd_bu_tree_aut_union.cc" "src/CMakeFiles/libvata.dir/bdd_bu_tree_aut_union.cc.o" "gcc" "src/CMakeFiles/libvata.dir/bdd_bu_tree_aut_union.cc.o.d"
+  "/root/repo/src/bdd_bu_tree_aut_union_disj.cc" "src/CMakeFiles/libvata.dir/bdd_bu_tree_aut_union_disj.cc.o" "gcc" "src/CMakeFiles/libvata.dir/bdd_bu_tree_aut_union_disj.cc.o.d"
+  "/root/repo/src/bdd_bu_tree_aut_unreach.cc" "src/CMakeFiles/libvata.dir/bdd_bu_tree_aut_unreach.cc.o" "gcc" "src/CMakeFiles/libvata.dir/bdd_bu_tree_aut_unreach.cc.o.d"
+  "/root/repo/src/bdd_bu_tree_aut_useless.cc" "src/CMakeFiles/libvata.dir/bdd_bu_tree_aut_useless.cc.o" "gcc" "src/CMakeFiles/libvata.dir/bdd_bu_tree_aut_useless.cc.o.d"
+  "/root/repo/src/bdd_td_tree_aut.cc" "src/CMakeFiles/libvata.dir/bdd_td_tree_aut.cc.o" "gcc" "src/CMakeFiles/libvata.dir/bdd_td_tree_aut.cc.o.d"
+  "/root/repo/src/bdd_td_tree_aut_core.cc" "src/CMakeFiles/libvata.dir/bdd_td_tree_aut_core.cc.o" "gcc" "src/CMakeFiles/libvata.dir/bdd_td_tree_aut_core.cc.o.d"
+  "/root/repo/src/bdd_td_tree_aut_incl.cc" "src/CMakeFiles/libvata.dir/bdd_td_tree_aut_incl.cc.o" "gcc" "src/CMakeFiles/libvata.dir/bdd_td_tree_aut_incl.cc.o.d"
+  "/root/repo/src/bdd_td_tree_aut_isect.cc" "src/CMakeFiles/libvata.dir/bdd_td_tree_aut_isect.cc.o" "gcc" "src/CMakeFiles/libvata.dir/bdd_td_tree_aut_isect.cc.o.d"
+  "/root/repo/src/bdd_td_tree_aut_sim.cc" "src/CMakeFiles/libvata.dir/bdd_td_tree_aut_sim.cc.o" "gcc" "src/CMakeFiles/libvata.dir/bdd_td_tree_aut_sim.cc.o.d"
+  "/root/repo/src/bdd_td_tree_aut_union.cc" "src/CMakeFiles/libvata.dir/bdd_td_tree_aut_union.cc.o" "gcc" "src/CMakeFiles/libvata.dir/bdd_td_tree_aut_union.cc.o.d"
+  "/root/repo/src/bdd_td_tree_aut_union_disj.cc" "src/CMakeFiles/libvata.dir/bdd_td_tree_aut_union_disj.cc.o" "gcc" "src/CMakeFiles/libvata.dir/bdd_td_tree_aut_union_disj.cc.o.d"
+  "/root/repo/src/bdd_td_tree_aut_unreach.cc" "src/CMakeFiles/libvata.dir/bdd_td_tree_aut_unreach.cc.o" "gcc" "src/CMakeFiles/libvata.dir/bdd_td_tree_aut_unreach.cc.o.d"
+  "/root/repo/src/bdd_td_tree_aut_useless.cc" "src/CMakeFiles/libvata.dir/bdd_td_tree_aut_useless.cc.o" "gcc" "src/CMakeFiles/libvata.dir/bdd_td_tree_aut_useless.cc.o.d"
+  "/root/repo/src/cancellation_token.cc" "src/CMakeFiles/libvata.dir/cancellation_token.cc.o" "gcc" "src/CMakeFiles/libvata.dir/cancellation_token.cc.o.d"
+  "/root/repo/src/convert.cc" "src/CMakeFiles/libvata.dir/convert.cc.o" "gcc" "src/CMakeFiles/libvata.dir/convert.cc.o.d"
+  "/root/repo/src/explicit_finite_aut.cc" "src/CMakeFiles/libvata.dir/explicit_finite_aut.cc.o" "gcc" "src/CMakeFiles/libvata.dir/explicit_finite_aut.cc.o.d"
+  "/root/repo/src/explicit_finite_aut_core.cc" "src/CMakeFiles/libvata.dir/explicit_finite_aut_core.cc.o" "gcc" "src/CMakeFiles/libvata.dir/explicit_finite_aut_core.cc.o.d"
+  "/root/repo/src/explicit_finite_candidate.cc" "src/CMakeFiles/libvata.dir/explicit_finite_candidate.cc.o" "gcc" "src/CMakeFiles/libvata.dir/explicit_finite_candidate.cc.o.d"
+  "/root/repo/src/explicit_finite_compl.cc" "src/CMakeFiles/libvata.dir/explicit_finite_compl.cc.o" "gcc" "src/CMakeFiles/libvata.dir/explicit_finite_compl.cc.o.d"
+  "/root/repo/src/explicit_finite_incl.cc" "src/CMakeFiles/libvata.dir/explicit_finite_incl.cc.o" "gcc" "src/CMakeFiles/libvata.dir/explicit_finite_incl.cc.o.d"
+  "/root/repo/src/explicit_finite_isect.cc" "src/CMakeFiles/libvata.dir/explicit_finite_isect.cc.o" "gcc" "src/CMakeFiles/libvata.dir/explicit_finite_isect.cc.o.d"
+  "/root/repo/src/explicit_finite_reverse.cc" "src/CMakeFiles/libvata.dir/explicit_finite_reverse.cc.o" "gcc" "src/CMakeFiles/libvata.dir/explicit_finite_reverse.cc.o.d"
+  "/root/repo/src/explicit_finite_sim.cc" "src/CMakeFiles/libvata.dir/explicit_finite_sim.cc.o" "gcc" "src/CMakeFiles/libvata.dir/explicit_finite_sim.cc.o.d"
+  "/root/repo/src/explicit_finite_union.cc" "src/CMakeFiles/libvata.dir/explicit_finite_union.cc.o" "gcc" "src/CMakeFiles/libvata.dir/explicit_finite_union.cc.o.d"
+  "/root/repo/src/explicit_finite_unreach.cc" "src/CMakeFiles/libvata.dir/explicit_finite_unreach.cc.o" "gcc" "src/CMakeFiles/libvata.dir/explicit_finite_unreach.cc.o.d"
+  "/root/repo/src/explicit_finite_useless.cc" "src/CMakeFiles/libvata.dir/explicit_finite_useless.cc.o" "gcc" "src/CMakeFiles/libvata.dir/explicit_finite_useless.cc.o.d"
+  "/root/repo/src/explicit_lts_bisim.cc" "src/CMakeFiles/libvata.dir/explicit_lts_bisim.cc.o" "gcc" "src/CMakeFiles/libvata.dir/explicit_lts_bisim.cc.o.d"
+  "/root/repo/src/explicit_lts_sim.cc" "src/CMakeFiles/libvata.dir/explicit_lts_sim.cc.o" "gcc" "src/CMakeFiles/libvata.dir/explicit_lts_sim.cc.o.d"
+  "/root/repo/src/explicit_tree_aut.cc" "src/CMakeFiles/libvata.dir/explicit_tree_aut.cc.o" "gcc" "src/CMakeFiles/libvata.dir/explicit_tree_aut.cc.o.d"
+  "/root/repo/src/explicit_tree_aut_core.cc" "src/CMakeFiles/libvata.dir/explicit_tree_aut_core.cc.o" "gcc" "src/CMakeFiles/libvata.dir/explicit_tree_aut_core.cc.o.d"
+  "/root/repo/src/explicit_tree_candidate.cc" "src/CMakeFiles/libvata.dir/explicit_tree_candidate.cc.o" "gcc" "src/CMakeFiles/libvata.dir/explicit_tree_candidate.cc.o.d"
+  "/root/repo/src/explicit_tree_comp_down.cc" "src/CMakeFiles/libvata.dir/explicit_tree_comp_down.cc.o" "gcc" "src/CMakeFiles/libvata.dir/explicit_tree_comp_down.cc.o.d"
+  "/root/repo/src/explicit_tree_det.cc" "src/CMakeFiles/libvata.dir/explicit_tree_det.cc.o" "gcc" "src/CMakeFiles/libvata.dir/explicit_tree_det.cc.o.d"
+  "/root/repo/src/explicit_tree_equiv_up.cc" "src/CMakeFiles/libvata.dir/explicit_tree_equiv_up.cc.o" "gcc" "src/CMakeFiles/libvata.dir/explicit_tree_equiv_up.cc.o.d"
+  "/root/repo/src/explicit_tree_incl.cc" "src/CMakeFiles/libvata.dir/explicit_tree_incl.cc.o" "gcc" "src/CMakeFiles/libvata.dir/explicit_tree_incl.cc.o.d"
+  "/root/repo/src/explicit_tree_incl_down.cc" "src/CMakeFiles/libvata.dir/explicit_tree_incl_down.cc.o" "gcc" "src/CMakeFiles/libvata.dir/explicit_tree_incl_down.cc.o.d"
+  "/root/repo/src/explicit_tree_incl_portfolio.cc" "src/CMakeFiles/libvata.dir/explicit_tree_incl_portfolio.cc.o" "gcc" "src/CMakeFiles/libvata.dir/explicit_tree_incl_portfolio.cc.o.d"
+  "/root/repo/src/explicit_tree_incl_up.cc" "src/CMakeFiles/libvata.dir/explicit_tree_incl_up.cc.o" "gcc" "src/CMakeFiles/libvata.dir/explicit_tree_incl_up.cc.o.d"
+  "/root/repo/src/explicit_tree_incr_reach.cc" "src/CMakeFiles/libvata.dir/explicit_tree_incr_reach.cc.o" "gcc" "src/CMakeFiles/libvata.dir/explicit_tree_incr_reach.cc.o.d"
+  "/root/repo/src/explicit_tree_isect.cc" "src/CMakeFiles/libvata.dir/explicit_tree_isect.cc.o" "gcc" "src/CMakeFiles/libvata.dir/explicit_tree_isect.cc.o.d"
+  "/root/repo/src/explicit_tree_isect_bu.cc" "src/CMakeFiles/libvata.dir/explicit_tree_isect_bu.cc.o" "gcc" "src/CMakeFiles/libvata.dir/explicit_tree_isect_bu.cc.o.d"
+  "/root/repo/src/explicit_tree_isect_empty.cc" "src/CMakeFiles/libvata.dir/explicit_tree_isect_empty.cc.o" "gcc" "src/CMakeFiles/libvata.dir/explicit_tree_isect_empty.cc.o.d"
+  "/root/repo/src/explicit_tree_isect_par.cc" "src/CMakeFiles/libvata.dir/explicit_tree_isect_par.cc.o" "gcc" "src/CMakeFiles/libvata.dir/explicit_tree_isect_par.cc.o.d"
+  "/root/repo/src/explicit_tree_min.cc" "src/CMakeFiles/libvata.dir/explicit_tree_min.cc.o" "gcc" "src/CMakeFiles/libvata.dir/explicit_tree_min.cc.o.d"
+  "/root/repo/src/explicit_tree_sim.cc" "src/CMakeFiles/libvata.dir/explicit_tree_sim.cc.o" "gcc" "src/CMakeFiles/libvata.dir/explicit_tree_sim.cc.o.d"
+  "/root/repo/src/explicit_tree_sim_incr.cc" "src/CMakeFiles/libvata.dir/explicit_tree_sim_incr.cc.o" "gcc" "src/CMakeFiles/libvata.dir/explicit_tree_sim_incr.cc.o.d"
+  "/root/repo/src/explicit_tree_union.cc" "src/CMakeFiles/libvata.dir/explicit_tree_union.cc.o" "gcc" "src/CMakeFiles/libvata.dir/explicit_tree_union.cc.o.d"
+  "/root/repo/src/explicit_tree_unreach.cc" "src/CMakeFiles/libvata.dir/explicit_tree_unreach.cc.o" "gcc" "src/CMakeFiles/libvata.dir/explicit_tree_unreach.cc.o.d"
+  "/root/repo/src/explicit_tree_useless.cc" "src/CMakeFiles/libvata.dir/explicit_tree_useless.cc.o" "gcc" "src/CMakeFiles/libvata.dir/explicit_tree_useless.cc.o.d"
+  "/root/repo/src/incl_param.cc" "src/CMakeFiles/libvata.dir/incl_param.cc.o" "gcc" "src/CMakeFiles/libvata.dir/incl_param.cc.o.d"
+  "/root/repo/src/sym_var_asgn.cc" "src/CMakeFiles/libvata.dir/sym_var_asgn.cc.o" "gcc" "src/CMakeFiles/libvata.dir/sym_var_asgn.cc.o.d"
+  "/root/repo/src/symbolic.cc" "src/CMakeFiles/libvata.dir/symbolic.cc.o" "gcc" "src/CMakeFiles/libvata.dir/symbolic.cc.o.d"
+  "/root/repo/src/symbolic_tree_aut_base_core.cc" "src/CMakeFiles/libvata.dir/symbolic_tree_aut_base_core.cc.o" "gcc" "src/CMakeFiles/libvata.dir/symbolic_tree_aut_base_core.cc.o.d"
+  "/root/repo/src/timbuk_parser-nobison.cc" "src/CMakeFiles/libvata.dir/timbuk_parser-nobison.cc.o" "gcc" "src/CMakeFiles/libvata.dir/timbuk_parser-nobison.cc.o.d"
+  "/root/repo/src/timbuk_serializer.cc" "src/CMakeFiles/libvata.dir/timbuk_serializer.cc.o" "gcc" "src/CMakeFiles/libvata.dir/timbuk_serializer.cc.o.d"
+  "/root/repo/src/util.cc" "src/CMakeFiles/libvata.dir/util.cc.o" "gcc" "src/CMakeFiles/libvata.dir/util.cc.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,133 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/libvata.dir/aut_base.cc.o"
+  "CMakeFiles/libvata.dir/aut_base.cc.o.d"
+  "CMakeFiles/libvata.dir/bdd_bu_tree_aut.cc.o"
+  "CMakeFiles/libvata.dir/bdd_bu_tree_aut.cc.o.d"
+  "CMakeFiles/libvata.dir/bdd_bu_tree_aut_core.cc.o"
+  "CMakeFiles/libvata.dir/bdd_bu_tree_aut_core.cc.o.d"
+  "CMakeFiles/libvata.dir/bdd_bu_tree_aut_incl.cc.o"
+  "CMakeFiles/libvata.dir/bdd_bu_tree_aut_incl.cc.o.d"
+  "CMakeFiles/libvata.dir/bdd_bu_tree_aut_isect.cc.o"
+  "CMakeFiles/libvata.dir/bdd_bu_tree_aut_isect.cc.o.d"
+  "CMakeFiles/libvata.dir/bdd_bu_tree_aut_sim.cc.o"
+  "CMakeFiles/libvata.dir/bdd_bu_tree_aut_sim.cc.o.d"
+  "CMakeFiles/libvata.dir/bdd_bu_tree_aut_union.cc.o"
+  "CMakeFiles/libvata.dir/bdd_bu_tree_aut_union.cc.o.d"
+  "CMakeFiles/libvata.dir/bdd_bu_tree_aut_union_disj.cc.o"
+  "CMakeFiles/libvata.dir/bdd_bu_tree_aut_union_disj.cc.o.d"
+  "CMakeFiles/libvata.dir/bdd_bu_tree_aut_unreach.cc.o"
+  "CMakeFiles/libvata.dir/bdd_bu_tree_aut_unreach.cc.o.d"
+  "CMakeFiles/libvata.dir/bdd_bu_tree_aut_useless.cc.o"
+  "CMakeFiles/libvata.dir/bdd_bu_tree_aut_useless.cc.o.d"
+  "CMakeFiles/libvata.dir/bdd_td_tree_aut.cc.o"
+  "CMakeFiles/libvata.dir/bdd_td_tree_aut.cc.o.d"
+  "CMakeFiles/libvata.dir/bdd_td_tree_aut_core.cc.o"
+  "CMakeFiles/libvata.dir/bdd_td_tree_aut_core.cc.o.d"
+  "CMakeFiles/libvata.dir/bdd_td_tree_aut_incl.cc.o"
+  "CMakeFiles/libvata.dir/bdd_td_tree_aut_incl.cc.o.d"
+  "CMakeFiles/libvata.dir/bdd_td_tree_aut_isect.cc.o"
+  "CMakeFiles/libvata.dir/bdd_td_tree_aut_isect.cc.o.d"
+  "CMakeFiles/libvata.dir/bdd_td_tree_aut_sim.cc.o"
+  "CMakeFiles/libvata.dir/bdd_td_tree_aut_sim.cc.o.d"
+  "CMakeFiles/libvata.dir/bdd_td_tree_aut_union.cc.o"
+  "CMakeFiles/libvata.dir/bdd_td_tree_aut_union.cc.o.d"
+  "CMakeFiles/libvata.dir/bdd_td_tree_aut_union_disj.cc.o"
+  "CMakeFiles/libvata.dir/bdd_td_tree_aut_union_disj.cc.o.d"
+  "CMakeFiles/libvata.dir/bdd_td_tree_aut_unreach.cc.o"
+  "CMakeFiles/libvata.dir/bdd_td_tree_aut_unreach.cc.o.d"
+  "CMakeFiles/libvata.dir/bdd_td_tree_aut_useless.cc.o"
+  "CMakeFiles/libvata.dir/bdd_td_tree_aut_useless.cc.o.d"
+  "CMakeFiles/libvata.dir/cancellation_token.cc.o"
+  "CMakeFiles/libvata.dir/cancellation_token.cc.o.d"
+  "CMakeFiles/libvata.dir/convert.cc.o"
+  "CMakeFiles/libvata.dir/convert.cc.o.d"
+  "CMakeFiles/libvata.dir/explicit_finite_aut.cc.o"
+  "CMakeFiles/libvata.dir/explicit_finite_aut.cc.o.d"
+  "CMakeFiles/libvata.dir/explicit_finite_aut_core.cc.o"
+  "CMakeFiles/libvata.dir/explicit_finite_aut_core.cc.o.d"
+  "CMakeFiles/libvata.dir/explicit_finite_candidate.cc.o"
+  "CMakeFiles/libvata.dir/explicit_finite_candidate.cc.o.d"
+  "CMakeFiles/libvata.dir/explicit_finite_compl.cc.o"
+  "CMakeFiles/libvata.dir/explicit_finite_compl.cc.o.d"
+  "CMakeFiles/libvata.dir/explicit_finite_incl.cc.o"
+  "CMakeFiles/libvata.dir/explicit_finite_incl.cc.o.d"
+  "CMakeFiles/libvata.dir/explicit_finite_isect.cc.o"
+  "CMakeFiles/libvata.dir/explicit_finite_isect.cc.o.d"
+  "CMakeFiles/libvata.dir/explicit_finite_reverse.cc.o"
+  "CMakeFiles/libvata.dir/explicit_finite_reverse.cc.o.d"
+  "CMakeFiles/libvata.dir/explicit_finite_sim.cc.o"
+  "CMakeFiles/libvata.dir/explicit_finite_sim.cc.o.d"
+  "CMakeFiles/libvata.dir/explicit_finite_union.cc.o"
+  "CMakeFiles/libvata.dir/explicit_finite_union.cc.o.d"
+  "CMakeFiles/libvata.dir/explicit_finite_unreach.cc.o"
+  "CMakeFiles/libvata.dir/explicit_finite_unreach.cc.o.d"
+  "CMakeFiles/libvata.dir/explicit_finite_useless.cc.o"
+  "CMakeFiles/libvata.dir/explicit_finite_useless.cc.o.d"
+  "CMakeFiles/libvata.dir/explicit_lts_bisim.cc.o"
+  "CMakeFiles/libvata.dir/explicit_lts_bisim.cc.o.d"
+  "CMakeFiles/libvata.dir/explicit_lts_sim.cc.o"
+  "CMakeFiles/libvata.dir/explicit_lts_sim.cc.o.d"
+  "CMakeFiles/libvata.dir/explicit_tree_aut.cc.o"
+  "CMakeFiles/libvata.dir/explicit_tree_aut.cc.o.d"
+  "CMakeFiles/libvata.dir/explicit_tree_aut_core.cc.o"
+  "CMakeFiles/libvata.dir/explicit_tree_aut_core.cc.o.d"
+  "CMakeFiles/libvata.dir/explicit_tree_candidate.cc.o"
+  "CMakeFiles/libvata.dir/explicit_tree_candidate.cc.o.d"
+  "CMakeFiles/libvata.dir/explicit_tree_comp_down.cc.o"
+  "CMakeFiles/libvata.dir/explicit_tree_comp_down.cc.o.d"
+  "CMakeFiles/libvata.dir/explicit_tree_det.cc.o"
+  "CMakeFiles/libvata.dir/explicit_tree_det.cc.o.d"
+  "CMakeFiles/libvata.dir/explicit_tree_equiv_up.cc.o"
+  "CMakeFiles/libvata.dir/explicit_tree_equiv_up.cc.o.d"
+  "CMakeFiles/libvata.dir/explicit_tree_incl.cc.o"
+  "CMakeFiles/libvata.dir/explicit_tree_incl.cc.o.d"
+  "CMakeFiles/libvata.dir/explicit_tree_incl_down.cc.o"
+  "CMakeFiles/libvata.dir/explicit_tree_incl_down.cc.o.d"
+  "CMakeFiles/libvata.dir/explicit_tree_incl_portfolio.cc.o"
+  "CMakeFiles/libvata.dir/explicit_tree_incl_portfolio.cc.o.d"
+  "CMakeFiles/libvata.dir/explicit_tree_incl_up.cc.o"
+  "CMakeFiles/libvata.dir/explicit_tree_incl_up.cc.o.d"
+  "CMakeFiles/libvata.dir/explicit_tree_incr_reach.cc.o"
+  "CMakeFiles/libvata.dir/explicit_tree_incr_reach.cc.o.d"
+  "CMakeFiles/libvata.dir/explicit_tree_isect.cc.o"
+  "CMakeFiles/libvata.dir/explicit_tree_isect.cc.o.d"
+  "CMakeFiles/libvata.dir/explicit_tree_isect_bu.cc.o"
+  "CMakeFiles/libvata.dir/explicit_tree_isect_bu.cc.o.d"
+  "CMakeFiles/libvata.dir/explicit_tree_isect_empty.cc.o"
+  "CMakeFiles/libvata.dir/explicit_tree_isect_empty.cc.o.d"
+  "CMakeFiles/libvata.dir/explicit_tree_isect_par.cc.o"
+  "CMakeFiles/libvata.dir/explicit_tree_isect_par.cc.o.d"
+  "CMakeFiles/libvata.dir/explicit_tree_min.cc.o"
+  "CMakeFiles/libvata.dir/explicit_tree_min.cc.o.d"
+  "CMakeFiles/libvata.dir/explicit_tree_sim.cc.o"
+  "CMakeFiles/libvata.dir/explicit_tree_sim.cc.o.d"
+  "CMakeFiles/libvata.dir/explicit_tree_sim_incr.cc.o"
+  "CMakeFiles/libvata.dir/explicit_tree_sim_incr.cc.o.d"
+  "CMakeFiles/libvata.dir/explicit_tree_union.cc.o"
+  "CMakeFiles/libvata.dir/explicit_tree_union.cc.o.d"
+  "CMakeFiles/libvata.dir/explicit_tree_unreach.cc.o"
+  "CMakeFiles/libvata.dir/explicit_tree_unreach.cc.o.d"
+  "CMakeFiles/libvata.dir/explicit_tree_useless.cc.o"
+  "CMakeFiles/libvata.dir/explicit_tree_useless.cc.o.d"
+  "CMakeFiles/libvata.dir/incl_param.cc.o"
+  "CMakeFiles/libvata.dir/incl_param.cc.o.d"
+  "CMakeFiles/libvata.dir/sym_var_asgn.cc.o"
+  "CMakeFiles/libvata.dir/sym_var_asgn.cc.o.d"
+  "CMakeFiles/libvata.dir/symbolic.cc.o"
+  "CMakeFiles/libvata.dir/symbolic.cc.o.d"
+  "CMakeFiles/libvata.dir/symbolic_tree_aut_base_core.cc.o"
+  "CMakeFiles/libvata.dir/symbolic_tree_aut_base_core.cc.o.d"
+  "CMakeFiles/libvata.dir/timbuk_parser-nobison.cc.o"
+  "CMakeFiles/libvata.dir/timbuk_parser-nobison.cc.o.d"
+  "CMakeFiles/libvata.dir/timbuk_serializer.cc.o"
+  "CMakeFiles/libvata.dir/timbuk_serializer.cc.o.d"
+  "CMakeFiles/libvata.dir/util.cc.o"
+  "CMakeFiles/libvata.dir/util.cc.o.d"
+  "libvata.a"
+  "libvata.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/libvata.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
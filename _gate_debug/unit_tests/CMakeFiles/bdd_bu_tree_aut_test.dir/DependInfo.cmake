@@ -0,0 +1,21 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/unit_tests/bdd_bu_tree_aut_test.cc" "unit_tests/CMakeFiles/bdd_bu_tree_aut_test.dir/bdd_bu_tree_aut_test.cc.o" "gcc" "unit_tests/CMakeFiles/bdd_bu_tree_aut_test.dir/bdd_bu_tree_aut_test.cc.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_gate_debug/unit_tests/CMakeFiles/tests.dir/DependInfo.cmake"
+  "/root/repo/_gate_debug/src/CMakeFiles/libvata.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/bdd_bu_tree_aut_test.dir/bdd_bu_tree_aut_test.cc.o"
+  "CMakeFiles/bdd_bu_tree_aut_test.dir/bdd_bu_tree_aut_test.cc.o.d"
+  "bdd_bu_tree_aut_test"
+  "bdd_bu_tree_aut_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/bdd_bu_tree_aut_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
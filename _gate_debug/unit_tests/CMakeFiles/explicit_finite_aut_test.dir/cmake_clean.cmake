@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/explicit_finite_aut_test.dir/explicit_finite_aut_test.cc.o"
+  "CMakeFiles/explicit_finite_aut_test.dir/explicit_finite_aut_test.cc.o.d"
+  "explicit_finite_aut_test"
+  "explicit_finite_aut_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/explicit_finite_aut_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/ondriks_mtbdd_c_test.dir/ondriks_mtbdd_c_test.cc.o"
+  "CMakeFiles/ondriks_mtbdd_c_test.dir/ondriks_mtbdd_c_test.cc.o.d"
+  "ondriks_mtbdd_c_test"
+  "ondriks_mtbdd_c_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/ondriks_mtbdd_c_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
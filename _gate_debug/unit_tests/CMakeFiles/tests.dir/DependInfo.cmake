@@ -0,0 +1,20 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/unit_tests/formula_parser.cc" "unit_tests/CMakeFiles/tests.dir/formula_parser.cc.o" "gcc" "unit_tests/CMakeFiles/tests.dir/formula_parser.cc.o.d"
+  "/root/repo/unit_tests/log_fixture.cc" "unit_tests/CMakeFiles/tests.dir/log_fixture.cc.o" "gcc" "unit_tests/CMakeFiles/tests.dir/log_fixture.cc.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/tests.dir/formula_parser.cc.o"
+  "CMakeFiles/tests.dir/formula_parser.cc.o.d"
+  "CMakeFiles/tests.dir/log_fixture.cc.o"
+  "CMakeFiles/tests.dir/log_fixture.cc.o.d"
+  "libtests.a"
+  "libtests.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/tests.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/timbuk_parser_test.dir/timbuk_parser_test.cc.o"
+  "CMakeFiles/timbuk_parser_test.dir/timbuk_parser_test.cc.o.d"
+  "timbuk_parser_test"
+  "timbuk_parser_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/timbuk_parser_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
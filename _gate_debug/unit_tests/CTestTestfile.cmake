@@ -0,0 +1,20 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/unit_tests
+# Build directory: /root/repo/_gate_debug/unit_tests
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test(ondriks_mtbdd_c_test "/root/repo/_gate_debug/unit_tests/ondriks_mtbdd_c_test")
+set_tests_properties(ondriks_mtbdd_c_test PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/unit_tests/CMakeLists.txt;66;add_test;/root/repo/unit_tests/CMakeLists.txt;0;")
+add_test(timbuk_parser_test "/root/repo/_gate_debug/unit_tests/timbuk_parser_test")
+set_tests_properties(timbuk_parser_test PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/unit_tests/CMakeLists.txt;66;add_test;/root/repo/unit_tests/CMakeLists.txt;0;")
+add_test(bdd_bu_tree_aut_test "/root/repo/_gate_debug/unit_tests/bdd_bu_tree_aut_test")
+set_tests_properties(bdd_bu_tree_aut_test PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/unit_tests/CMakeLists.txt;66;add_test;/root/repo/unit_tests/CMakeLists.txt;0;")
+add_test(bdd_td_tree_aut_test "/root/repo/_gate_debug/unit_tests/bdd_td_tree_aut_test")
+set_tests_properties(bdd_td_tree_aut_test PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/unit_tests/CMakeLists.txt;66;add_test;/root/repo/unit_tests/CMakeLists.txt;0;")
+add_test(explicit_tree_aut_test "/root/repo/_gate_debug/unit_tests/explicit_tree_aut_test")
+set_tests_properties(explicit_tree_aut_test PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/unit_tests/CMakeLists.txt;66;add_test;/root/repo/unit_tests/CMakeLists.txt;0;")
+add_test(arena_test "/root/repo/_gate_debug/unit_tests/arena_test")
+set_tests_properties(arena_test PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/unit_tests/CMakeLists.txt;66;add_test;/root/repo/unit_tests/CMakeLists.txt;0;")
+add_test(explicit_finite_aut_test "/root/repo/_gate_debug/unit_tests/explicit_finite_aut_test")
+set_tests_properties(explicit_finite_aut_test PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/unit_tests/CMakeLists.txt;66;add_test;/root/repo/unit_tests/CMakeLists.txt;0;")
@@ -16,6 +16,8 @@
 
 // VATA headers
 #include <vata/vata.hh>
+#include <vata/explicit_tree_aut.hh>
+#include <vata/reduce_param.hh>
 
 // local headers
 #include "parse_args.hh"
@@ -30,6 +32,23 @@ using TimePoint = std::chrono::time_point<high_resolution_clock>;
 
 TimePoint startTime;
 
+/**
+ * @brief  Portfolio inclusion, which is supported only for explicit tree automata
+ */
+template <class Automaton>
+bool CheckInclusionPortfolio(const Automaton&, const Automaton&)
+{
+	throw std::runtime_error("Portfolio inclusion is supported only for "
+		"explicit tree automata");
+}
+
+bool CheckInclusionPortfolio(
+	const VATA::ExplicitTreeAut&      smaller,
+	const VATA::ExplicitTreeAut&      bigger)
+{
+	return VATA::ExplicitTreeAut::CheckInclusionPortfolio(smaller, bigger);
+}
+
 template <class Automaton>
 bool CheckInclusion(Automaton smaller, Automaton bigger, const Arguments& args)
 {
@@ -42,12 +61,22 @@ bool CheckInclusion(Automaton smaller, Automaton bigger, const Arguments& args)
 	options.insert(std::make_pair("rec", "no"));
 	options.insert(std::make_pair("alg", "antichains"));
 	options.insert(std::make_pair("order", "depth"));
+	options.insert(std::make_pair("portfolio", "no"));
+	options.insert(std::make_pair("dense", "yes"));
 
 	std::runtime_error optErrorEx("Invalid options for inclusion: " +
 			Convert::ToString(options));
 
 	AutBase::StateType states = AutBase::SanitizeAutsForInclusion(smaller, bigger);
 
+	if (options["portfolio"] == "yes")
+	{	// race several configurations, the other options are ignored
+		startTime = high_resolution_clock::now();
+
+		return CheckInclusionPortfolio(smaller, bigger);
+	}
+	else if (options["portfolio"] != "no") { throw optErrorEx; }
+
 	/****************************************************************************
 	 *                        Parsing of input parameters
 	 ****************************************************************************/
@@ -120,6 +149,13 @@ bool CheckInclusion(Automaton smaller, Automaton bigger, const Arguments& args)
 	}
 	else {throw optErrorEx; }
 
+	// dense macrostates (finite automata below the default number of states)
+	if (options["dense"] == "no")
+	{
+		ip.SetDenseMacroStateLimit(0);
+	}
+	else if (options["dense"] != "yes") { throw optErrorEx; }
+
 	bool incl_sim_time = false;
 	if (options["timeS"] == "no")
 	{
@@ -271,6 +307,69 @@ Automaton ComputeReduction(
 	}
 }
 
+/**
+ * @brief  Reduction of explicit tree automata, which supports more relations
+ */
+VATA::ExplicitTreeAut ComputeReduction(
+	VATA::ExplicitTreeAut      aut,
+	const Arguments&           args)
+{
+	using VATA::ReduceParam;
+
+	// insert default values
+	Options options = args.options;
+	options.insert(std::make_pair("dir", "down"));
+	options.insert(std::make_pair("rel", "sim"));
+
+	ReduceParam params;
+	if ((options["rel"] == "bisim") && (options["dir"] == "down"))
+	{
+		params.SetRelation(ReduceParam::e_reduce_relation::TA_BISIMULATION);
+	}
+	else if (options["rel"] != "sim")
+	{
+		throw std::runtime_error("Invalid options for reduction: " +
+			Convert::ToString(options));
+	}
+	else if (options["dir"] == "down")
+	{
+		params.SetRelation(ReduceParam::e_reduce_relation::TA_DOWNWARD);
+	}
+	else if (options["dir"] == "up")
+	{
+		params.SetRelation(ReduceParam::e_reduce_relation::TA_UPWARD);
+	}
+	else if (options["dir"] == "downup")
+	{
+		params.SetRelation(ReduceParam::e_reduce_relation::TA_DOWNWARD_UPWARD);
+	}
+	else
+	{
+		throw std::runtime_error("Invalid options for reduction: " +
+			Convert::ToString(options));
+	}
+
+	return aut.Reduce(params);
+}
+
+/**
+ * @brief  Equivalence checking, which is supported only for explicit tree
+ *         automata
+ */
+template <class Automaton>
+bool CheckEquivalence(const Automaton&, const Automaton&, const InclParam&)
+{
+	throw std::runtime_error("Equivalence not implemented");
+}
+
+bool CheckEquivalence(
+	const VATA::ExplicitTreeAut&      lhs,
+	const VATA::ExplicitTreeAut&      rhs,
+	const InclParam&                  params)
+{
+	return VATA::ExplicitTreeAut::CheckEquivalence(lhs, rhs, params);
+}
+
 template <class Automaton>
 bool CheckEquiv(Automaton smaller, Automaton bigger, const Arguments& args)
 {
@@ -299,9 +398,6 @@ bool CheckEquiv(Automaton smaller, Automaton bigger, const Arguments& args)
 	}
 	else { throw optErrorEx; }
 
-	// TODO: change
-	throw std::runtime_error("Equivalence not implemented");
-	// assert(false);
-	// return Automaton::CheckInclusion(smaller, bigger, ip);
+	return CheckEquivalence(smaller, bigger, ip);
 }
 #endif
@@ -72,8 +72,11 @@ const char VATA_USAGE_COMMANDS[] =
 	"               finite automata: 'dir=fwd'  : forward simulation (default)\n"
 	"                                'dir=bwd'  : backward simulation\n"
 	"    red <file>   Reduces the automaton in <file> using simulation relation\n"
-	"      Options: 'dir=down' : downward simulation (default)\n"
-	"               'dir=up'   : upward simulation\n"
+	"      Options: 'dir=down'   : downward simulation (default)\n"
+	"               'dir=up'     : upward simulation\n"
+	"               'dir=downup' : downward, then upward simulation [explicit]\n"
+	"               'rel=sim'    : use simulation (default)\n"
+	"               'rel=bisim'  : use downward bisimulation [explicit]\n"
 	"    equiv <file1> <file2>   Checks whether L(<file1>) == L(<file2>)\n"
 	"      Options: 'order=depth': use depth-first search for congruence algorithm (default)\n"
 	"               'order=breadth': use breadth-first search for congruence algorithm\n"
@@ -92,6 +95,12 @@ const char VATA_USAGE_COMMANDS[] =
 	"               'rec=yes'  : non-recursive version of the algorithm\n"
 	"               'timeS=yes': include time of simulation computation (default)\n"
 	"               'timeS=no' : do not include time of simulation computation\n"
+	"               'portfolio=yes': run several configurations concurrently and take\n"
+	"                                the first answer, ignores other options [explicit]\n"
+	"               'portfolio=no' : run the configuration given by the options (default)\n"
+	"               'dense=yes': compare macrostates of small automata as bit vectors\n"
+	"                            (default) [expl_fa]\n"
+	"               'dense=no' : do not use bit vectors for macrostates\n"
 	"\nGeneral options:\n"
 	"               'symbolic=no'  : use explicit encoding of input file\n"
 	"               'symbolic=yes' : use symbolic encoding of input file\n"
@@ -20,6 +20,7 @@
 
 // Utilities
 #include <vata/util/binary_relation.hh>
+#include <vata/util/sparse_binary_relation.hh>
 #include <vata/util/two_way_dict.hh>
 #include <vata/util/transl_weak.hh>
 #include <vata/util/transl_strict.hh>
@@ -83,6 +84,7 @@ public:   // data types
 
 	using StateBinaryRelation = Util::BinaryRelation;
 	using StateDiscontBinaryRelation = Util::DiscontBinaryRelation;
+	using StateSparseDiscontBinaryRelation = Util::SparseDiscontBinaryRelation;
 
 protected:// methods
 
@@ -0,0 +1,238 @@
+/*****************************************************************************
+ *  VATA Tree Automata Library
+ *
+ *  Copyright (c) 2015  Ondra Lengal <ilengal@fit.vutbr.cz>
+ *
+ *  Description:
+ *    Header file for the cancellation token of long-running operations.
+ *
+ *****************************************************************************/
+
+#ifndef _VATA_CANCELLATION_TOKEN_HH_
+#define _VATA_CANCELLATION_TOKEN_HH_
+
+// Standard library headers
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+
+namespace VATA
+{
+	class CancellationToken;
+	class OperationCancelledException;
+}
+
+
+/**
+ * @brief  An exception thrown by an operation that has been cancelled
+ *
+ * The reason tells whether the operation was cancelled explicitly or whether
+ * it exceeded one of the budgets of its token.
+ */
+class VATA::OperationCancelledException : public std::runtime_error
+{
+public:   // data types
+
+	enum class e_reason
+	{
+		/// the token was cancelled by CancellationToken::Cancel()
+		cancelled,
+		/// the deadline of the token passed
+		deadline,
+		/// the step budget of the token was exhausted
+		steps,
+		/// the resident memory of the process exceeded the memory budget
+		memory
+	};
+
+private:  // data members
+
+	e_reason reason_;
+
+private:  // methods
+
+	static const char* reasonToString(e_reason reason);
+
+public:   // methods
+
+	explicit OperationCancelledException(e_reason reason = e_reason::cancelled) :
+		std::runtime_error(reasonToString(reason)),
+		reason_(reason)
+	{ }
+
+	e_reason GetReason() const
+	{
+		return reason_;
+	}
+};
+
+
+/**
+ * @brief  A token for cooperative cancellation of operations
+ *
+ * An operation given the token polls it in its inner loops and throws
+ * OperationCancelledException once the token is cancelled.  The token may be
+ * cancelled from any thread.
+ *
+ * Besides explicit cancellation, the token may bound the operation by
+ * a deadline, by a number of polls (steps) and by the resident memory of the
+ * process.  An exceeded budget cancels the token for good.  The deadline is
+ * checked at the first poll and then every @p DEADLINE_PERIOD polls, the
+ * memory every @p MEMORY_PERIOD polls, so polling stays cheap.
+ *
+ * A token may have a parent; it is then cancelled also when its parent is,
+ * and the polls are counted for the parent, too.
+ */
+class VATA::CancellationToken
+{
+public:   // data types
+
+	using e_reason  = OperationCancelledException::e_reason;
+	using Clock     = std::chrono::steady_clock;
+
+private:  // constants
+
+	static const size_t DEADLINE_PERIOD = 0x100;
+	static const size_t MEMORY_PERIOD = 0x10000;
+
+	/// the value of @p reason_ of a token which is not cancelled
+	static const int NOT_CANCELLED = -1;
+
+private:  // data members
+
+	const CancellationToken* parent_;
+
+	/// the reason of cancellation, or @p NOT_CANCELLED
+	mutable std::atomic<int> reason_;
+
+	/// the number of polls so far
+	mutable std::atomic<size_t> steps_;
+
+	size_t stepBudget_;
+	size_t memoryBudget_;
+
+	bool hasDeadline_;
+	Clock::time_point deadline_;
+
+private:  // methods
+
+	CancellationToken(const CancellationToken&);
+	CancellationToken& operator=(const CancellationToken&);
+
+	/**
+	 * @brief  Checks the budgets of the token after @p steps polls
+	 */
+	void checkBudgets(size_t steps) const;
+
+	void cancel(e_reason reason) const
+	{
+		int expected = NOT_CANCELLED;
+		reason_.compare_exchange_strong(expected, static_cast<int>(reason));
+	}
+
+public:   // methods
+
+	explicit CancellationToken(const CancellationToken* parent = nullptr) :
+		parent_(parent),
+		reason_(NOT_CANCELLED),
+		steps_(0),
+		stepBudget_(std::numeric_limits<size_t>::max()),
+		memoryBudget_(0),
+		hasDeadline_(false),
+		deadline_()
+	{ }
+
+	void Cancel()
+	{
+		this->cancel(e_reason::cancelled);
+	}
+
+	bool IsCancelled() const
+	{
+		return (NOT_CANCELLED != reason_) ||
+			((nullptr != parent_) && parent_->IsCancelled());
+	}
+
+	/**
+	 * @brief  Returns the reason of the cancellation
+	 *
+	 * Valid only if the token is cancelled.
+	 */
+	e_reason GetReason() const;
+
+	/**
+	 * @brief  Sets the point in time after which operations are cancelled
+	 */
+	void SetDeadline(const Clock::time_point& deadline)
+	{
+		hasDeadline_ = true;
+		deadline_ = deadline;
+	}
+
+	/**
+	 * @brief  Sets the deadline to @p timeout from now
+	 */
+	void SetTimeout(const Clock::duration& timeout)
+	{
+		this->SetDeadline(Clock::now() + timeout);
+	}
+
+	/**
+	 * @brief  Sets the maximum number of polls of the token
+	 */
+	void SetStepBudget(size_t steps)
+	{
+		stepBudget_ = steps;
+	}
+
+	/**
+	 * @brief  Sets the maximum resident memory of the process in bytes
+	 *
+	 * 0 denotes no limit.  The budget is ignored on systems where the resident
+	 * memory cannot be determined.
+	 */
+	void SetMemoryBudget(size_t bytes)
+	{
+		memoryBudget_ = bytes;
+	}
+
+	/**
+	 * @brief  Returns the number of polls of the token so far
+	 */
+	size_t GetSteps() const
+	{
+		return steps_;
+	}
+
+	/**
+	 * @brief  Throws OperationCancelledException if the token is cancelled
+	 *
+	 * Every call counts as one step of the step budget.
+	 */
+	void Poll() const
+	{
+		size_t steps = ++steps_;
+
+		if ((NOT_CANCELLED != reason_) || (steps > stepBudget_) ||
+			(1 == steps) || (0 == steps % DEADLINE_PERIOD))
+		{
+			this->checkBudgets(steps);
+		}
+
+		if (nullptr != parent_)
+		{
+			parent_->Poll();
+		}
+	}
+
+	/**
+	 * @brief  Returns the resident memory of the process in bytes
+	 *
+	 * Returns 0 if it cannot be determined.
+	 */
+	static size_t GetResidentMemory();
+};
+
+#endif
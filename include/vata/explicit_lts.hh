@@ -11,9 +11,13 @@
 #ifndef _VATA_EXPLICIT_LTS_HH_
 #define _VATA_EXPLICIT_LTS_HH_
 
+#include <cassert>
+#include <ostream>
 #include <vector>
 
+#include <vata/cancellation_token.hh>
 #include <vata/util/binary_relation.hh>
+#include <vata/util/sparse_binary_relation.hh>
 #include <vata/util/smart_set.hh>
 
 
@@ -21,15 +25,93 @@ namespace VATA { class ExplicitLTS; }
 
 class VATA::ExplicitLTS {
 
+public:   // data types
+
+	/**
+	 * @brief  A contiguous range of states
+	 */
+	class Range
+	{
+		const size_t* begin_;
+		const size_t* end_;
+
+	public:
+
+		Range(const size_t* begin, const size_t* end) :
+			begin_(begin),
+			end_(end)
+		{ }
+
+		const size_t* begin() const { return begin_; }
+		const size_t* end() const { return end_; }
+		size_t size() const { return static_cast<size_t>(end_ - begin_); }
+		bool empty() const { return begin_ == end_; }
+	};
+
+	/**
+	 * @brief  Successors (or predecessors) of all states over a label
+	 *
+	 * The range of the state @p q is <tt>(*this)[q]</tt>.
+	 */
+	class Adjacency
+	{
+		const size_t* offsets_;
+		const size_t* targets_;
+		size_t states_;
+
+	public:
+
+		Adjacency(const size_t* offsets, const size_t* targets, size_t states) :
+			offsets_(offsets),
+			targets_(targets),
+			states_(states)
+		{ }
+
+		Range operator[](size_t q) const
+		{
+			assert(q < states_);
+
+			return Range(targets_ + offsets_[q], targets_ + offsets_[q + 1]);
+		}
+
+		size_t size() const { return states_; }
+	};
+
+private:  // data types
+
+	struct PendingTransition
+	{
+		size_t q_;
+		size_t a_;
+		size_t r_;
+	};
+
+private:  // data members
+
 	size_t states_;
 	size_t transitions_;
-	std::vector<
-		std::pair<
-			std::vector<std::vector<size_t>>,
-			std::vector<std::vector<size_t>>
-		>
-	> data_;
-	std::vector<Util::SmartSet> bwLabels_;
+	size_t labels_;
+
+	/// transitions added before init()
+	std::vector<PendingTransition> pending_;
+
+	/**
+	 * @brief  Compressed sparse rows of successors
+	 *
+	 * The successors of @p q over @p a are stored in @p postTargets_ between
+	 * the positions @p postOffsets_[a*(states_ + 1) + q] and
+	 * @p postOffsets_[a*(states_ + 1) + q + 1].
+	 */
+	std::vector<size_t> postOffsets_;
+	std::vector<size_t> postTargets_;
+
+	/// compressed sparse rows of predecessors (the same layout as for successors)
+	std::vector<size_t> preOffsets_;
+	std::vector<size_t> preSources_;
+
+	/// for every state, the labels of the transitions leading to it
+	std::vector<size_t> bwLabelOffsets_;
+	std::vector<size_t> bwLabels_;
 
 public:
 
@@ -41,81 +123,96 @@ public:
 	ExplicitLTS(size_t states = 0) :
 		states_(states),
 		transitions_(0),
-		data_(),
+		labels_(0),
+		pending_(),
+		postOffsets_(),
+		postTargets_(),
+		preOffsets_(),
+		preSources_(),
+		bwLabelOffsets_(),
 		bwLabels_()
 	{ }
 
+	/**
+	 * @brief  Adds a transition
+	 *
+	 * Transitions are only collected; the LTS may be queried after init().
+	 */
 	void addTransition(size_t q, size_t a, size_t r);
 
-	void init()
-	{
-		this->bwLabels_.resize(this->states_, Util::SmartSet(this->data_.size()));
-
-		for (size_t a = 0; a < this->data_.size(); ++a)
-		{
-			this->data_[a].first.resize(this->states_);
-			this->data_[a].second.resize(this->states_);
-
-			for (size_t r = 0; r < this->states_; ++r)
-			{
-				this->bwLabels_[r].init(a, this->data_[a].second[r].size());
-			}
-		}
-	}
+	/**
+	 * @brief  Builds the compressed representation of added transitions
+	 */
+	void init();
 
 	void clear()
 	{
-		this->data_.clear();
+		this->pending_.clear();
+		this->postOffsets_.clear();
+		this->postTargets_.clear();
+		this->preOffsets_.clear();
+		this->preSources_.clear();
+		this->bwLabelOffsets_.clear();
 		this->bwLabels_.clear();
 		this->states_ = 0;
 		this->transitions_ = 0;
+		this->labels_ = 0;
 	}
 
-	const std::vector<std::vector<size_t>>& post(size_t a) const
+	Adjacency post(size_t a) const
 	{
-		assert(a < this->data_.size());
+		assert(a < this->labels_);
+		assert(!this->postOffsets_.empty());
 
-		return this->data_[a].first;
+		return Adjacency(this->postOffsets_.data() + a*(this->states_ + 1),
+			this->postTargets_.data(), this->states_);
 	}
 
-	const std::vector<std::vector<size_t>>& pre(size_t a) const
+	Adjacency pre(size_t a) const
 	{
-		assert(a < this->data_.size());
+		assert(a < this->labels_);
+		assert(!this->preOffsets_.empty());
 
-		return this->data_[a].second;
+		return Adjacency(this->preOffsets_.data() + a*(this->states_ + 1),
+			this->preSources_.data(), this->states_);
 	}
 
-	const Util::SmartSet& bwLabels(size_t q) const
+	Range bwLabels(size_t q) const
 	{
-		assert(q < this->bwLabels_.size());
+		assert(q + 1 < this->bwLabelOffsets_.size());
 
-		return this->bwLabels_[q];
+		return Range(this->bwLabels_.data() + this->bwLabelOffsets_[q],
+			this->bwLabels_.data() + this->bwLabelOffsets_[q + 1]);
 	}
 
 	void buildDelta1(std::vector<Util::SmartSet>& delta1) const
 	{
-		delta1.resize(this->data_.size(), Util::SmartSet(this->states_));
+		delta1.resize(this->labels_, Util::SmartSet(this->states_));
 
-		for (size_t a = 0; a < this->data_.size(); ++a)
+		for (size_t a = 0; a < this->labels_; ++a)
 		{
-			for (size_t q = 0; q < this->data_[a].first.size(); ++q)
+			Adjacency post = this->post(a);
+			for (size_t q = 0; q < this->states_; ++q)
 			{
-				delta1[a].init(q, delta1[a].count(q) + this->data_[a].first[q].size());
+				if (!post[q].empty())
+				{
+					delta1[a].init(q, delta1[a].count(q) + post[q].size());
+				}
 			}
 		}
 	}
 
-	size_t labels() const { return this->data_.size(); }
+	size_t labels() const { return this->labels_; }
 
 	const size_t& states() const { return this->states_; }
 
 	friend std::ostream& operator<<(std::ostream& os, const ExplicitLTS& lts)
 	{
-		for (size_t a = 0; a < lts.data_.size(); ++a)
+		for (size_t a = 0; a < lts.labels_; ++a)
 		{
-			for (size_t q = 0; q < lts.data_[a].second.size(); ++q)
+			for (size_t q = 0; q < lts.states_; ++q)
 			{
-				for (auto& r : lts.data_[a].first[q])
+				for (auto& r : lts.post(a)[q])
 				{
 					os << q << " --" << a << "--> " << r << std::endl;
 				}
@@ -127,16 +224,72 @@ public:
 
 public:
 
+	/**
+	 * @brief  Computes the simulation
+	 *
+	 * @param[in]  partition   The initial partition of states
+	 * @param[in]  relation    The initial relation on blocks of @p partition
+	 * @param[in]  outputSize  The number of states in the result
+	 * @param[in]  numThreads  The number of threads used for the initialization
+	 *                         of counters (0 denotes the number of hardware
+	 *                         threads); the refinement of the partition-relation
+	 *                         pair is sequential, and the result does not depend
+	 *                         on it
+	 * @param[in]  cancel      A token cancelling the computation (may be
+	 *                         @p nullptr)
+	 */
 	Util::BinaryRelation computeSimulation(
 		const std::vector<std::vector<size_t>>&   partition,
 		const Util::BinaryRelation&               relation,
-		size_t                                    outputSize
+		size_t                                    outputSize,
+		size_t                                    numThreads = 1,
+		const CancellationToken*                  cancel = nullptr
 	);
 
 	Util::BinaryRelation computeSimulation(
-		size_t   outputSize);
+		size_t                     outputSize,
+		size_t                     numThreads = 1,
+		const CancellationToken*   cancel = nullptr);
 
 	Util::BinaryRelation computeSimulation();
+
+	/**
+	 * @brief  Computes the simulation in a sparse form
+	 *
+	 * The same as computeSimulation(), but the result is output as classes of
+	 * simulation-equivalent states with the order on the classes, so the size
+	 * of the result is not quadratic in the number of states.
+	 */
+	Util::SparseBinaryRelation computeSparseSimulation(
+		const std::vector<std::vector<size_t>>&   partition,
+		const Util::BinaryRelation&               relation,
+		size_t                                    outputSize,
+		size_t                                    numThreads = 1,
+		const CancellationToken*                  cancel = nullptr
+	);
+
+	Util::SparseBinaryRelation computeSparseSimulation(
+		size_t                     outputSize,
+		size_t                     numThreads = 1,
+		const CancellationToken*   cancel = nullptr);
+
+	/**
+	 * @brief  Computes the bisimulation
+	 *
+	 * The coarsest stable refinement of the initial partition is computed by
+	 * the algorithm of Paige and Tarjan, i.e., in time O(m log n) for @p m
+	 * transitions and @p n states, without computing any relation.
+	 *
+	 * @param[in]  partition  The initial partition of states (every state needs
+	 *                        to be in exactly one block)
+	 * @param[in]  cancel     A token cancelling the computation (may be
+	 *                        @p nullptr)
+	 *
+	 * @returns  The index of the class of the bisimulation of every state
+	 */
+	std::vector<size_t> computeBisimulation(
+		const std::vector<std::vector<size_t>>&   partition,
+		const CancellationToken*                  cancel = nullptr) const;
 };
 
 #endif
@@ -17,6 +17,7 @@
 #include <vata/parsing/abstr_parser.hh>
 #include <vata/serialization/abstr_serializer.hh>
 #include <vata/incl_param.hh>
+#include <vata/isect_param.hh>
 #include <vata/reduce_param.hh>
 #include <vata/sim_param.hh>
 
@@ -488,6 +489,21 @@ public:   // methods
 	void AddTransition(
 		const Transition&         trans);
 
+	/**
+	 * @brief  Adds a batch of transitions
+	 *
+	 * Adds all transitions from @p transitions at once.  The transitions are
+	 * sorted and deduplicated first and the internal tables are sized up
+	 * front, so that every parent state and every (parent, symbol) pair is
+	 * processed only once.  This is considerably faster than calling
+	 * AddTransition() for every transition.
+	 *
+	 * @param[in]  transitions  The transitions to be added (may contain
+	 *                          duplicates)
+	 */
+	void AddTransitions(
+		const std::vector<Transition>&    transitions);
+
 	bool ContainsTransition(
 		const Transition&         trans) const;
 
@@ -497,7 +513,78 @@ public:   // methods
 		const SymbolType&         symbol,
 		const StateType&          state) const;
 
-    bool AreTransitionsEmpty();
+    bool AreTransitionsEmpty() const;
+
+	/**
+	 * @brief  Switches the automaton to compact read-only storage
+	 *
+	 * This method lays out the transitions of the automaton in sorted
+	 * contiguous arrays (parent states, symbols, and identifiers of tuples)
+	 * and releases the usual storage.  Intersection, removal of useless
+	 * states, computation of downward simulation, and non-recursive downward
+	 * inclusion checking then traverse this compact storage, which has much
+	 * better cache behaviour on large automata.  Other operations (e.g. upward
+	 * inclusion checking or upward simulation) need the usual storage, which
+	 * is rebuilt from the compact one upon the first such operation and kept
+	 * from then on.  The automaton remains modifiable; the compact storage is,
+	 * however, dropped upon the first modification and needs to be created
+	 * again by calling this method.
+	 */
+	void Freeze();
+
+	/**
+	 * @brief  Checks whether the automaton uses compact read-only storage
+	 *
+	 * @returns  @p true if Freeze() was called and the automaton has not been
+	 *           modified since, @p false otherwise
+	 */
+	bool IsFrozen() const;
+
+	/**
+	 * @brief  Starts maintaining productive states incrementally
+	 *
+	 * The productive states (i.e., states with a non-empty language) are
+	 * computed once and then updated by every AddTransition() in time
+	 * proportional to the added transitions, together with the number of
+	 * productive final states, so that IsLangEmpty() and IsStateProductive()
+	 * take constant time instead of traversing the automaton.  The incremental mode
+	 * is not copied together with the automaton and it is switched off by
+	 * Clear().
+	 */
+	void EnableIncrementalReachability();
+
+	void DisableIncrementalReachability();
+
+	bool IsIncrementalReachabilityEnabled() const;
+
+	/**
+	 * @brief  Starts caching computed simulations
+	 *
+	 * Simulations computed by ComputeSimulation() and
+	 * ComputeSparseSimulation() are kept with the automaton and returned by
+	 * subsequent calls with the same relation and number of states.  Inclusion
+	 * checking with simulation which is not given the simulation in its
+	 * parameters computes it on the union of the two automata (whose states
+	 * need to be disjoint) and keeps it in the cache of the bigger automaton.
+	 * The cache is cleared whenever the transitions of the automaton are
+	 * modified and it is not copied together with the automaton.
+	 */
+	void EnableSimulationCache();
+
+	void DisableSimulationCache();
+
+	bool IsSimulationCacheEnabled() const;
+
+	/**
+	 * @brief  Checks whether the language of a state is not empty
+	 *
+	 * @param[in]  state  The state to be checked
+	 *
+	 * @returns  @p true if some tree is accepted from @p state, @p false
+	 *           otherwise
+	 */
+	bool IsStateProductive(
+		const StateType&                  state) const;
 
 	AlphabetType& GetAlphabet();
 
@@ -765,6 +852,30 @@ public:   // methods
 		AutBase::ProductTranslMap*        pTranslMap = nullptr);
 
 
+	/**
+	 * @brief  Intersection of languages of a pair of automata
+	 *
+	 * This function creates an automaton that accepts the languages defined as
+	 * the intersection of langauges of a pair of automata, using the algorithm
+	 * given by @p params.  The @p TOP_DOWN_PARALLEL algorithm explores the
+	 * product using a pool of threads; its result equals the result of the
+	 * sequential algorithm up to renaming of states.
+	 *
+	 * @param[in]   lhs             Left automaton
+	 * @param[in]   rhs             Right automaton
+	 * @param[in]   params          Parameters of the construction
+	 * @param[out]  pTranslMap      Dictionary for the result
+	 *
+	 * @returns  An automaton accepting the intersection of languages of @p lhs
+	 * and @p rhs
+	 */
+	static ExplicitTreeAut Intersection(
+		const ExplicitTreeAut&            lhs,
+		const ExplicitTreeAut&            rhs,
+		const IsectParam&                 params,
+		AutBase::ProductTranslMap*        pTranslMap = nullptr);
+
+
 	/**
 	 * @brief  Intersection of languages of a pair of automata in bottom-up way
 	 *
@@ -784,6 +895,47 @@ public:   // methods
 		AutBase::ProductTranslMap*        pTranslMap = nullptr);
 
 
+	/**
+	 * @brief  Checks whether the intersection of languages is empty
+	 *
+	 * The product of the automata is explored bottom-up on the fly and the
+	 * exploration stops as soon as a tree accepted by both automata is found,
+	 * so the product automaton is never constructed.
+	 *
+	 * @param[in]   lhs       Left automaton
+	 * @param[in]   rhs       Right automaton
+	 * @param[out]  pWitness  If not @p nullptr and the intersection is not
+	 *                        empty, an automaton accepting exactly one tree
+	 *                        from the intersection is stored here
+	 *
+	 * @returns  @p true if the intersection of languages of @p lhs and @p rhs
+	 * is empty, @p false otherwise
+	 */
+	static bool IsIntersectionEmpty(
+		const ExplicitTreeAut&            lhs,
+		const ExplicitTreeAut&            rhs,
+		ExplicitTreeAut*                  pWitness = nullptr);
+
+
+	/**
+	 * @brief  Checks whether the intersection of languages of several automata
+	 *         is empty
+	 *
+	 * The k-ary variant of the on-the-fly emptiness check of intersection.
+	 *
+	 * @param[in]   auts      The automata (at least one)
+	 * @param[out]  pWitness  If not @p nullptr and the intersection is not
+	 *                        empty, an automaton accepting exactly one tree
+	 *                        from the intersection is stored here
+	 *
+	 * @returns  @p true if the intersection of languages of @p auts is empty,
+	 * @p false otherwise
+	 */
+	static bool IsIntersectionEmpty(
+		const std::vector<const ExplicitTreeAut*>&    auts,
+		ExplicitTreeAut*                              pWitness = nullptr);
+
+
 	/**
 	 * @brief  Dispatcher for calling correct inclusion checking function
 	 *
@@ -804,6 +956,34 @@ public:   // methods
 		const VATA::InclParam&                 params);
 
 
+	/**
+	 * @brief  Checks inclusion and gives a counterexample
+	 *
+	 * The same as the other CheckInclusion(), but if the inclusion does not
+	 * hold, @p counterexample is set to an automaton accepting a single tree,
+	 * which is accepted by @p smaller but not by @p bigger.  The upward
+	 * antichain algorithm reconstructs the tree from the pairs it explored
+	 * (sequentially, regardless of the number of threads in @p params), and so
+	 * does the congruence algorithm; for the
+	 * downward algorithms, the tree is found by the upward antichain algorithm
+	 * once they answer that the inclusion does not hold.
+	 *
+	 * @param[in]   smaller         The smaller automaton
+	 * @param[in]   bigger          The bigger automaton
+	 * @param[in]   params          Parameters for the inclusion
+	 * @param[out]  counterexample  The counterexample (unchanged if the
+	 *                              inclusion holds)
+	 *
+	 * @returns  @p true if the language of @p smaller is a subset of the language
+	 *           of @p bigger, @p false otherwise
+	 */
+	static bool CheckInclusion(
+		const ExplicitTreeAut&                 smaller,
+		const ExplicitTreeAut&                 bigger,
+		const VATA::InclParam&                 params,
+		ExplicitTreeAut*                       counterexample);
+
+
 	/**
 	 * @brief  Checks inclusion using default parameters
 	 *
@@ -821,6 +1001,95 @@ public:   // methods
 		const ExplicitTreeAut&                 bigger);
 
 
+	/**
+	 * @brief  Checks inclusion of an automaton in several automata
+	 *
+	 * Checks whether the language of @p smaller is a subset of the language of
+	 * every automaton in @p biggers.  The smaller automaton is sanitized (see
+	 * AutBase::SanitizeAutsForInclusion()) and indexed only once for all the
+	 * checks, so the batch is cheaper than separate calls of CheckInclusion().
+	 * The automata need not have disjoint states, even if a simulation is
+	 * used.  If the number of threads in @p params is not 1, the individual
+	 * checks run concurrently (each of them sequentially).
+	 *
+	 * @param[in]  smaller             The smaller automaton
+	 * @param[in]  biggers             The bigger automata
+	 * @param[in]  params              Parameters of the checks (a simulation set
+	 *                                 in them is ignored)
+	 * @param[in]  stopAtFirstSuccess  If @p true, the checks stop at the first
+	 *                                 bigger automaton including @p smaller
+	 *
+	 * @returns  For every automaton in @p biggers, whether it includes the
+	 *           language of @p smaller; if @p stopAtFirstSuccess is @p true,
+	 *           only the first such automaton is marked
+	 */
+	static std::vector<bool> CheckInclusionBatch(
+		const ExplicitTreeAut&                 smaller,
+		const std::vector<ExplicitTreeAut>&    biggers,
+		const VATA::InclParam&                 params,
+		bool                                   stopAtFirstSuccess = false);
+
+
+	/**
+	 * @brief  Checks inclusion by racing several configurations
+	 *
+	 * Runs the inclusion checks with the parameters in @p configs concurrently,
+	 * each in its own thread, and returns the answer of the check that
+	 * finishes first.  The remaining checks are then cancelled.  A check is
+	 * also bounded by the cancellation token set in its configuration (if
+	 * any).  A configuration that fails with an exception (e.g., by exceeding
+	 * a budget of its token) is ignored unless all configurations fail, in
+	 * which case the first exception is rethrown.
+	 *
+	 * @param[in]   smaller  The smaller automaton
+	 * @param[in]   bigger   The bigger automaton
+	 * @param[in]   configs  Parameters of the checks (see
+	 *                       GetDefaultInclusionPortfolio())
+	 * @param[out]  winner   If not @p nullptr, the index of the configuration
+	 *                       that gave the answer
+	 *
+	 * @returns  @p true if the language of @p smaller is a subset of the language
+	 *           of @p bigger, @p false otherwise
+	 */
+	static bool CheckInclusionPortfolio(
+		const ExplicitTreeAut&                 smaller,
+		const ExplicitTreeAut&                 bigger,
+		const std::vector<VATA::InclParam>&    configs = GetDefaultInclusionPortfolio(),
+		size_t*                                winner = nullptr);
+
+
+	/**
+	 * @brief  The default configurations of CheckInclusionPortfolio()
+	 *
+	 * Upward and non-recursive downward antichains, each with and without
+	 * simulation, and recursive downward antichains with simulation and the
+	 * optimised cache.
+	 */
+	static std::vector<VATA::InclParam> GetDefaultInclusionPortfolio();
+
+
+	/**
+	 * @brief  Checks language equivalence of automata
+	 *
+	 * Unlike two calls of CheckInclusion(), the check explores pairs of sets
+	 * of states reached by the same tree in @p lhs and @p rhs only once, for
+	 * both directions.  Pairs that are unions of pairs explored before are
+	 * skipped.  Only the search order and the cancellation token of @p params
+	 * are used.
+	 *
+	 * @param[in]  lhs     The left automaton
+	 * @param[in]  rhs     The right automaton
+	 * @param[in]  params  Parameters of the check
+	 *
+	 * @returns  @p true if the languages of @p lhs and @p rhs are equal, @p
+	 *           false otherwise
+	 */
+	static bool CheckEquivalence(
+		const ExplicitTreeAut&                 lhs,
+		const ExplicitTreeAut&                 rhs,
+		const VATA::InclParam&                 params = VATA::InclParam());
+
+
 	/**
 	 * @brief  Computes the specified simulation relation on the automaton
 	 *
@@ -837,15 +1106,110 @@ public:   // methods
 		const VATA::SimParam&                  params) const;
 
 
+	/**
+	 * @brief  Computes the specified simulation relation in a sparse form
+	 *
+	 * The same as ComputeSimulation(), but the relation is stored as classes
+	 * of simulation-equivalent states with an order on the classes instead of
+	 * a matrix, which makes it usable for automata with a large number of
+	 * states.  The result can be passed to InclParam::SetSimulation().
+	 *
+	 * @param[in]  params  Parameters specifying which simulation is to be computed.
+	 *
+	 * @returns  The computed simulation relation
+	 */
+	AutBase::StateSparseDiscontBinaryRelation ComputeSparseSimulation(
+		const VATA::SimParam&                  params) const;
+
+
+	/**
+	 * @brief  Recomputes a simulation after a modification of the automaton
+	 *
+	 * Given the simulation computed before some transitions were added to or
+	 * removed from the automaton (by ComputeSimulation() with the same
+	 * parameters), this method computes the simulation on the modified
+	 * automaton.  Instead of starting from scratch, it starts from the
+	 * original simulation, extended with pairs of states that may have become
+	 * related due to the modification (i.e., pairs whose simulating state has
+	 * an added transition below it or whose simulated state has a removed
+	 * transition below it).
+	 *
+	 * Only downward simulation is recomputed incrementally; in other cases
+	 * (and for symbols used with different arities), the simulation is
+	 * computed from scratch.
+	 *
+	 * @param[in]  params              Parameters specifying the simulation
+	 * @param[in]  oldSim              The simulation before the modification
+	 * @param[in]  addedTransitions    Transitions that have been added
+	 * @param[in]  removedTransitions  Transitions that have been removed
+	 *
+	 * @returns  The simulation on the modified automaton
+	 */
+	AutBase::StateDiscontBinaryRelation RecomputeSimulation(
+		const VATA::SimParam&                         params,
+		const AutBase::StateDiscontBinaryRelation&    oldSim,
+		const std::vector<Transition>&                addedTransitions,
+		const std::vector<Transition>&                removedTransitions =
+			std::vector<Transition>()) const;
+
+
 	/**
 	 * @brief  Computes the complement of the automaton
 	 *
 	 * This method computes the complement of the automaton with respect to the
 	 * alphabet associated with the automaton.
 	 *
+	 * @param[in]  cancel  A token cancelling the computation (may be
+	 *                     @p nullptr)
+	 *
 	 * @returns  The complement of the automaton
 	 */
-	ExplicitTreeAut Complement() const;
+	ExplicitTreeAut Complement(
+		const CancellationToken*      cancel = nullptr) const;
+
+
+	/**
+	 * @brief  Determinizes the automaton
+	 *
+	 * This method computes a bottom-up deterministic automaton with the same
+	 * language using the subset construction.  Only macrostates reachable
+	 * bottom-up are created.
+	 *
+	 * @returns  A deterministic automaton with the same language
+	 */
+	ExplicitTreeAut Determinize() const;
+
+
+	/**
+	 * @brief  Determinizes the automaton with pruning of macrostates
+	 *
+	 * The same as Determinize(), but states upward-simulated by other states
+	 * of the same macrostate are removed from the macrostate, which often
+	 * yields a smaller result.
+	 *
+	 * @param[in]  upwardSim  Upward simulation on states of the automaton (see
+	 *                        ComputeSimulation())
+	 *
+	 * @returns  A deterministic automaton with the same language
+	 */
+	ExplicitTreeAut Determinize(
+		const AutBase::StateDiscontBinaryRelation&     upwardSim) const;
+
+
+	/**
+	 * @brief  Minimizes a bottom-up deterministic automaton
+	 *
+	 * This method computes the minimal bottom-up deterministic automaton with
+	 * the same language (without useless states) using Hopcroft's partition
+	 * refinement of states in O(r * m * log(n)) time (n states, m transitions,
+	 * maximum rank r), without computing any relation on states.
+	 *
+	 * @returns  The minimal deterministic automaton with the same language
+	 *
+	 * @throws  std::runtime_error  if the automaton is not deterministic (see
+	 *                              Determinize())
+	 */
+	ExplicitTreeAut Minimize() const;
 
 
 	/**
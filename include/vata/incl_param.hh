@@ -13,6 +13,7 @@
 
 // VATA headers
 #include <vata/aut_base.hh>
+#include <vata/cancellation_token.hh>
 
 namespace VATA
 {
@@ -159,11 +160,53 @@ namespace VATA
 		 */
 		const AutBase::StateDiscontBinaryRelation* simulation_;
 
+		/**
+		 * @brief  The simulation relation in the sparse form (if present)
+		 */
+		const AutBase::StateSparseDiscontBinaryRelation* sparseSimulation_;
+
+		/**
+		 * @brief  Number of threads used for the check
+		 *
+		 * 1 denotes the sequential check, 0 denotes the number of hardware
+		 * threads.  Only the upward and the non-recursive downward antichain
+		 * algorithms for explicit tree automata are parallel; the result does
+		 * not depend on the value.
+		 */
+		size_t numThreads_;
+
+		/**
+		 * @brief  The token cancelling the check (if present)
+		 *
+		 * Only the antichain algorithms for explicit tree automata (including
+		 * the computation of the simulation they use) poll the token.
+		 */
+		const CancellationToken* cancellationToken_;
+
+		/**
+		 * @brief  The maximum number of states for dense macrostates
+		 *
+		 * If the automata have together at most this number of states, the
+		 * antichain and the congruence algorithms for explicit finite
+		 * automata (without simulation) compare macrostates represented as bit
+		 * vectors.  0 disables dense macrostates; the result does not depend
+		 * on the value.
+		 */
+		size_t denseMacroStateLimit_;
+
+	public:   // constants
+
+		static const size_t DEFAULT_DENSE_MACROSTATE_LIMIT = 4096;
+
 	public:   // methods
 
 		InclParam() :
 			flags_(0),
-			simulation_(nullptr)
+			simulation_(nullptr),
+			sparseSimulation_(nullptr),
+			numThreads_(1),
+			cancellationToken_(nullptr),
+			denseMacroStateLimit_(DEFAULT_DENSE_MACROSTATE_LIMIT)
 		{ }
 
 		void SetAlgorithm(e_algorithm alg)
@@ -276,6 +319,42 @@ namespace VATA
 		{
 			assert(nullptr != sim);
 			simulation_ = sim;
+			sparseSimulation_ = nullptr;
+		}
+
+		/**
+		 * @brief  Sets the simulation in the sparse form
+		 *
+		 * @note  Only inclusion of explicit tree automata accepts the sparse form.
+		 */
+		void SetSimulation(const AutBase::StateSparseDiscontBinaryRelation* sim)
+		{
+			assert(nullptr != sim);
+			sparseSimulation_ = sim;
+			simulation_ = nullptr;
+		}
+
+		/**
+		 * @brief  Checks whether a simulation (in any form) has been set
+		 *
+		 * @note  If no simulation is set, inclusion of explicit tree automata
+		 *        computes it on the union of the automata (whose states need
+		 *        to be disjoint).
+		 */
+		bool HasSimulation() const
+		{
+			return (nullptr != simulation_) || (nullptr != sparseSimulation_);
+		}
+
+		bool HasSparseSimulation() const
+		{
+			return nullptr != sparseSimulation_;
+		}
+
+		const AutBase::StateSparseDiscontBinaryRelation& GetSparseSimulation() const
+		{
+			assert(nullptr != sparseSimulation_);
+			return *sparseSimulation_;
 		}
 
 		void SetSearchOrder(e_search_order order)
@@ -324,6 +403,36 @@ namespace VATA
 			}
 		}
 
+		void SetNumThreads(size_t numThreads)
+		{
+			numThreads_ = numThreads;
+		}
+
+		size_t GetNumThreads() const
+		{
+			return numThreads_;
+		}
+
+		void SetCancellationToken(const CancellationToken* token)
+		{
+			cancellationToken_ = token;
+		}
+
+		const CancellationToken* GetCancellationToken() const
+		{
+			return cancellationToken_;
+		}
+
+		void SetDenseMacroStateLimit(size_t limit)
+		{
+			denseMacroStateLimit_ = limit;
+		}
+
+		size_t GetDenseMacroStateLimit() const
+		{
+			return denseMacroStateLimit_;
+		}
+
 		std::string toString() const;
 	};
 }
@@ -0,0 +1,100 @@
+/*****************************************************************************
+ *  VATA Tree Automata Library
+ *
+ *  Copyright (c) 2015  Ondra Lengal <ilengal@fit.vutbr.cz>
+ *
+ *  Description:
+ *    Header file for the IsectParam structure
+ *
+ *****************************************************************************/
+
+#ifndef _ISECT_PARAM_HH_
+#define _ISECT_PARAM_HH_
+
+#include <cassert>
+#include <string>
+
+namespace VATA
+{
+	class IsectParam
+	{
+	public:   // data types
+
+		/**
+		 * @brief  The algorithm used for the construction of the product
+		 */
+		enum class e_isect_algorithm
+		{
+			TOP_DOWN,
+			BOTTOM_UP,
+			TOP_DOWN_PARALLEL
+		};
+
+	private:  // data members
+
+		/// the algorithm to be used
+		e_isect_algorithm algorithm_ = e_isect_algorithm::TOP_DOWN;
+
+		/**
+		 * @brief  Number of threads for parallel algorithms
+		 *
+		 * 0 denotes the number of hardware threads.
+		 */
+		size_t numThreads_ = 0;
+
+	public:   // methods
+
+		void SetAlgorithm(e_isect_algorithm alg)
+		{
+			algorithm_ = alg;
+		}
+
+		e_isect_algorithm GetAlgorithm() const
+		{
+			return algorithm_;
+		}
+
+		void SetNumThreads(size_t numThreads)
+		{
+			numThreads_ = numThreads;
+		}
+
+		size_t GetNumThreads() const
+		{
+			return numThreads_;
+		}
+
+		std::string toString() const
+		{
+			std::string result = "IsectParam algorithm: ";
+			switch (this->GetAlgorithm())
+			{
+				case e_isect_algorithm::TOP_DOWN:
+				{
+					result += "TOP_DOWN";
+					break;
+				}
+				case e_isect_algorithm::BOTTOM_UP:
+				{
+					result += "BOTTOM_UP";
+					break;
+				}
+				case e_isect_algorithm::TOP_DOWN_PARALLEL:
+				{
+					result += "TOP_DOWN_PARALLEL";
+					break;
+				}
+				default:
+				{
+					assert(false);     // fail gracefully
+				}
+			}
+
+			result += ", threads: " + std::to_string(numThreads_);
+
+			return result;
+		}
+	};
+}
+
+#endif /* _ISECT_PARAM_HH_ */
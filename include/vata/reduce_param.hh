@@ -14,6 +14,8 @@
 #include <cassert>
 #include <string>
 
+#include <vata/cancellation_token.hh>
+
 namespace VATA
 {
 	class ReduceParam
@@ -25,7 +27,14 @@ namespace VATA
 		 */
 		enum class e_reduce_relation
 		{
-			TA_DOWNWARD
+			/// collapse states equivalent w.r.t. downward simulation
+			TA_DOWNWARD,
+			/// collapse states equivalent w.r.t. upward simulation
+			TA_UPWARD,
+			/// collapse according to downward, then according to upward simulation
+			TA_DOWNWARD_UPWARD,
+			/// collapse states equivalent w.r.t. downward bisimulation
+			TA_BISIMULATION
 		};
 
 	private:  // data members
@@ -33,6 +42,13 @@ namespace VATA
 		/// the relation to be computed
 		e_reduce_relation relation_ = static_cast<e_reduce_relation>(-1);
 
+		/**
+		 * @brief  The token cancelling the reduction (if present)
+		 *
+		 * Only the algorithms for explicit tree automata poll the token.
+		 */
+		const CancellationToken* cancellationToken_ = nullptr;
+
 	public:   // methods
 
 		void SetRelation(e_reduce_relation rel)
@@ -45,6 +61,16 @@ namespace VATA
 			return relation_;
 		}
 
+		void SetCancellationToken(const CancellationToken* token)
+		{
+			cancellationToken_ = token;
+		}
+
+		const CancellationToken* GetCancellationToken() const
+		{
+			return cancellationToken_;
+		}
+
 		std::string toString() const
 		{
 			std::string result = "ReduceParam relation: ";
@@ -55,6 +81,21 @@ namespace VATA
 					result += "TA_DOWNWARD";
 					break;
 				}
+				case e_reduce_relation::TA_UPWARD:
+				{
+					result += "TA_UPWARD";
+					break;
+				}
+				case e_reduce_relation::TA_DOWNWARD_UPWARD:
+				{
+					result += "TA_DOWNWARD_UPWARD";
+					break;
+				}
+				case e_reduce_relation::TA_BISIMULATION:
+				{
+					result += "TA_BISIMULATION";
+					break;
+				}
 				default:
 				{
 					assert(false);     // fail gracefully
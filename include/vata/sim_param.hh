@@ -14,6 +14,8 @@
 #include <cassert>
 #include <string>
 
+#include <vata/cancellation_token.hh>
+
 namespace VATA
 {
 	class SimParam
@@ -42,6 +44,24 @@ namespace VATA
 		 */
 		size_t numStates_ = static_cast<size_t>(-1);
 
+		/**
+		 * @brief  Number of threads used for the initialization of counters
+		 *
+		 * 1 denotes the sequential computation, 0 denotes the number of hardware
+		 * threads.  Only the initial counters and remove sets of the simulation
+		 * algorithm are computed in parallel; the refinement of the
+		 * partition-relation pair, which usually dominates the computation, is
+		 * sequential.  The computed relation does not depend on the value.
+		 */
+		size_t numThreads_ = 1;
+
+		/**
+		 * @brief  The token cancelling the computation (if present)
+		 *
+		 * Only the algorithms for explicit tree automata poll the token.
+		 */
+		const CancellationToken* cancellationToken_ = nullptr;
+
 	public:   // methods
 
 		void SetRelation(e_sim_relation rel)
@@ -64,6 +84,30 @@ namespace VATA
 			return numStates_;
 		}
 
+		/**
+		 * @brief  Sets the number of threads used for the initialization of
+		 *         counters (see @p numThreads_)
+		 */
+		void SetNumThreads(size_t numThreads)
+		{
+			numThreads_ = numThreads;
+		}
+
+		size_t GetNumThreads() const
+		{
+			return numThreads_;
+		}
+
+		void SetCancellationToken(const CancellationToken* token)
+		{
+			cancellationToken_ = token;
+		}
+
+		const CancellationToken* GetCancellationToken() const
+		{
+			return cancellationToken_;
+		}
+
 		std::string toString() const
 		{
 			std::string result = "SimParam relation: ";
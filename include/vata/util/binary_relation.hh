@@ -20,6 +20,7 @@
 // Standard library headers
 #include <vector>
 #include <algorithm>
+#include <cstdint>
 #include <unordered_map>
 
 namespace VATA
@@ -36,14 +37,116 @@ namespace VATA
 /**
  * @brief  A binary relation address continuously
  *
- * A binary relation addressed from indices from 0 to @p size_ - 1
+ * A binary relation addressed from indices from 0 to @p size_ - 1. Every row
+ * is stored as a sequence of 64-bit words so that operations on whole rows
+ * (union, intersection, inclusion, iteration over the elements of a row)
+ * work with a word at a time rather than with single bits.
  */
 class VATA::Util::BinaryRelation
 {
-	std::vector<bool> data_;
+public:   // data types
+
+	using WordType     = uint64_t;
+
+private:  // constants
+
+	static const size_t WORD_BITS = 64;
+
+private:  // data members
+
+	std::vector<WordType> data_;
 	size_t rowSize_;
+	size_t rowWords_;
 	size_t size_;
 
+private:  // methods
+
+	static size_t wordsFor(size_t bits)
+	{
+		return (bits + WORD_BITS - 1) / WORD_BITS;
+	}
+
+	static WordType fillWord(bool defVal)
+	{
+		return defVal? ~static_cast<WordType>(0) : static_cast<WordType>(0);
+	}
+
+	static WordType bitMask(size_t c)
+	{
+		return static_cast<WordType>(1) << (c % WORD_BITS);
+	}
+
+	static size_t popCount(WordType word)
+	{
+		return static_cast<size_t>(__builtin_popcountll(word));
+	}
+
+	static size_t lowestBit(WordType word)
+	{
+		assert(0 != word);
+
+		return static_cast<size_t>(__builtin_ctzll(word));
+	}
+
+	/**
+	 * @brief  The number of words of a row holding the first @p size_ bits
+	 */
+	size_t activeWords() const
+	{
+		return wordsFor(size_);
+	}
+
+	/**
+	 * @brief  The mask of bits of the last active word that are below @p size_
+	 */
+	WordType lastWordMask() const
+	{
+		size_t rest = size_ % WORD_BITS;
+		return (0 == rest)? ~static_cast<WordType>(0) :
+			(static_cast<WordType>(1) << rest) - 1;
+	}
+
+	WordType* row(size_t r)
+	{
+		assert(r < rowSize_);
+
+		return data_.data() + r*rowWords_;
+	}
+
+	const WordType* row(size_t r) const
+	{
+		assert(r < rowSize_);
+
+		return data_.data() + r*rowWords_;
+	}
+
+	/**
+	 * @brief  Applies a word operation to the first @p size_ bits of a row
+	 *
+	 * Bits of the row at indices not smaller than @p size_ are kept intact.
+	 */
+	template <class Func>
+	void applyToRow(
+		WordType*              dst,
+		const WordType*        src,
+		Func                   func)
+	{
+		const size_t words = this->activeWords();
+		if (0 == words)
+		{
+			return;
+		}
+
+		for (size_t w = 0; w + 1 < words; ++w)
+		{
+			dst[w] = func(dst[w], src[w]);
+		}
+
+		const WordType mask = this->lastWordMask();
+		dst[words - 1] = (func(dst[words - 1], src[words - 1]) & mask) |
+			(dst[words - 1] & ~mask);
+	}
+
 protected:
 
 	void realloc(size_t newRowSize, bool defVal)
@@ -51,16 +154,24 @@ protected:
 		// check for sane parameters
 		assert(0 < newRowSize);
 
-		std::vector<bool> tmp(newRowSize*newRowSize, defVal);
-		std::vector<bool>::const_iterator src = data_.begin();
-		std::vector<bool>::iterator dst = tmp.begin();
-		for (size_t i = 0; i < size_; ++i) {
-			std::copy(src, src + size_, dst);
-			src += rowSize_;
-			dst += newRowSize;
+		const size_t newRowWords = wordsFor(newRowSize);
+		std::vector<WordType> tmp(newRowSize*newRowWords, fillWord(defVal));
+
+		const size_t words = this->activeWords();
+		for (size_t i = 0; i < size_; ++i)
+		{
+			const WordType* src = this->row(i);
+			WordType* dst = tmp.data() + i*newRowWords;
+			std::copy(src, src + words, dst);
+
+			// bits behind the end of the row get the default value
+			const WordType mask = this->lastWordMask();
+			dst[words - 1] = (dst[words - 1] & mask) | (fillWord(defVal) & ~mask);
 		}
+
 		std::swap(data_, tmp);
 		rowSize_ = newRowSize;
+		rowWords_ = newRowWords;
 	}
 
 	void grow(size_t newSize, bool defVal = false)
@@ -74,23 +185,12 @@ protected:
 		this->realloc(newRowSize, defVal);
 
 	}
-/*
-	void shrinkToFit() {
-
-		assert(this->rowSize_ > this->size_);
-		size_t newRowSize = this->rowSize_;
-		while (this->size_ < (newRowSize >> 1))
-			newRowSize >>= 1;
-		assert(this->size_ <= newRowSize);
-		this->realloc(newRowSize);
 
-	}
-*/
 public:
 
 	void reset(bool defVal)
 	{
-		std::fill(data_.begin(), data_.end(), defVal);
+		std::fill(data_.begin(), data_.end(), fillWord(defVal));
 	}
 
 	void resize(size_t size, bool defVal = false)
@@ -123,44 +223,56 @@ public:
 			this->grow(size_ + 1);
 		}
 
-		assert((size_ + 1)*rowSize_ <= data_.size());
+		assert((size_ + 1)*rowWords_ <= data_.size());
 
 		// fill collumns
-		auto src = data_.begin() + i;
-		auto end = src + size_*rowSize_;
-		auto dst = data_.begin() + size_;
-
-		for ( ; src != end; src += rowSize_, dst += rowSize_)
+		const size_t srcWord = i / WORD_BITS;
+		const size_t dstWord = size_ / WORD_BITS;
+		for (size_t r = 0; r < size_; ++r)
 		{
-			*dst = *src;
+			WordType* rowData = this->row(r);
+			if (rowData[srcWord] & bitMask(i))
+			{
+				rowData[dstWord] |= bitMask(size_);
+			}
+			else
+			{
+				rowData[dstWord] &= ~bitMask(size_);
+			}
 		}
 
 		// fill rows
-		src = data_.begin() + i*rowSize_;
-		dst = data_.begin() + size_*rowSize_;
+		this->applyToRow(this->row(size_), this->row(i),
+			[](WordType, WordType src){ return src; });
 
-		std::copy(src, src + size_, dst);
+		++size_;
 
 		// set the reflexive bit
-		*(dst + size_) = reflexive;
+		this->set(size_ - 1, size_ - 1, reflexive);
 
-		return size_++;
+		return size_ - 1;
 	}
 
 	bool get(size_t r, size_t c) const
 	{
 		assert(r < size_ && c < size_);
-		assert(r*rowSize_ + c < data_.size());
 
-		return data_[r*rowSize_ + c];
+		return 0 != (this->row(r)[c / WORD_BITS] & bitMask(c));
 	}
 
 	void set(size_t r, size_t c, bool v)
 	{
 		assert(r < size_ && c < size_);
-		assert(r*rowSize_ + c < data_.size());
 
-		data_[r*rowSize_ + c] = v;
+		WordType& word = this->row(r)[c / WORD_BITS];
+		if (v)
+		{
+			word |= bitMask(c);
+		}
+		else
+		{
+			word &= ~bitMask(c);
+		}
 	}
 
 	size_t size() const
@@ -168,6 +280,119 @@ public:
 		return size_;
 	}
 
+	/**
+	 * @brief  Intersects a row with another row
+	 *
+	 * Sets the row @p r to its intersection with the row @p other, i.e. after
+	 * the call, 'rRy' holds iff 'rRy' and 'otherRy' held before.
+	 */
+	void intersectWith(size_t r, size_t other)
+	{
+		assert(r < size_ && other < size_);
+
+		this->applyToRow(this->row(r), this->row(other),
+			[](WordType dst, WordType src){ return dst & src; });
+	}
+
+	/**
+	 * @brief  Unites a row with another row
+	 *
+	 * Sets the row @p r to its union with the row @p other.
+	 */
+	void unionWith(size_t r, size_t other)
+	{
+		assert(r < size_ && other < size_);
+
+		this->applyToRow(this->row(r), this->row(other),
+			[](WordType dst, WordType src){ return dst | src; });
+	}
+
+	/**
+	 * @brief  Overwrites a row with a copy of another row
+	 */
+	void copyRow(size_t dst, size_t src)
+	{
+		assert(dst < size_ && src < size_);
+
+		if (dst != src)
+		{
+			this->applyToRow(this->row(dst), this->row(src),
+				[](WordType, WordType srcWord){ return srcWord; });
+		}
+	}
+
+	/**
+	 * @brief  Checks whether a row is a subset of another row
+	 *
+	 * @returns  @p true iff 'rRy' implies 'otherRy' for every 'y'
+	 */
+	bool isSubsetRow(size_t r, size_t other) const
+	{
+		assert(r < size_ && other < size_);
+
+		const WordType* lhs = this->row(r);
+		const WordType* rhs = this->row(other);
+		const size_t words = this->activeWords();
+		for (size_t w = 0; w + 1 < words; ++w)
+		{
+			if (0 != (lhs[w] & ~rhs[w]))
+			{
+				return false;
+			}
+		}
+
+		return (0 == words) ||
+			(0 == (lhs[words - 1] & ~rhs[words - 1] & this->lastWordMask()));
+	}
+
+	/**
+	 * @brief  The number of images of an element
+	 */
+	size_t countRow(size_t r) const
+	{
+		assert(r < size_);
+
+		const WordType* rowData = this->row(r);
+		const size_t words = this->activeWords();
+		size_t cnt = 0;
+		for (size_t w = 0; w + 1 < words; ++w)
+		{
+			cnt += popCount(rowData[w]);
+		}
+
+		return (0 == words)? cnt :
+			cnt + popCount(rowData[words - 1] & this->lastWordMask());
+	}
+
+	/**
+	 * @brief  Calls a function on all images of an element
+	 *
+	 * The function @p func is called on every 'y' such that 'rRy', in the
+	 * ascending order.
+	 */
+	template <class Func>
+	void forEachInRow(size_t r, Func func) const
+	{
+		assert(r < size_);
+
+		const WordType* rowData = this->row(r);
+		const size_t words = this->activeWords();
+		for (size_t w = 0; w < words; ++w)
+		{
+			WordType word = rowData[w];
+			if (w + 1 == words)
+			{
+				word &= this->lastWordMask();
+			}
+
+			while (0 != word)
+			{
+				func(w*WORD_BITS + lowestBit(word));
+				word &= word - 1;
+			}
+		}
+	}
+
 public:
 
 	using IndexType    = std::vector<std::vector<size_t>>;
@@ -176,21 +401,18 @@ public:
 		size_t         size = 0,
 		bool           defVal = false,
 		size_t         rowSize = 16) :
-		data_(rowSize*rowSize, defVal),
+		data_(rowSize*wordsFor(rowSize), fillWord(defVal)),
 		rowSize_(rowSize),
+		rowWords_(wordsFor(rowSize)),
 		size_(0)
 	{
 		this->resize(size, defVal);
 	}
 
-/*
-	BinaryRelation(const BinaryRelation& rel)
-		: data_(rel.data_), rowSize_(rel.rowSize_), size_(rel.size_) {}
-*/
-
 	BinaryRelation(const std::vector<std::vector<bool> >& rel) :
-		data_(16*16, false),
+		data_(16*wordsFor(16), 0),
 		rowSize_(16),
+		rowWords_(wordsFor(16)),
 		size_(0)
 	{
 		this->resize(rel.size(), false);
@@ -271,10 +493,8 @@ public:
 
 		for (size_t i = 0; i < size_; ++i)
 		{
-			for (size_t j = 0; j < size_; ++j)
-			{
-				this->set(i, j, this->get(i, j) && rhs.get(i,j));
-			}
+			this->applyToRow(this->row(i), rhs.row(i),
+				[](WordType dst, WordType src){ return dst & src; });
 		}
 
 		return *this;
@@ -286,10 +506,13 @@ public:
 		dst.resize(size_);
 		for (size_t i = 0; i < size_; ++i)
 		{
-			for (size_t j = 0; j < size_; ++j)
-			{
-				dst.set(j, i, this->get(i, j));
-			}
+			WordType* dstRow = dst.row(i);
+			dst.applyToRow(dstRow, dstRow, [](WordType, WordType){ return 0; });
+		}
+
+		for (size_t i = 0; i < size_; ++i)
+		{
+			this->forEachInRow(i, [&dst, i](size_t j){ dst.set(j, i, true); });
 		}
 
 		return dst;
@@ -310,23 +533,11 @@ public:
 	{
 		dst.resize(size_);
 
-		auto rowStart = data_.begin();
-		auto src = rowStart;
-		auto end = src + size_*rowSize_;
-		auto dstIter = dst.begin();
-
-		for (; src != end; src = rowStart, ++dstIter)
+		for (size_t i = 0; i < size_; ++i)
 		{
-			auto rowEnd = src + size_;
-			rowStart = src + rowSize_;
-
-			for (size_t i = 0; src != rowEnd; ++src, ++i)
-			{
-				if (*src)
-				{
-					dstIter->push_back(i);
-				}
-			}
+			std::vector<size_t>& images = dst[i];
+			images.reserve(images.size() + this->countRow(i));
+			this->forEachInRow(i, [&images](size_t j){ images.push_back(j); });
 		}
 	}
 
@@ -346,13 +557,7 @@ public:
 
 		for (size_t i = 0; i < size_; ++i)
 		{
-			for (size_t j = 0; j < size_; ++j)
-			{
-				if (this->get(i, j))
-				{
-					dst[j].push_back(i);
-				}
-			}
+			this->forEachInRow(i, [&dst, i](size_t j){ dst[j].push_back(i); });
 		}
 	}
 
@@ -374,14 +579,11 @@ public:
 
 		for (size_t i = 0; i < size_; ++i)
 		{
-			for (size_t j = 0; j < size_; ++j)
-			{
-				if (this->get(i, j))
+			this->forEachInRow(i, [&ind, &inv, i](size_t j)
 				{
 					ind[i].push_back(j);
 					inv[j].push_back(i);
-				}
-			}
+				});
 		}
 	}
 
@@ -390,15 +592,9 @@ public:
 	 */
 	void RestrictToSymmetric()
 	{
-		for (size_t row = 0; row < this->size(); ++row)
-		{
-			for (size_t col = row + 1; col < this->size(); ++col)
-			{	// traverse the matrix (we do just the part above the diagonal)
-				bool res = this->get(row, col) && this->get(col, row);
-				this->set(row, col, res);
-				this->set(col, row, res);
-			}
-		}
+		BinaryRelation inverse;
+		this->transposed(inverse);
+		*this &= inverse;
 	}
 
 
@@ -434,15 +630,15 @@ public:
 			}
 
 			quotProj[row] = row;
-			for (size_t col = row + 1; col < this->size(); ++col)
-			{
-				if (this->get(row, col))
-				{	// if 'col' is equivalent (w.r.t. the relation) to 'row'
-					assert(UNDEF_PROJ == quotProj[col]);
+			this->forEachInRow(row, [&quotProj, row, UNDEF_PROJ](size_t col)
+				{
+					if (row < col)
+					{	// if 'col' is equivalent (w.r.t. the relation) to 'row'
+						assert(UNDEF_PROJ == quotProj[col]);
 
-					quotProj[col] = row;
-				}
-			}
+						quotProj[col] = row;
+					}
+				});
 		}
 	}
 
@@ -648,7 +844,15 @@ private:  // methods
 
 		for (size_t x = 0; x < innerIndex.size(); ++x)
 		{
+			if (dict_.EndBwd() == dict_.FindBwd(x))
+			{	// the relation may be larger than the number of mapped elements
+				continue;
+			}
+
 			std::vector<size_t>& images = innerIndex[x];
+			images.erase(std::remove_if(images.begin(), images.end(),
+				[this](size_t img) { return dict_.EndBwd() == dict_.FindBwd(img);}),
+				images.end());
 
 			// 'std::transform' is C++ for 'map' in Haskell
 			std::transform(
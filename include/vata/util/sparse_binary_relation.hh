@@ -0,0 +1,503 @@
+/*****************************************************************************
+ *  VATA Tree Automata Library
+ *
+ *  Copyright (c) 2015  Ondra Lengal <ilengal@fit.vutbr.cz>
+ *
+ *  Description:
+ *    Sparse representation of preorders.
+ *
+ *****************************************************************************/
+
+#ifndef _VATA_SPARSE_BINARY_RELATION_HH_
+#define _VATA_SPARSE_BINARY_RELATION_HH_
+
+// VATA headers
+#include <vata/vata.hh>
+#include <vata/util/binary_relation.hh>
+
+// Standard library headers
+#include <algorithm>
+#include <sstream>
+#include <unordered_map>
+#include <vector>
+
+namespace VATA
+{
+	namespace Util
+	{
+		class SparseBinaryRelation;
+		class SparseDiscontBinaryRelation;
+	}
+}
+
+
+/**
+ * @brief  A preorder stored as equivalence classes with an order on them
+ *
+ * The relation is addressed from indices from 0 to size() - 1.  Every element
+ * is assigned a class, and for every class, the sorted list of classes above
+ * it (including itself) is kept, so 'xRy' holds iff the class of 'y' is above
+ * the class of 'x'.  The size of the representation is linear in the number
+ * of elements plus the number of related pairs of classes, which makes it
+ * suitable for (typically very sparse) simulations of large automata.
+ */
+class VATA::Util::SparseBinaryRelation
+{
+public:   // data types
+
+	using IndexType    = std::vector<std::vector<size_t>>;
+
+private:  // data members
+
+	/// The class of every element
+	std::vector<size_t> classOf_;
+
+	/// The (sorted) elements of every class
+	std::vector<std::vector<size_t>> classes_;
+
+	/// The (sorted) classes above every class
+	std::vector<std::vector<size_t>> upper_;
+
+private:  // methods
+
+	void buildClasses()
+	{
+		classes_.clear();
+		classes_.resize(upper_.size());
+		for (size_t elem = 0; elem < classOf_.size(); ++elem)
+		{
+			assert(classOf_[elem] < classes_.size());
+			classes_[classOf_[elem]].push_back(elem);
+		}
+	}
+
+	/**
+	 * @brief  Collects the elements of the given classes
+	 */
+	std::vector<size_t> collectElements(
+		const std::vector<size_t>&      classList) const
+	{
+		std::vector<size_t> result;
+		for (size_t cls : classList)
+		{
+			result.insert(result.end(), classes_[cls].begin(), classes_[cls].end());
+		}
+
+		std::sort(result.begin(), result.end());
+		return result;
+	}
+
+public:   // methods
+
+	SparseBinaryRelation() :
+		classOf_(),
+		classes_(),
+		upper_()
+	{ }
+
+	/**
+	 * @brief  Constructs the relation from classes and their order
+	 *
+	 * @param[in]  classOf  The class of every element
+	 * @param[in]  upper    For every class, the classes above it
+	 */
+	SparseBinaryRelation(
+		std::vector<size_t>&&                  classOf,
+		std::vector<std::vector<size_t>>&&     upper) :
+		classOf_(std::move(classOf)),
+		classes_(),
+		upper_(std::move(upper))
+	{
+		for (size_t cls = 0; cls < upper_.size(); ++cls)
+		{
+			std::vector<size_t>& clsUpper = upper_[cls];
+			clsUpper.push_back(cls);
+			std::sort(clsUpper.begin(), clsUpper.end());
+			clsUpper.erase(std::unique(clsUpper.begin(), clsUpper.end()), clsUpper.end());
+		}
+
+		this->buildClasses();
+	}
+
+	size_t size() const
+	{
+		return classOf_.size();
+	}
+
+	size_t ClassCount() const
+	{
+		return classes_.size();
+	}
+
+	size_t GetClass(size_t elem) const
+	{
+		assert(elem < classOf_.size());
+
+		return classOf_[elem];
+	}
+
+	const std::vector<size_t>& GetClassElements(size_t cls) const
+	{
+		assert(cls < classes_.size());
+
+		return classes_[cls];
+	}
+
+	const std::vector<size_t>& GetUpperClasses(size_t cls) const
+	{
+		assert(cls < upper_.size());
+
+		return upper_[cls];
+	}
+
+	bool get(size_t r, size_t c) const
+	{
+		assert(r < this->size() && c < this->size());
+
+		const std::vector<size_t>& rowUpper = upper_[classOf_[r]];
+		return std::binary_search(rowUpper.begin(), rowUpper.end(), classOf_[c]);
+	}
+
+	/**
+	 * @brief  Creates a mapping from elements to their images
+	 *
+	 * @param[out]  dst  The result mapping every element to its images
+	 *
+	 * @see  BinaryRelation::buildIndex
+	 */
+	void buildIndex(IndexType& dst) const
+	{
+		dst.resize(this->size());
+
+		for (size_t cls = 0; cls < classes_.size(); ++cls)
+		{
+			std::vector<size_t> images = this->collectElements(upper_[cls]);
+			for (size_t elem : classes_[cls])
+			{
+				dst[elem] = images;
+			}
+		}
+	}
+
+	/**
+	 * @brief  Creates a mapping from elements to their co-images
+	 *
+	 * @param[out]  dst  The result mapping every element to its co-images
+	 *
+	 * @see  BinaryRelation::buildInvIndex
+	 */
+	void buildInvIndex(IndexType& dst) const
+	{
+		dst.resize(this->size());
+
+		std::vector<std::vector<size_t>> lower(classes_.size());
+		for (size_t cls = 0; cls < upper_.size(); ++cls)
+		{
+			for (size_t above : upper_[cls])
+			{
+				lower[above].push_back(cls);
+			}
+		}
+
+		for (size_t cls = 0; cls < classes_.size(); ++cls)
+		{
+			std::vector<size_t> coImages = this->collectElements(lower[cls]);
+			for (size_t elem : classes_[cls])
+			{
+				dst[elem] = coImages;
+			}
+		}
+	}
+
+	/**
+	 * @brief  Creates a mapping from elements to their images and co-images
+	 *
+	 * @param[out]  ind  The result mapping every element to its images
+	 * @param[out]  inv  The result mapping every element to its co-images
+	 */
+	void buildIndex(IndexType& ind, IndexType& inv) const
+	{
+		this->buildIndex(ind);
+		this->buildInvIndex(inv);
+	}
+
+	/**
+	 * @brief  Restricts the relation to its symmetric fragment
+	 *
+	 * Classes related in both directions are merged and the order on classes
+	 * becomes the identity.
+	 */
+	void RestrictToSymmetric()
+	{
+		// the representative of every class is the smallest class equivalent to it
+		std::vector<size_t> repr(upper_.size());
+		for (size_t cls = 0; cls < upper_.size(); ++cls)
+		{
+			repr[cls] = cls;
+			for (size_t above : upper_[cls])
+			{
+				if (above >= cls)
+				{
+					break;
+				}
+
+				if (std::binary_search(upper_[above].begin(), upper_[above].end(), cls))
+				{
+					repr[cls] = repr[above];
+					break;
+				}
+			}
+		}
+
+		std::vector<size_t> newIndex(upper_.size(), static_cast<size_t>(-1));
+		size_t classCnt = 0;
+		for (size_t cls = 0; cls < upper_.size(); ++cls)
+		{
+			if (repr[cls] == cls)
+			{
+				newIndex[cls] = classCnt++;
+			}
+		}
+
+		for (size_t& cls : classOf_)
+		{
+			cls = newIndex[repr[cls]];
+		}
+
+		upper_.clear();
+		upper_.resize(classCnt);
+		for (size_t cls = 0; cls < classCnt; ++cls)
+		{
+			upper_[cls].push_back(cls);
+		}
+
+		this->buildClasses();
+	}
+
+	/**
+	 * @brief  Gets the projection of elements to their representatives
+	 *
+	 * Every element is mapped to the smallest element of its class.
+	 *
+	 * @param[out]  quotProj  The vector mapping elements to their
+	 *                        representatives in the quotient set
+	 *
+	 * @see  BinaryRelation::GetQuotientProjection
+	 */
+	void GetQuotientProjection(
+		std::vector<size_t>&             quotProj) const
+	{
+		quotProj.resize(this->size());
+		for (size_t elem = 0; elem < this->size(); ++elem)
+		{
+			quotProj[elem] = classes_[classOf_[elem]].front();
+		}
+	}
+
+	friend std::ostream& operator<<(
+		std::ostream&                   os,
+		const SparseBinaryRelation&     v)
+	{
+		for (size_t cls = 0; cls < v.classes_.size(); ++cls)
+		{
+			os << cls << ": " << Convert::ToString(v.classes_[cls]) << " <= " <<
+				Convert::ToString(v.upper_[cls]) << std::endl;
+		}
+
+		return os;
+	}
+};
+
+
+/**
+ * @brief  A sparse preorder with discontinuous indexing
+ *
+ * The sparse counterpart of DiscontBinaryRelation: elements are translated to
+ * the range 0..size-1 of the underlying SparseBinaryRelation.
+ */
+class VATA::Util::SparseDiscontBinaryRelation
+{
+public:   // data types
+
+	using IndexType    = DiscontBinaryRelation::IndexType;
+	using DictType     = DiscontBinaryRelation::DictType;
+
+private:  // data members
+
+	/// The underlying relation, indexed from 0
+	SparseBinaryRelation rel_;
+
+	/// The mapping of inputs to the range 0..size-1
+	DictType dict_;
+
+private:  // methods
+
+	/**
+	 * @brief  Translates index of internal relation to the discontinuous
+	 *
+	 * @param[in,out]  innerIndex  The index for the internal continuous relation
+	 *
+	 * @returns  The index in the discontinuous relation
+	 *
+	 * @note  Destroys @p innerIndex
+	 */
+	IndexType translateIndexToDiscont(
+		SparseBinaryRelation::IndexType&      innerIndex) const
+	{
+		IndexType result;
+
+		for (size_t x = 0; x < innerIndex.size(); ++x)
+		{
+			std::vector<size_t>& images = innerIndex[x];
+			for (size_t& img : images)
+			{
+				img = dict_.TranslateBwd(img);
+			}
+
+			bool inserted = result.insert(
+				std::make_pair(dict_.TranslateBwd(x), std::move(images))).second;
+			if (!inserted)  assert(false);
+		}
+
+		return result;
+	}
+
+public:   // methods
+
+	SparseDiscontBinaryRelation() :
+		rel_(),
+		dict_()
+	{ }
+
+	/**
+	 * @brief  Constructor from a relation and a dictionary
+	 *
+	 * @note This allows a conversion from TDict to DictType
+	 */
+	template <
+		class TDict>
+	SparseDiscontBinaryRelation(
+		SparseBinaryRelation&&     rel,
+		const TDict&               dict) :
+		rel_(std::move(rel)),
+		dict_(dict)
+	{ }
+
+	const SparseBinaryRelation& GetRelation() const
+	{
+		return rel_;
+	}
+
+	bool get(size_t row, size_t column) const
+	{
+		return rel_.get(dict_.TranslateFwd(row), dict_.TranslateFwd(column));
+	}
+
+	size_t size() const
+	{
+		return rel_.size();
+	}
+
+	/**
+	 * @brief  Creates a mapping from elements to their images
+	 *
+	 * @param[out]  dst  The result mapping every element to its images
+	 */
+	void buildIndex(IndexType& dst) const
+	{
+		assert(dst.empty());
+
+		SparseBinaryRelation::IndexType innerIndex;
+
+		rel_.buildIndex(innerIndex);
+		dst = this->translateIndexToDiscont(innerIndex);
+	}
+
+	// relation index
+	void buildIndex(
+		IndexType&           ind,
+		IndexType&           inv) const
+	{
+		assert(ind.empty());
+		assert(inv.empty());
+
+		SparseBinaryRelation::IndexType innerInd;
+		SparseBinaryRelation::IndexType innerInv;
+
+		rel_.buildIndex(innerInd, innerInv);
+		ind = this->translateIndexToDiscont(innerInd);
+		inv = this->translateIndexToDiscont(innerInv);
+	}
+
+	/**
+	 * @brief  Restricts the relation to its symmetric fragment
+	 */
+	void RestrictToSymmetric()
+	{
+		rel_.RestrictToSymmetric();
+	}
+
+	/**
+	 * @brief  Gets the projection of elements to their representatives
+	 *
+	 * @param[out]  quotProj  The projection of elements to their representatives
+	 *                        in the quotient set
+	 *
+	 * @see  DiscontBinaryRelation::GetQuotientProjection
+	 */
+	template <
+		class MapType>
+	void GetQuotientProjection(
+		MapType&       quotProj) const
+	{
+		assert(quotProj.empty());
+
+		std::vector<size_t> innerProj;
+		rel_.GetQuotientProjection(innerProj);
+
+		for (size_t i = 0; i < innerProj.size(); ++i)
+		{	// go over all elements in the vector
+			bool inserted = quotProj.insert(
+				std::make_pair(dict_.TranslateBwd(i), dict_.TranslateBwd(innerProj[i]))).second;
+			if (!inserted)  assert(false);
+		}
+	}
+
+	std::string ToString() const
+	{
+		std::ostringstream str;
+
+		str << "{";
+		bool placeComma = false;
+		for (const auto& firstStateToMappedPair : dict_)
+		{	// iterate over all pairs
+			for (const auto& secondStateToMappedPair : dict_)
+			{
+				if (rel_.get(firstStateToMappedPair.second, secondStateToMappedPair.second))
+				{	// if the pair is in the relation print
+					str << (placeComma? ", " : "");
+					str << "(" << firstStateToMappedPair.first << ", " <<
+						secondStateToMappedPair.first << ")";
+					placeComma = true;
+				}
+			}
+		}
+		str << "}";
+
+		return str.str();
+	}
+
+	/**
+	 * @brief  Output stream operator
+	 */
+	friend std::ostream& operator<<(
+		std::ostream&                           os,
+		const SparseDiscontBinaryRelation&      rel)
+	{
+		os << rel.ToString();
+
+		return os;
+	}
+};
+
+#endif
@@ -0,0 +1,87 @@
+/*****************************************************************************
+ *  VATA Tree Automata Library
+ *
+ *  Copyright (c) 2015  Ondra Lengal <ilengal@fit.vutbr.cz>
+ *
+ *  Description:
+ *    Implementation of the cancellation token of long-running operations.
+ *
+ *****************************************************************************/
+
+// VATA headers
+#include <vata/cancellation_token.hh>
+
+// Standard library headers
+#include <fstream>
+
+// POSIX headers
+#include <unistd.h>
+
+using VATA::CancellationToken;
+using VATA::OperationCancelledException;
+
+
+const char* OperationCancelledException::reasonToString(e_reason reason)
+{
+	switch (reason)
+	{
+		case e_reason::cancelled: return "Operation cancelled";
+		case e_reason::deadline:  return "Operation cancelled: deadline exceeded";
+		case e_reason::steps:     return "Operation cancelled: step budget exceeded";
+		case e_reason::memory:    return "Operation cancelled: memory budget exceeded";
+		default:                  return "Operation cancelled";
+	}
+}
+
+
+CancellationToken::e_reason CancellationToken::GetReason() const
+{
+	if ((NOT_CANCELLED == reason_) && (nullptr != parent_))
+	{
+		return parent_->GetReason();
+	}
+
+	return static_cast<e_reason>(static_cast<int>(reason_));
+}
+
+
+void CancellationToken::checkBudgets(size_t steps) const
+{
+	if (steps > stepBudget_)
+	{
+		this->cancel(e_reason::steps);
+	}
+
+	if (hasDeadline_ && (Clock::now() >= deadline_))
+	{
+		this->cancel(e_reason::deadline);
+	}
+
+	if ((0 != memoryBudget_) && ((1 == steps) || (0 == steps % MEMORY_PERIOD)) &&
+		(CancellationToken::GetResidentMemory() > memoryBudget_))
+	{
+		this->cancel(e_reason::memory);
+	}
+
+	if (NOT_CANCELLED != reason_)
+	{
+		throw OperationCancelledException(static_cast<e_reason>(static_cast<int>(reason_)));
+	}
+}
+
+
+size_t CancellationToken::GetResidentMemory()
+{
+	// the second field of statm is the number of resident pages
+	std::ifstream statm("/proc/self/statm");
+
+	size_t size = 0, resident = 0;
+	if (!(statm >> size >> resident))
+	{
+		return 0;
+	}
+
+	long pageSize = sysconf(_SC_PAGESIZE);
+
+	return (pageSize > 0)? resident * static_cast<size_t>(pageSize) : 0;
+}
@@ -91,9 +91,8 @@ public: // public methods
 
 	inline bool checkSmallerInBigger(const StateType& /*smaller*/, const StateSet& /*biggerSet*/)
 	{
-		// something should be implemented here?
-		assert(false);
-
+		// the states of the sanitized automata are disjoint, so no state of the
+		// smaller automaton is identical to a state of the bigger one
 		return false;
 	}
 };
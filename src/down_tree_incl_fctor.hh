@@ -14,6 +14,7 @@
 
 // VATA headers
 #include <vata/vata.hh>
+#include <vata/cancellation_token.hh>
 
 #include "antichain2c_v2.hh"
 #include "util/cache.hh"
@@ -260,10 +261,19 @@ private:  // data members
 	const SetComparerSmaller& smallerComparer_;
 	const SetComparerBigger& biggerComparer_;
 
+	const CancellationToken* cancel_;
+
 private:  // methods
 
+	DownwardInclusionFunctor& operator=(const DownwardInclusionFunctor&);
+
 	bool expand(const StateType& smallerState, const BiggerType& biggerStateSet)
 	{
+		if (nullptr != cancel_)
+		{
+			cancel_->Poll();
+		}
+
 		auto key = std::make_pair(smallerState, biggerStateSet);
 
 		if (isInWorkset(key))
@@ -408,7 +418,8 @@ public:   // methods
 		preorderSmaller_(preorderSmaller),
 		preorderBigger_(preorderBigger),
 		smallerComparer_(smallerComparer),
-		biggerComparer_(biggerComparer)
+		biggerComparer_(biggerComparer),
+		cancel_(nullptr)
 	{ }
 
 	DownwardInclusionFunctor(
@@ -425,7 +436,8 @@ public:   // methods
 		preorderSmaller_(downFctor.preorderSmaller_),
 		preorderBigger_(downFctor.preorderBigger_),
 		smallerComparer_(downFctor.smallerComparer_),
-		biggerComparer_(downFctor.biggerComparer_)
+		biggerComparer_(downFctor.biggerComparer_),
+		cancel_(downFctor.cancel_)
 	{ }
 
 	inline bool IsImpliedByPreorder(const WorkSetElement& elem) const
@@ -566,6 +578,14 @@ public:   // methods
 		}
 	}
 
+	/**
+	 * @brief  Sets the token polled in every expansion (may be @p nullptr)
+	 */
+	inline void SetCancellationToken(const CancellationToken* cancel)
+	{
+		cancel_ = cancel;
+	}
+
 	inline bool IsProcessingStopped() const
 	{
 		return processingStopped_;
@@ -14,6 +14,7 @@
 
 // VATA headers
 #include <vata/vata.hh>
+#include <vata/cancellation_token.hh>
 
 #include "antichain2c_v2.hh"
 #include "util/cache.hh"
@@ -260,14 +261,24 @@ private:  // data members
 	const SetComparerSmaller& smallerComparer_;
 	const SetComparerBigger& biggerComparer_;
 
+	const CancellationToken* cancel_;
+
 	InclAntichainType& ant_;
 	ConsequentType& cons_;
 
 private:  // methods
 
+	OptDownwardInclusionFunctor(const OptDownwardInclusionFunctor&);
+	OptDownwardInclusionFunctor& operator=(const OptDownwardInclusionFunctor&);
+
 	std::tuple<bool, InclAntichainType, ConsequentType> expand(
 		const StateType& smallerState, const BiggerType& biggerStateSet)
 	{
+		if (nullptr != cancel_)
+		{
+			cancel_->Poll();
+		}
+
 		auto key = std::make_pair(smallerState, biggerStateSet);
 
 		bool res;
@@ -455,6 +466,7 @@ public:   // methods
 		preorderBigger_(preorderBigger),
 		smallerComparer_(smallerComparer),
 		biggerComparer_(biggerComparer),
+		cancel_(nullptr),
 		ant_(ant),
 		cons_(cons)
 	{ }
@@ -476,6 +488,7 @@ public:   // methods
 		preorderBigger_(downFctor.preorderBigger_),
 		smallerComparer_(downFctor.smallerComparer_),
 		biggerComparer_(downFctor.biggerComparer_),
+		cancel_(downFctor.cancel_),
 		ant_(ant),
 		cons_(cons)
 	{ }
@@ -658,6 +671,14 @@ public:   // methods
 		}
 	}
 
+	/**
+	 * @brief  Sets the token polled in every expansion (may be @p nullptr)
+	 */
+	inline void SetCancellationToken(const CancellationToken* cancel)
+	{
+		cancel_ = cancel;
+	}
+
 	inline bool IsProcessingStopped() const
 	{
 		return processingStopped_;
@@ -104,7 +104,8 @@ public:
 			const ExplicitFA& bigger,
 			IndexType& index,
 			IndexType& inv,
-			Rel preorder) :
+			Rel preorder,
+			bool denseMacroStates = false) :
 		relation_(relation),
 		next_(next),
 		singleAntichain_(singleAntichain),
@@ -113,7 +114,7 @@ public:
 		index_(index),
 		inv_(inv),
 		preorder_(preorder),
-		cache(),
+		cache(denseMacroStates),
 		visitedPairs()
 	{}
 
@@ -20,6 +20,7 @@
 #include "explicit_finite_abstract_fctor.hh"
 #include "map_to_list.hh"
 #include "macrostate_cache.hh"
+#include "util/dense_state_set.hh"
 
 namespace VATA {
 	template <class Rel, class ProductSet, class NormalFormRel> class ExplicitFACongrFunctorCacheOpt;
@@ -84,6 +85,8 @@ GCC_DIAG_ON(effc++)
 
 	typedef typename AbstractFunctor::IndexType IndexType;
 
+	typedef VATA::Util::DenseStateSet DenseStateSet;
+
 private: // Private data members
 	ProductStateSetType& relation_;
 	ProductStateSetType&	next_;
@@ -101,14 +104,23 @@ private: // Private data members
 	MacroStatePtrPair visitedPairs_;
 	MacroStatePtrPair usedRules_;
 
+	// Congruence closure of the processed bigger macrostate if dense
+	// macrostates are used
+	DenseStateSet congrBiggerDense_;
+
 public:
+	/*
+	 * Dense macrostates (denseMacroStates) are compared as bit vectors,
+	 * which is possible only if the normal form does not use a simulation
+	 */
 	ExplicitFACongrFunctorCacheOpt(ProductStateSetType& relation, ProductStateSetType& next,
 			Antichain1Type& singleAntichain,
 			const ExplicitFA& smaller,
 			const ExplicitFA& bigger,
 			IndexType& index,
 			IndexType& inv,
-			Rel preorder) :
+			Rel preorder,
+			bool denseMacroStates = false) :
 		relation_(relation),
 		next_(next),
 		singleAntichain_(singleAntichain),
@@ -117,9 +129,10 @@ public:
 		index_(index),
 		inv_(inv),
 		normalFormRel_(preorder),
-		cache_(),
+		cache_(denseMacroStates),
 		visitedPairs_(),
-		usedRules_()
+		usedRules_(),
+		congrBiggerDense_()
 	{}
 
 public: // public functions
@@ -194,19 +207,28 @@ public: // public functions
 
 		// Comapring given set with the sets
 		// which has been computed in steps of computation of congr closure
-		auto isCongrClosureSet = [&s,&isSubSet](StateSet& bigger) ->
+		auto isCongrClosureSet = [this,&s,&isSubSet](StateSet& bigger) ->
 			bool {
+				if (cache_.UsesDense()) {
+					return !cache_.GetDense(s).IsSubsetOf(congrBiggerDense_);
+				}
 				return !isSubSet(s,bigger);
 		};
 
-		// Compute congruence closure of bigger nfa
-		StateSet congrBigger(bigger);
-
-		normalFormRel_.applyRule(congrBigger);
+		// Compute congruence closure of bigger nfa; the dense closure is
+		// computed instead of it if dense macrostates are used
+		StateSet congrBigger;
+		if (cache_.UsesDense()) {
+			congrBiggerDense_ = cache_.GetDense(b);
+		}
+		else {
+			congrBigger = bigger;
+			normalFormRel_.applyRule(congrBigger);
+		}
 
 		// Checks whether smaller macrostate is subset of congr. clusure of bigger
 		if (GetCongrClosure(b,congrBigger,isCongrClosureSet) ||
-			isSubSet(s,congrBigger)) {
+			!isCongrClosureSet(congrBigger)) {
 			smaller.clear();
 			bigger.clear();
 			return;
@@ -229,6 +251,9 @@ private:
 
 	// Check if the rule is applyable
 	bool MatchPair(const StateSet& closure, const StateSet& rule) {
+		if (cache_.UsesDense()) {
+			return cache_.GetDense(rule).IsSubsetOf(congrBiggerDense_);
+		}
 		if (rule.size() > closure.size()) {
 				return false;
 		}
@@ -241,6 +266,10 @@ private:
 	}
 
 	void AddSubSet(StateSet& mainset, StateSet& subset) {
+		if (cache_.UsesDense()) {
+			congrBiggerDense_.InsertAll(cache_.GetDense(subset));
+			return;
+		}
 		StateSet temp = StateSet(subset);
 		normalFormRel_.applyRule(temp);
 		mainset.insert(temp.begin(),temp.end());
@@ -31,7 +31,8 @@ namespace VATA
 	bool CheckFiniteAutInclusion(
 		const ExplicitFiniteAutCore&   smaller,
 		const ExplicitFiniteAutCore&   bigger,
-		const Rel&                     preorder);
+		const Rel&                     preorder,
+		bool                           denseMacroStates = false);
 
 	bool CheckEquivalence(
 		const ExplicitFiniteAutCore&   smaller,
@@ -63,10 +64,16 @@ bool VATA::ExplicitFiniteAutCore::CheckInclusion(
 
 	// if a simulation is used, a union has been already done before the simulation
 	if (params.GetAlgorithm() == InclParam::e_algorithm::congruences && !params.GetUseSimulation())
-	{
-		newSmaller = UnionDisjointStates(smaller, bigger);
+	{	// the union of the sanitized automata, whose states are numbered as
+		// the states of the bigger automaton
+		newSmaller = UnionDisjointStates(newSmaller, newBigger);
 	}
 
+	// macrostates of small automata are compared as bit vectors (this is
+	// done only for the identity, where the comparison is set inclusion)
+	const bool dense = (static_cast<typename AutBase::StateType>(-1) != states) &&
+		(states <= params.GetDenseMacroStateLimit());
+
 	switch (params.GetOptions())
 	{
 		case InclParam::ANTICHAINS_NOSIM:
@@ -78,7 +85,7 @@ bool VATA::ExplicitFiniteAutCore::CheckInclusion(
 			typedef VATA::ExplicitFAInclusionFunctorCache<Rel,Comparator> FunctorType;
 
 			return VATA::CheckFiniteAutInclusion<Rel,FunctorType>(newSmaller,
-					newBigger, VATA::Util::Identity(states));
+					newBigger, VATA::Util::Identity(states), dense);
 		}
 		case InclParam::ANTICHAINS_SIM:
 		{
@@ -102,7 +109,7 @@ bool VATA::ExplicitFiniteAutCore::CheckInclusion(
 			typedef VATA::NormalFormRelPreorder<Rel> NormalFormRel;
 			typedef VATA::ExplicitFACongrFunctorCacheOpt<Rel,ProductSet,NormalFormRel> FunctorType;
 
-			return VATA::CheckFiniteAutInclusion<Rel,FunctorType>(newSmaller, newBigger, VATA::Util::Identity(states));
+			return VATA::CheckFiniteAutInclusion<Rel,FunctorType>(newSmaller, newBigger, VATA::Util::Identity(states), dense);
 		}
 		case InclParam::CONGR_DEPTH_NOSIM:
 		{
@@ -115,7 +122,7 @@ bool VATA::ExplicitFiniteAutCore::CheckInclusion(
 			typedef VATA::NormalFormRelPreorder<Rel> NormalFormRel;
 			typedef VATA::ExplicitFACongrFunctorCacheOpt<Rel,ProductSet,NormalFormRel> FunctorType;
 
-			return VATA::CheckFiniteAutInclusion<Rel,FunctorType>(newSmaller, newBigger, VATA::Util::Identity(states));
+			return VATA::CheckFiniteAutInclusion<Rel,FunctorType>(newSmaller, newBigger, VATA::Util::Identity(states), dense);
 		}
 		case InclParam::CONGR_DEPTH_SIM:
 		{
@@ -139,7 +146,7 @@ bool VATA::ExplicitFiniteAutCore::CheckInclusion(
 			typedef VATA::ProductStateSetDepth<StateSet,ProductState> ProductSet;
 			typedef VATA::ExplicitFACongrEquivFunctor<Rel,ProductSet> FunctorType;
 
-			return VATA::CheckFiniteAutInclusion<Rel,FunctorType>(newSmaller, newBigger, VATA::Util::Identity(states));
+			return VATA::CheckFiniteAutInclusion<Rel,FunctorType>(newSmaller, newBigger, VATA::Util::Identity(states), dense);
 		}
 		case InclParam::CONGR_BREADTH_EQUIV_NOSIM:
 		{
@@ -151,7 +158,7 @@ bool VATA::ExplicitFiniteAutCore::CheckInclusion(
 			typedef VATA::ProductStateSetBreadth<StateSet,ProductState> ProductSet;
 			typedef VATA::ExplicitFACongrEquivFunctor<Rel,ProductSet> FunctorType;
 
-			return VATA::CheckFiniteAutInclusion<Rel,FunctorType>(newSmaller, newBigger, VATA::Util::Identity(states));
+			return VATA::CheckFiniteAutInclusion<Rel,FunctorType>(newSmaller, newBigger, VATA::Util::Identity(states), dense);
 		}
 		default:
 		{
@@ -168,7 +175,8 @@ template<class Rel, class Functor>
 bool VATA::CheckFiniteAutInclusion(
 	const VATA::ExplicitFiniteAutCore&    smaller,
 	const VATA::ExplicitFiniteAutCore&    bigger,
-	const Rel&                            preorder)
+	const Rel&                            preorder,
+	bool                                  denseMacroStates)
 {
 	typedef Functor InclFunc;
 
@@ -191,7 +199,7 @@ bool VATA::CheckFiniteAutInclusion(
 	preorder.buildIndex(index,inv);
 
 	InclFunc inclFunc(antichain,next,singleAntichain,
-			smaller,bigger,index,inv,preorder);
+			smaller,bigger,index,inv,preorder,denseMacroStates);
 
 	// Initialization of antichain sets from initial states of automata
 	inclFunc.Init();
@@ -93,13 +93,18 @@ private: // data memebers
 	SubSetMap subsetNotMap_;
 
 public: // constructor
+	/*
+	 * Dense macrostates (denseMacroStates) are compared as bit vectors,
+	 * which is possible only if the preorder is the identity
+	 */
 	ExplicitFAInclusionFunctorCache(AntichainType& antichain, AntichainNext& next,
 			Antichain1Type& singleAntichain,
 			const ExplicitFA& smaller,
 			const ExplicitFA& bigger,
 			IndexType& index,
 			IndexType& inv,
-			Rel preorder) :
+			Rel preorder,
+			bool denseMacroStates = false) :
 		antichain_(antichain),
 		next_(next),
 		singleAntichain_(singleAntichain),
@@ -109,7 +114,7 @@ public: // constructor
 		inv_(inv),
 		preorder_(preorder),
 		comparator_(preorder),
-		cache_(),
+		cache_(denseMacroStates),
 		subsetMap_(),
 		subsetNotMap_()
 	{}
@@ -185,53 +190,13 @@ private: // private functions
 	 */
 	void AddNewPairToAntichain(StateType state, StateSet &set) {
 		//lss is subset of rss -> return TRUE
-		auto lte = [this](const StateSet* lss,
-				const StateSet* rss) -> bool {
-			bool res;
-
-			// Check whether product state has not been already processed
-			if (subsetMap_.contains(lss,rss)) {
-				res = true;
-			}
-			else if (subsetNotMap_.contains(lss,rss)) {
-				res = false;
-			}
-			else { // product state has not been already processed
-				res = this->comparator_.lte(*lss,*rss);
-				if (res) {
-					subsetMap_.add(lss,rss);
-					subsetNotMap_.add(rss,lss);
-				}
-				else {
-					subsetMap_.add(rss,lss);
-					subsetNotMap_.add(lss,rss);
-				}
-			}
-			return res;
+		auto lte = [this](const StateSet* lss, const StateSet* rss) -> bool {
+			return this->LteMacroStatesCached(lss,rss);
 		};
 
 		// lss is greater then rss -> return TRUE
 		auto gte = [this](const StateSet* lss, const StateSet* rss) -> bool {
-			bool res;
-
-			if (subsetMap_.contains(lss,rss)) {
-				res = false;
-			}
-			else if (subsetNotMap_.contains(lss,rss)) {
-				res = true;
-			}
-			else {
-				res = this->comparator_.gte(*lss,*rss);
-				if (res) {
-					subsetMap_.add(rss,lss);
-					subsetNotMap_.add(lss,rss);
-				}
-				else {
-					subsetMap_.add(lss,rss); // rss is subset of lss
-					subsetNotMap_.add(rss,lss);
-				}
-			}
-			return res;
+			return this->LteMacroStatesCached(rss,lss);
 		};
 
 		// Check whether the antichain does not already
@@ -264,53 +229,13 @@ private: // private functions
 	 */
 	void AddToNext(StateType state, StateSet& set) {
 		//lss is subset of rss -> return TRUE
-		auto lte = [this](const StateSet* lss,
-				const StateSet* rss) -> bool {
-			bool res;
-
-			// Check whether product state has not been already processed
-			if (subsetMap_.contains(lss,rss)) {
-				res = true;
-			}
-			else if (subsetNotMap_.contains(lss,rss)) {
-				res = false;
-			}
-			else {
-				res = this->comparator_.lte(*lss,*rss);
-				if (res) {
-					subsetMap_.add(lss,rss);
-					subsetNotMap_.add(rss,lss);
-				}
-				else {
-					subsetMap_.add(rss,lss);
-					subsetNotMap_.add(lss,rss);
-				}
-			}
-			return res;
+		auto lte = [this](const StateSet* lss, const StateSet* rss) -> bool {
+			return this->LteMacroStatesCached(lss,rss);
 		};
 
 		// lss is greater then rss -> return TRUE
 		auto gte = [this](const StateSet* lss, const StateSet* rss) -> bool {
-			bool res;
-
-			if (subsetMap_.contains(lss,rss)) {
-				res = false;
-			}
-			else if (subsetNotMap_.contains(lss,rss)) {
-				res = true;
-			}
-			else {
-				res = this->comparator_.gte(*lss,*rss);
-				if (res) {
-					subsetMap_.add(rss,lss);
-					subsetNotMap_.add(lss,rss);
-				}
-				else {
-					subsetMap_.add(lss,rss); // rss is subset of lss
-					subsetNotMap_.add(rss,lss);
-				}
-			}
-			return res;
+			return this->LteMacroStatesCached(rss,lss);
 		};
 
 		std::vector<StateType> tempStateSet;// = {state};
@@ -325,6 +250,35 @@ private: // private functions
 
 
 private: // Private inline functions
+	/*
+	 * Check whether cached macrostate lss is smaller than rss, the results
+	 * of comparisons are cached unless dense macrostates are used
+	 * (comparing these is cheaper than looking up the result)
+	 */
+	inline bool LteMacroStatesCached(const StateSet* lss, const StateSet* rss) {
+		if (cache_.UsesDense()) {
+			return cache_.GetDense(*lss).IsSubsetOf(cache_.GetDense(*rss));
+		}
+
+		// Check whether the pair has not been already compared
+		if (subsetMap_.contains(lss,rss)) {
+			return true;
+		}
+		if (subsetNotMap_.contains(lss,rss)) {
+			return false;
+		}
+
+		// only the result of the comparison is stored, nothing follows for
+		// the opposite comparison (the macrostates may be equal or
+		// incomparable)
+		if (comparator_.lte(*lss,*rss)) {
+			subsetMap_.add(lss,rss);
+			return true;
+		}
+		subsetNotMap_.add(lss,rss);
+		return false;
+	}
+
 	/*
 	 * Copy one set to another
 	 */
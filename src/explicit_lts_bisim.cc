@@ -0,0 +1,249 @@
+/*****************************************************************************
+ *  VATA Tree Automata Library
+ *
+ *  Copyright (c) 2015  Ondra Lengal <ilengal@fit.vutbr.cz>
+ *
+ *  Description:
+ *    Source for explicit LTS bisimulation algorithm.
+ *
+ *****************************************************************************/
+
+// Standard library headers
+#include <cassert>
+#include <vector>
+
+// VATA headers
+#include <vata/explicit_lts.hh>
+
+#include "util/refinable_partition.hh"
+
+using VATA::Util::RefinablePartition;
+
+
+std::vector<size_t> VATA::ExplicitLTS::computeBisimulation(
+	const std::vector<std::vector<size_t>>&   partition,
+	const CancellationToken*                  cancel) const
+{
+	const size_t states = this->states_;
+
+	// transitions with counters of transitions leading from their source under
+	// their label to the compound block of their target
+	std::vector<size_t> edgeSource;
+	std::vector<size_t> edgeLabel;
+	std::vector<size_t> edgeCounter;
+	std::vector<size_t> counters;
+
+	std::vector<size_t> inOffsets(states + 1, 0);
+
+	for (size_t a = 0; a < this->labels_; ++a)
+	{
+		Adjacency post = this->post(a);
+		for (size_t q = 0; q < states; ++q)
+		{
+			if (post[q].empty())
+			{
+				continue;
+			}
+
+			counters.push_back(post[q].size());
+			for (size_t r : post[q])
+			{
+				edgeSource.push_back(q);
+				edgeLabel.push_back(a);
+				edgeCounter.push_back(counters.size() - 1);
+				++inOffsets[r + 1];
+			}
+		}
+	}
+
+	for (size_t q = 0; q < states; ++q)
+	{
+		inOffsets[q + 1] += inOffsets[q];
+	}
+
+	std::vector<size_t> inEdges(edgeSource.size());
+	{
+		std::vector<size_t> inPos(inOffsets.begin(), inOffsets.end() - 1);
+		size_t edge = 0;
+		for (size_t a = 0; a < this->labels_; ++a)
+		{
+			Adjacency post = this->post(a);
+			for (size_t q = 0; q < states; ++q)
+			{
+				for (size_t r : post[q])
+				{
+					inEdges[inPos[r]++] = edge++;
+				}
+			}
+		}
+	}
+
+	RefinablePartition blocks(partition, states);
+
+	// blocks are grouped into compound blocks; the partition is kept stable
+	// with respect to compound blocks
+	std::vector<std::vector<size_t>> compounds(1);
+	std::vector<size_t> compoundOf;
+	std::vector<size_t> posInCompound;
+
+	// compound blocks consisting of more than one block (may contain stale
+	// entries)
+	std::vector<size_t> nontrivial;
+
+	for (size_t block = 0; block < blocks.sets(); ++block)
+	{
+		compoundOf.push_back(0);
+		posInCompound.push_back(block);
+		compounds[0].push_back(block);
+	}
+
+	if (compounds[0].size() > 1)
+	{
+		nontrivial.push_back(0);
+	}
+
+	auto newBlockF = [&compounds, &compoundOf, &posInCompound, &nontrivial](
+		size_t oldBlock, size_t newBlock)
+	{
+		assert(compoundOf.size() == newBlock);
+
+		const size_t compound = compoundOf[oldBlock];
+		compoundOf.push_back(compound);
+		posInCompound.push_back(compounds[compound].size());
+		compounds[compound].push_back(newBlock);
+
+		if (2 == compounds[compound].size())
+		{
+			nontrivial.push_back(compound);
+		}
+	};
+
+	// make the partition stable with respect to the set of all states
+	for (size_t a = 0; a < this->labels_; ++a)
+	{
+		Adjacency post = this->post(a);
+		for (size_t q = 0; q < states; ++q)
+		{
+			if (!post[q].empty())
+			{
+				blocks.mark(q);
+			}
+		}
+
+		blocks.split(newBlockF);
+	}
+
+	std::vector<std::vector<size_t>> edgesByLabel(this->labels_);
+	std::vector<size_t> touchedLabels;
+	std::vector<size_t> countInSplitter(states, 0);
+	std::vector<size_t> newCounterOf(states);
+
+	while (!nontrivial.empty())
+	{
+		if (nullptr != cancel)
+		{
+			cancel->Poll();
+		}
+
+		const size_t compound = nontrivial.back();
+		if (compounds[compound].size() < 2)
+		{
+			nontrivial.pop_back();
+			continue;
+		}
+
+		// the splitter is the smaller of two blocks of the compound block, so
+		// that every state is in a splitter at most log(n) times
+		std::vector<size_t>& members = compounds[compound];
+		const size_t splitter = (blocks.size(members[0]) <= blocks.size(members[1]))?
+			members[0] : members[1];
+
+		const size_t last = members.back();
+		members[posInCompound[splitter]] = last;
+		posInCompound[last] = posInCompound[splitter];
+		members.pop_back();
+
+		if (members.size() < 2)
+		{
+			nontrivial.pop_back();
+		}
+
+		compoundOf[splitter] = compounds.size();
+		posInCompound[splitter] = 0;
+		compounds.push_back(std::vector<size_t>(1, splitter));
+
+		// collect the transitions leading to the splitter before it is split
+		for (const size_t* it = blocks.begin(splitter); it != blocks.end(splitter); ++it)
+		{
+			for (size_t i = inOffsets[*it]; i < inOffsets[*it + 1]; ++i)
+			{
+				const size_t edge = inEdges[i];
+				std::vector<size_t>& labelEdges = edgesByLabel[edgeLabel[edge]];
+				if (labelEdges.empty())
+				{
+					touchedLabels.push_back(edgeLabel[edge]);
+				}
+
+				labelEdges.push_back(edge);
+			}
+		}
+
+		for (size_t a : touchedLabels)
+		{
+			std::vector<size_t>& labelEdges = edgesByLabel[a];
+
+			// split by the predecessors of the splitter ...
+			for (size_t edge : labelEdges)
+			{
+				++countInSplitter[edgeSource[edge]];
+				blocks.mark(edgeSource[edge]);
+			}
+
+			blocks.split(newBlockF);
+
+			// ... and by those with no transition to the rest of the compound block
+			for (size_t edge : labelEdges)
+			{
+				const size_t source = edgeSource[edge];
+				if (countInSplitter[source] == counters[edgeCounter[edge]])
+				{
+					blocks.mark(source);
+				}
+			}
+
+			blocks.split(newBlockF);
+
+			// the transitions now lead to the compound block of the splitter
+			for (size_t edge : labelEdges)
+			{
+				const size_t source = edgeSource[edge];
+				if (0 != countInSplitter[source])
+				{
+					counters.push_back(countInSplitter[source]);
+					newCounterOf[source] = counters.size() - 1;
+					countInSplitter[source] = 0;
+				}
+			}
+
+			for (size_t edge : labelEdges)
+			{
+				assert(0 < counters[edgeCounter[edge]]);
+
+				--counters[edgeCounter[edge]];
+				edgeCounter[edge] = newCounterOf[edgeSource[edge]];
+			}
+
+			labelEdges.clear();
+		}
+
+		touchedLabels.clear();
+	}
+
+	std::vector<size_t> result(states);
+	for (size_t q = 0; q < states; ++q)
+	{
+		result[q] = blocks.setOf(q);
+	}
+
+	return result;
+}
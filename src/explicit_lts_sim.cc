@@ -28,12 +28,14 @@
 
 
 #include "util/caching_allocator.hh"
+#include "util/parallel_worklist.hh"
 #include "util/shared_counter.hh"
 #include "util/shared_list.hh"
 #include "util/splitting_relation.hh"
 
 
 using VATA::Util::BinaryRelation;
+using VATA::Util::SparseBinaryRelation;
 using VATA::Util::SplittingRelation;
 using VATA::Util::SmartSet;
 using VATA::Util::CachingAllocator;
@@ -443,6 +445,17 @@ protected:
 		}
 	}
 
+	void releaseRemove(
+		RemoveList*   remove)
+	{
+		remove->unsafeRelease(
+			[this](RemoveList* list){
+				this->vectorAllocator_.reclaim(list->subList());
+				this->removeAllocator_.reclaim(list);
+			}
+		);
+	}
+
 	void processRemove(
 		Block*   block,
 		size_t   label)
@@ -459,12 +472,7 @@ protected:
 		this->buildPre(preList, block->states_, label);
 		this->split(removeMask, *remove);
 
-		remove->unsafeRelease(
-			[this](RemoveList* list){
-				this->vectorAllocator_.reclaim(list->subList());
-				this->removeAllocator_.reclaim(list);
-			}
-		);
+		this->releaseRemove(remove);
 
 		for (auto& b1 : preList)
 		{
@@ -585,6 +593,29 @@ private:
 	std::vector<size_t> key_;
 	std::vector<std::pair<size_t, size_t>> labelMap_;
 
+	/// the number of threads used for the initialization of counters
+	size_t numThreads_;
+
+	/// the token cancelling the computation (may be @p nullptr)
+	const VATA::CancellationToken* cancel_;
+
+	/**
+	 * @brief  The initial counters and remove sets of a block
+	 */
+	struct BlockInit
+	{
+		/// for every label of the inset of the block, the non-zero counts
+		std::vector<std::pair<size_t, std::vector<std::pair<size_t, size_t>>>> counts_;
+
+		/// for labels with a non-empty remove set, the remove set
+		std::vector<std::pair<size_t, std::vector<size_t>>> remove_;
+
+		BlockInit() :
+			counts_(),
+			remove_()
+		{ }
+	};
+
 	SimulationEngine(const SimulationEngine&);
 
 	SimulationEngine& operator=(const SimulationEngine&);
@@ -606,7 +637,9 @@ private:
 public:
 
 	SimulationEngine(
-		const VATA::ExplicitLTS& lts) :
+		const VATA::ExplicitLTS&          lts,
+		size_t                            numThreads = 1,
+		const VATA::CancellationToken*    cancel = nullptr) :
 		lts_(lts),
 		rowSize_(SimulationEngine::getRowSize(lts.states())),
 		vectorAllocator_(),
@@ -617,7 +650,9 @@ public:
 		index_(lts.states()),
 		queue_(),
 		key_(),
-		labelMap_()
+		labelMap_(),
+		numThreads_(VATA::Util::GetNumThreads(numThreads)),
+		cancel_(cancel)
 	{
 		assert(this->index_.size());
 	}
@@ -626,10 +661,132 @@ public:
 	{
 		for (auto& block : this->partition_)
 		{
+			// remove lists are left pending if the refinement is cancelled
+			for (RemoveList* remove : block->remove_)
+			{
+				if (nullptr != remove)
+				{
+					this->releaseRemove(remove);
+				}
+			}
+
 			delete block;
 		}
 	}
 
+	/**
+	 * @brief  Computes the initial counters and remove sets of a block
+	 *
+	 * Only reads the engine, so it may be called concurrently for different
+	 * blocks (with different @p s).
+	 */
+	void computeBlockInit(
+		Block*                      b1,
+		std::vector<SmartSet>&      delta1,
+		SmartSet&                   s,
+		BlockInit&                  result)
+	{
+		auto row = this->relation_.row(b1->index_);
+		std::vector<bool> relatedBlocks(this->partition_.size());
+
+		for (auto& col : row)
+		{
+			relatedBlocks[col] = true;
+		}
+
+		for (auto& a : b1->inset())
+		{
+			std::vector<std::pair<size_t, size_t>> counts;
+
+			for (auto q : delta1[a])
+			{
+				size_t count = 0;
+
+				for (auto r : this->lts_.post(a)[q])
+				{
+					if (relatedBlocks[this->index_[r].block_->index_])
+					{
+						++count;
+					}
+				}
+
+				if (count)
+				{
+					counts.push_back(std::make_pair(q, count));
+				}
+			}
+
+			result.counts_.push_back(std::make_pair(a, std::move(counts)));
+
+			s.assignFlat(delta1[a]);
+
+			for (auto& col : row)
+			{
+				auto b2 = this->partition_[col];
+				auto elem = b2->states_;
+
+				do
+				{
+					for (auto& q : this->lts_.pre(a)[elem->index_])
+					{
+						s.remove(q);
+					}
+
+					elem = elem->next_;
+				} while (elem != b2->states_);
+			}
+
+			if (s.empty())
+			{
+				continue;
+			}
+
+			result.remove_.push_back(
+				std::make_pair(a, std::vector<size_t>(s.begin(), s.end())));
+		}
+	}
+
+	/**
+	 * @brief  Stores the initial counters and remove sets into a block
+	 */
+	void applyBlockInit(
+		Block*          b1,
+		BlockInit&      blockInit)
+	{
+		size_t size = 0;
+
+		for (auto& a : b1->inset())
+		{
+			size = std::max(size, this->labelMap_[a].second);
+		}
+
+		b1->counter_.resize(size);
+
+		auto removeIt = blockInit.remove_.begin();
+		for (auto& labelCounts : blockInit.counts_)
+		{
+			const size_t a = labelCounts.first;
+
+			for (auto& stateCount : labelCounts.second)
+			{
+				b1->counter_.set(a, stateCount.first, stateCount.second);
+			}
+
+			if ((blockInit.remove_.end() == removeIt) || (removeIt->first != a))
+			{
+				continue;
+			}
+
+			b1->remove_[a] = new RemoveList(new std::vector<size_t>(std::move(removeIt->second)));
+			this->queue_.push_back(std::make_pair(b1, a));
+			++removeIt;
+		}
+
+		assert(blockInit.remove_.end() == removeIt);
+
+		b1->counter_.init();
+	}
+
 	void init(
 		const std::vector<std::vector<size_t>>&   partition,
 		const BinaryRelation&                     relation)
@@ -722,85 +879,74 @@ public:
 			}
 		}
 
-		// initialize counters
-		SmartSet s;
-
-		for (auto& b1 : this->partition_)
+		// initialize counters; counters and remove sets of different blocks are
+		// independent, so they may be computed in parallel, and they are stored
+		// into the blocks in the order of the blocks in any case
+		if (1 == this->numThreads_)
 		{
-			auto row = this->relation_.row(b1->index_);
-			std::vector<bool> relatedBlocks(this->partition_.size());
+			SmartSet s;
 
-			for (auto& col : row)
+			for (auto& b1 : this->partition_)
 			{
-				relatedBlocks[col] = true;
-			}
-
-			size_t size = 0;
+				this->poll();
 
-			for (auto& a : b1->inset())
-			{
-				size = std::max(size, this->labelMap_[a].second);
+				BlockInit blockInit;
+				this->computeBlockInit(b1, delta1, s, blockInit);
+				this->applyBlockInit(b1, blockInit);
 			}
+		}
+		else
+		{
+			std::vector<BlockInit> blockInits(this->partition_.size());
+			std::vector<SmartSet> sets(this->numThreads_);
 
-			b1->counter_.resize(size);
-
-			for (auto& a : b1->inset())
+			VATA::Util::ParallelWorklist<size_t> worklist(this->numThreads_);
+			for (size_t i = 0; i < this->partition_.size(); ++i)
 			{
-				for (auto q : delta1[a])
-				{
-					size_t count = 0;
-
-					for (auto r : this->lts_.post(a)[q])
-					{
-						if (relatedBlocks[this->index_[r].block_->index_])
-						{
-							++count;
-						}
-					}
-
-					if (count)
-					{
-						b1->counter_.set(a, q, count);
-					}
-				}
-
-				s.assignFlat(delta1[a]);
+				worklist.Push(i % this->numThreads_, i);
+			}
 
-				for (auto& col : row)
+			worklist.Run([&](size_t workerId, size_t i)
 				{
-					auto b2 = this->partition_[col];
-					auto elem = b2->states_;
-
-					do
-					{
-						for (auto& q : this->lts_.pre(a)[elem->index_])
-						{
-							s.remove(q);
-						}
+					this->poll();
 
-						elem = elem->next_;
-					} while (elem != b2->states_);
-				}
-
-				if (s.empty())
-				{
-					continue;
-				}
+					this->computeBlockInit(
+						this->partition_[i], delta1, sets[workerId], blockInits[i]);
+				});
 
-				b1->remove_[a] = new RemoveList(new std::vector<size_t>(s.begin(), s.end()));
-				this->queue_.push_back(std::make_pair(b1, a));
-
-				assert(s.size() == b1->remove_[a]->subList()->size());
+			for (size_t i = 0; i < this->partition_.size(); ++i)
+			{
+				this->applyBlockInit(this->partition_[i], blockInits[i]);
 			}
+		}
+	}
 
-			b1->counter_.init();
+	/**
+	 * @brief  Polls the cancellation token (if present)
+	 */
+	void poll() const
+	{
+		if (nullptr != this->cancel_)
+		{
+			this->cancel_->Poll();
 		}
 	}
 
+	/**
+	 * @brief  Refines the partition-relation pair
+	 *
+	 * The refinement is sequential regardless of @p numThreads_: remove sets of
+	 * different blocks share copy-on-write rows of counters and remove lists,
+	 * a split changes the blocks of all remove sets, and the relation is a
+	 * two-dimensional linked structure, so processing remove sets concurrently
+	 * would race on all of them.
+	 */
 	void run()
 	{
 		while (!this->queue_.empty())
 		{
+			this->poll();
+
 			std::pair<Block*, size_t> tmp(this->queue_.back());
 			this->queue_.pop_back();
 			this->processRemove(tmp.first, tmp.second);
@@ -835,17 +981,83 @@ public:
 
 		for (size_t i = 0; i < this->relation_.size(); ++i)
 		{
+			if (tmp[i].empty())
+			{
+				continue;
+			}
+
+			// fill the row of the first state of the block and copy it to the
+			// remaining states of the block
+			const size_t first = tmp[i].front();
 			for (auto j : const_cast<SplittingRelation*>(&this->relation_)->row(i))
 			{
-				for (auto& r : tmp[i])
+				for (auto& s : tmp[j])
+				{
+					result.set(first, s, true);
+				}
+			}
+
+			for (auto& r : tmp[i])
+			{
+				result.copyRow(r, first);
+			}
+		}
+	}
+
+	void buildSparseResult(
+		SparseBinaryRelation&    result,
+		size_t                   size) const
+	{
+		const size_t NO_CLASS = static_cast<size_t>(-1);
+
+		// blocks without states of the output get no class
+		std::vector<size_t> classOf(size, NO_CLASS);
+		std::vector<size_t> blockClass(this->partition_.size(), NO_CLASS);
+		size_t classCnt = 0;
+
+		for (size_t i = 0; i < this->partition_.size(); ++i)
+		{
+			auto elem = this->partition_[i]->states_;
+
+			do
+			{
+				assert(elem);
+
+				if (elem->index_ < size)
 				{
-					for (auto& s : tmp[j])
+					if (NO_CLASS == blockClass[i])
 					{
-						result.set(r, s, true);
+						blockClass[i] = classCnt++;
 					}
+
+					classOf[elem->index_] = blockClass[i];
+				}
+
+				elem = elem->next_;
+
+			} while (elem != this->partition_[i]->states_);
+		}
+
+		std::vector<std::vector<size_t>> upper(classCnt);
+		for (size_t i = 0; i < this->relation_.size(); ++i)
+		{
+			if (NO_CLASS == blockClass[i])
+			{
+				continue;
+			}
+
+			for (auto j : const_cast<SplittingRelation*>(&this->relation_)->row(i))
+			{
+				if (NO_CLASS != blockClass[j])
+				{
+					upper[blockClass[i]].push_back(blockClass[j]);
 				}
 			}
 		}
+
+		assert(std::find(classOf.begin(), classOf.end(), NO_CLASS) == classOf.end());
+
+		result = SparseBinaryRelation(std::move(classOf), std::move(upper));
 	}
 
 	friend std::ostream& operator<<(
@@ -870,14 +1082,16 @@ public:
 BinaryRelation VATA::ExplicitLTS::computeSimulation(
 	const std::vector<std::vector<size_t>>&   partition,
 	const BinaryRelation&                     relation,
-	size_t                                    outputSize)
+	size_t                                    outputSize,
+	size_t                                    numThreads,
+	const VATA::CancellationToken*            cancel)
 {
 	if (0 == outputSize)
 	{
 		return BinaryRelation();
 	}
 
-	SimulationEngine engine(*this);
+	SimulationEngine engine(*this, numThreads, cancel);
 
 	engine.init(partition, relation);
 	engine.run();
@@ -891,7 +1105,9 @@ BinaryRelation VATA::ExplicitLTS::computeSimulation(
 
 
 BinaryRelation VATA::ExplicitLTS::computeSimulation(
-	size_t   outputSize)
+	size_t                           outputSize,
+	size_t                           numThreads,
+	const VATA::CancellationToken*   cancel)
 {
 	std::vector<std::vector<size_t>> partition(1);
 
@@ -901,7 +1117,7 @@ BinaryRelation VATA::ExplicitLTS::computeSimulation(
 	}
 
 	return this->computeSimulation(
-		partition, Util::BinaryRelation(1, true), outputSize
+		partition, Util::BinaryRelation(1, true), outputSize, numThreads, cancel
 	);
 }
 
@@ -912,38 +1128,140 @@ BinaryRelation VATA::ExplicitLTS::computeSimulation()
 }
 
 
+SparseBinaryRelation VATA::ExplicitLTS::computeSparseSimulation(
+	const std::vector<std::vector<size_t>>&   partition,
+	const BinaryRelation&                     relation,
+	size_t                                    outputSize,
+	size_t                                    numThreads,
+	const VATA::CancellationToken*            cancel)
+{
+	if (0 == outputSize)
+	{
+		return SparseBinaryRelation();
+	}
+
+	SimulationEngine engine(*this, numThreads, cancel);
+
+	engine.init(partition, relation);
+	engine.run();
+
+	SparseBinaryRelation result;
+
+	engine.buildSparseResult(result, outputSize);
+
+	return result;
+}
+
+
+SparseBinaryRelation VATA::ExplicitLTS::computeSparseSimulation(
+	size_t                           outputSize,
+	size_t                           numThreads,
+	const VATA::CancellationToken*   cancel)
+{
+	std::vector<std::vector<size_t>> partition(1);
+
+	for (size_t i = 0; i < this->states_; ++i)
+	{
+		partition[0].push_back(i);
+	}
+
+	return this->computeSparseSimulation(
+		partition, Util::BinaryRelation(1, true), outputSize, numThreads, cancel
+	);
+}
+
+
 void VATA::ExplicitLTS::addTransition(
 	size_t   q,
 	size_t   a,
 	size_t   r)
 {
-	if (a >= this->data_.size())
+	if (a >= this->labels_)
 	{
-		this->data_.resize(a + 1);
+		this->labels_ = a + 1;
 	}
 
-	if (q >= this->data_[a].first.size())
+	if (q >= this->states_)
 	{
-		if (q >= this->states_)
-		{
-			this->states_ = q + 1;
-		}
+		this->states_ = q + 1;
+	}
+
+	if (r >= this->states_)
+	{
+		this->states_ = r + 1;
+	}
+
+	this->pending_.push_back(PendingTransition{q, a, r});
 
-		this->data_[a].first.resize(q + 1);
+	++this->transitions_;
+}
+
+
+void VATA::ExplicitLTS::init()
+{
+	const size_t rowSize = this->states_ + 1;
+
+	// first, count transitions of every (label, state) pair
+	this->postOffsets_.assign(this->labels_*rowSize, 0);
+	this->preOffsets_.assign(this->labels_*rowSize, 0);
+
+	for (const PendingTransition& trans : this->pending_)
+	{
+		++this->postOffsets_[trans.a_*rowSize + trans.q_ + 1];
+		++this->preOffsets_[trans.a_*rowSize + trans.r_ + 1];
 	}
 
-	if (r >= this->data_[a].second.size())
+	for (size_t i = 1; i < this->postOffsets_.size(); ++i)
 	{
-		if (r >= this->states_)
+		this->postOffsets_[i] += this->postOffsets_[i - 1];
+		this->preOffsets_[i] += this->preOffsets_[i - 1];
+	}
+
+	// then, place the transitions (in the order in which they were added)
+	this->postTargets_.resize(this->pending_.size());
+	this->preSources_.resize(this->pending_.size());
+
+	std::vector<size_t> postPos(this->postOffsets_);
+	std::vector<size_t> prePos(this->preOffsets_);
+
+	for (const PendingTransition& trans : this->pending_)
+	{
+		this->postTargets_[postPos[trans.a_*rowSize + trans.q_]++] = trans.r_;
+		this->preSources_[prePos[trans.a_*rowSize + trans.r_]++] = trans.q_;
+	}
+
+	std::vector<PendingTransition>().swap(this->pending_);
+
+	// finally, collect the labels of transitions leading to every state
+	this->bwLabelOffsets_.assign(rowSize, 0);
+	for (size_t a = 0; a < this->labels_; ++a)
+	{
+		Adjacency pre = this->pre(a);
+		for (size_t r = 0; r < this->states_; ++r)
 		{
-			this->states_ = r + 1;
+			if (!pre[r].empty())
+			{
+				++this->bwLabelOffsets_[r + 1];
+			}
 		}
-
-		this->data_[a].second.resize(r + 1);
 	}
 
-	this->data_[a].first[q].push_back(r);
-	this->data_[a].second[r].push_back(q);
+	for (size_t r = 1; r < rowSize; ++r)
+	{
+		this->bwLabelOffsets_[r] += this->bwLabelOffsets_[r - 1];
+	}
 
-	++this->transitions_;
+	this->bwLabels_.resize(this->bwLabelOffsets_.back());
+	std::vector<size_t> labelPos(this->bwLabelOffsets_.begin(), this->bwLabelOffsets_.end() - 1);
+	for (size_t a = 0; a < this->labels_; ++a)
+	{
+		Adjacency pre = this->pre(a);
+		for (size_t r = 0; r < this->states_; ++r)
+		{
+			if (!pre[r].empty())
+			{
+				this->bwLabels_[labelPos[r]++] = a;
+			}
+		}
+	}
 }
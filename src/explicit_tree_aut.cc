@@ -352,6 +352,15 @@ void ExplicitTreeAut::AddTransition(const Transition& trans)
 	core_->AddTransition(trans);
 }
 
+
+void ExplicitTreeAut::AddTransitions(
+	const std::vector<Transition>&    transitions)
+{
+	assert(nullptr != core_);
+
+	core_->AddTransitions(transitions);
+}
+
 ExplicitTreeAut::DownAccessor ExplicitTreeAut::operator[](
 	const StateType&           state) const
 {
@@ -460,13 +469,77 @@ bool ExplicitTreeAut::ContainsTransition(
 	return core_->ContainsTransition(children, symbol, state);
 }
 
-bool ExplicitTreeAut::AreTransitionsEmpty()
+bool ExplicitTreeAut::AreTransitionsEmpty() const
 {
     assert(nullptr != core_);
 
 	return core_->AreTransitionsEmpty();
 }
 
+void ExplicitTreeAut::Freeze()
+{
+	assert(nullptr != core_);
+
+	core_->Freeze();
+}
+
+bool ExplicitTreeAut::IsFrozen() const
+{
+	assert(nullptr != core_);
+
+	return core_->IsFrozen();
+}
+
+void ExplicitTreeAut::EnableIncrementalReachability()
+{
+	assert(nullptr != core_);
+
+	core_->EnableIncrementalReachability();
+}
+
+void ExplicitTreeAut::DisableIncrementalReachability()
+{
+	assert(nullptr != core_);
+
+	core_->DisableIncrementalReachability();
+}
+
+bool ExplicitTreeAut::IsIncrementalReachabilityEnabled() const
+{
+	assert(nullptr != core_);
+
+	return core_->IsIncrementalReachabilityEnabled();
+}
+
+void ExplicitTreeAut::EnableSimulationCache()
+{
+	assert(nullptr != core_);
+
+	core_->EnableSimulationCache();
+}
+
+void ExplicitTreeAut::DisableSimulationCache()
+{
+	assert(nullptr != core_);
+
+	core_->DisableSimulationCache();
+}
+
+bool ExplicitTreeAut::IsSimulationCacheEnabled() const
+{
+	assert(nullptr != core_);
+
+	return core_->IsSimulationCacheEnabled();
+}
+
+bool ExplicitTreeAut::IsStateProductive(
+	const StateType&                  state) const
+{
+	assert(nullptr != core_);
+
+	return core_->IsStateProductive(state);
+}
+
 void ExplicitTreeAut::LoadFromString(
 	VATA::Parsing::AbstrParser&       parser,
 	const std::string&                str,
@@ -688,6 +761,19 @@ ExplicitTreeAut ExplicitTreeAut::Intersection(
 		CoreAut::Intersection(*lhs.core_, *rhs.core_, pTranslMap));
 }
 
+ExplicitTreeAut ExplicitTreeAut::Intersection(
+	const ExplicitTreeAut&            lhs,
+	const ExplicitTreeAut&            rhs,
+	const IsectParam&                 params,
+	AutBase::ProductTranslMap*        pTranslMap)
+{
+	assert(nullptr != lhs.core_);
+	assert(nullptr != rhs.core_);
+
+	return ExplicitTreeAut(
+		CoreAut::Intersection(*lhs.core_, *rhs.core_, params, pTranslMap));
+}
+
 ExplicitTreeAut ExplicitTreeAut::IntersectionBU(
 	const ExplicitTreeAut&            lhs,
 	const ExplicitTreeAut&            rhs,
@@ -700,6 +786,42 @@ ExplicitTreeAut ExplicitTreeAut::IntersectionBU(
 		CoreAut::IntersectionBU(*lhs.core_, *rhs.core_, pTranslMap));
 }
 
+bool ExplicitTreeAut::IsIntersectionEmpty(
+	const ExplicitTreeAut&            lhs,
+	const ExplicitTreeAut&            rhs,
+	ExplicitTreeAut*                  pWitness)
+{
+	return ExplicitTreeAut::IsIntersectionEmpty({&lhs, &rhs}, pWitness);
+}
+
+bool ExplicitTreeAut::IsIntersectionEmpty(
+	const std::vector<const ExplicitTreeAut*>&    auts,
+	ExplicitTreeAut*                              pWitness)
+{
+	std::vector<const ExplicitTreeAutCore*> coreAuts;
+	for (const ExplicitTreeAut* aut : auts)
+	{
+		assert(nullptr != aut);
+		assert(nullptr != aut->core_);
+
+		coreAuts.push_back(aut->core_.get());
+	}
+
+	if (nullptr == pWitness)
+	{
+		return CoreAut::IsIntersectionEmpty(coreAuts);
+	}
+
+	ExplicitTreeAutCore witness;
+	if (CoreAut::IsIntersectionEmpty(coreAuts, &witness))
+	{
+		return true;
+	}
+
+	*pWitness = ExplicitTreeAut(CoreAut(std::move(witness)));
+	return false;
+}
+
 bool ExplicitTreeAut::IsLangEmpty() const
 {
 	assert(nullptr != core_);
@@ -715,6 +837,26 @@ AutBase::StateDiscontBinaryRelation ExplicitTreeAut::ComputeSimulation(
 	return core_->ComputeSimulation(params);
 }
 
+AutBase::StateSparseDiscontBinaryRelation ExplicitTreeAut::ComputeSparseSimulation(
+	const VATA::SimParam&                  params) const
+{
+	assert(nullptr != core_);
+
+	return core_->ComputeSparseSimulation(params);
+}
+
+AutBase::StateDiscontBinaryRelation ExplicitTreeAut::RecomputeSimulation(
+	const VATA::SimParam&                         params,
+	const AutBase::StateDiscontBinaryRelation&    oldSim,
+	const std::vector<Transition>&                addedTransitions,
+	const std::vector<Transition>&                removedTransitions) const
+{
+	assert(nullptr != core_);
+
+	return core_->RecomputeSimulation(
+		params, oldSim, addedTransitions, removedTransitions);
+}
+
 
 bool ExplicitTreeAut::CheckInclusion(
 	const ExplicitTreeAut&                 smaller,
@@ -728,6 +870,33 @@ bool ExplicitTreeAut::CheckInclusion(
 }
 
 
+bool ExplicitTreeAut::CheckInclusion(
+	const ExplicitTreeAut&                 smaller,
+	const ExplicitTreeAut&                 bigger,
+	const VATA::InclParam&                 params,
+	ExplicitTreeAut*                       counterexample)
+{
+	assert(nullptr != smaller.core_);
+	assert(nullptr != bigger.core_);
+
+	if (nullptr == counterexample)
+	{
+		return CoreAut::CheckInclusion(*smaller.core_, *bigger.core_, params);
+	}
+
+	ExplicitTreeAutCore coreCounterexample;
+	bool result = CoreAut::CheckInclusion(*smaller.core_, *bigger.core_, params,
+		&coreCounterexample);
+
+	if (!result)
+	{
+		*counterexample = ExplicitTreeAut(std::move(coreCounterexample));
+	}
+
+	return result;
+}
+
+
 bool ExplicitTreeAut::CheckInclusion(
 	const ExplicitTreeAut&                 smaller,
 	const ExplicitTreeAut&                 bigger)
@@ -739,6 +908,58 @@ bool ExplicitTreeAut::CheckInclusion(
 }
 
 
+std::vector<bool> ExplicitTreeAut::CheckInclusionBatch(
+	const ExplicitTreeAut&                 smaller,
+	const std::vector<ExplicitTreeAut>&    biggers,
+	const VATA::InclParam&                 params,
+	bool                                   stopAtFirstSuccess)
+{
+	assert(nullptr != smaller.core_);
+
+	std::vector<const ExplicitTreeAutCore*> biggerCores;
+	for (const ExplicitTreeAut& bigger : biggers)
+	{
+		assert(nullptr != bigger.core_);
+		biggerCores.push_back(bigger.core_.get());
+	}
+
+	return CoreAut::CheckInclusionBatch(*smaller.core_, biggerCores, params,
+		stopAtFirstSuccess);
+}
+
+
+bool ExplicitTreeAut::CheckInclusionPortfolio(
+	const ExplicitTreeAut&                 smaller,
+	const ExplicitTreeAut&                 bigger,
+	const std::vector<VATA::InclParam>&    configs,
+	size_t*                                winner)
+{
+	assert(nullptr != smaller.core_);
+	assert(nullptr != bigger.core_);
+
+	return CoreAut::CheckInclusionPortfolio(*smaller.core_, *bigger.core_,
+		configs, winner);
+}
+
+
+std::vector<VATA::InclParam> ExplicitTreeAut::GetDefaultInclusionPortfolio()
+{
+	return CoreAut::GetDefaultInclusionPortfolio();
+}
+
+
+bool ExplicitTreeAut::CheckEquivalence(
+	const ExplicitTreeAut&                 lhs,
+	const ExplicitTreeAut&                 rhs,
+	const VATA::InclParam&                 params)
+{
+	assert(nullptr != lhs.core_);
+	assert(nullptr != rhs.core_);
+
+	return CoreAut::CheckEquivalence(*lhs.core_, *rhs.core_, params);
+}
+
+
 ExplicitTreeAut ExplicitTreeAut::Reduce() const
 {
 	assert(nullptr != core_);
@@ -789,9 +1010,32 @@ std::string ExplicitTreeAut::ToString() const
 }
 
 
-ExplicitTreeAut ExplicitTreeAut::Complement() const
+ExplicitTreeAut ExplicitTreeAut::Complement(
+	const CancellationToken*      cancel) const
+{
+	assert(nullptr != core_);
+
+	return ExplicitTreeAut(core_->Complement(cancel));
+}
+
+ExplicitTreeAut ExplicitTreeAut::Determinize() const
+{
+	assert(nullptr != core_);
+
+	return ExplicitTreeAut(core_->Determinize());
+}
+
+ExplicitTreeAut ExplicitTreeAut::Determinize(
+	const AutBase::StateDiscontBinaryRelation&     upwardSim) const
+{
+	assert(nullptr != core_);
+
+	return ExplicitTreeAut(core_->Determinize(&upwardSim));
+}
+
+ExplicitTreeAut ExplicitTreeAut::Minimize() const
 {
 	assert(nullptr != core_);
 
-	return ExplicitTreeAut(core_->Complement());
+	return ExplicitTreeAut(core_->Minimize());
 }
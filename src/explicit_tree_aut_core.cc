@@ -8,6 +8,9 @@
  *
  *****************************************************************************/
 
+// Standard library headers
+#include <algorithm>
+#include <mutex>
 
 #include "explicit_tree_aut_core.hh"
 #include "explicit_tree_sim.hh"
@@ -23,14 +26,29 @@ using VATA::Util::Convert;
 using namespace VATA::ExplicitTreeAutCoreUtil;
 
 
-// global tuple cache definition
-ExplicitTreeAutCore::TupleCache ExplicitTreeAutCore::globalTupleCache_;
-
 // global alphabet
 ExplicitTreeAutCore::AlphabetType ExplicitTreeAutCore::globalAlphabet_ =
 	AlphabetType(new ExplicitTreeAut::OnTheFlyAlphabet);
 
 
+ExplicitTreeAutCore::TupleCachePtr ExplicitTreeAutCore::defaultTupleCache()
+{
+	static std::mutex mutex;
+	static std::weak_ptr<TupleCache> defaultCache;
+
+	std::lock_guard<std::mutex> lock(mutex);
+
+	TupleCachePtr cache = defaultCache.lock();
+	if (nullptr == cache)
+	{
+		cache = TupleCachePtr(new TupleCache());
+		defaultCache = cache;
+	}
+
+	return cache;
+}
+
+
 std::unordered_set<size_t> ExplicitTreeAutCore::GetUsedStates() const
 {
 	std::unordered_set<size_t> res;
@@ -59,12 +77,12 @@ BaseTransIterator::BaseTransIterator(
 	tupleIterator_(),
 	end_(false)
 {
-	if (aut.transitions_->begin() == aut.transitions_->end()) {
+	if (aut.clusterMap()->begin() == aut.clusterMap()->end()) {
 		end_ = true;
 		return;
 	}
 
-	stateClusterIterator_ = aut.transitions_->begin();
+	stateClusterIterator_ = aut.clusterMap()->begin();
 
 	symbolSetIterator_ = stateClusterIterator_->second->begin();
 	assert(stateClusterIterator_->second->end() != symbolSetIterator_);
@@ -87,7 +105,7 @@ Iterator& Iterator::operator++()
 		return *this;
 	}
 
-	if (aut_.transitions_->end() != ++stateClusterIterator_)
+	if (aut_.clusterMap()->end() != ++stateClusterIterator_)
 	{
 		symbolSetIterator_ = stateClusterIterator_->second->begin();
 		tupleIterator_ = symbolSetIterator_->second->begin();
@@ -104,7 +122,7 @@ DownAccessor::DownAccessor(
 	const ExplicitTreeAutCore&     aut,
 	size_t                         state) :
 	state_(state),
-	cluster_(ExplicitTreeAutCore::genericLookup(*aut.transitions_, state))
+	cluster_(ExplicitTreeAutCore::genericLookup(*aut.clusterMap(), state))
 { }
 
 Transition DownAccessorIterator::getTrans() const
@@ -172,9 +190,9 @@ void AcceptTransIterator::init()
 {
 	for (; stateSetIterator_ != aut_.finalStates_.end(); ++stateSetIterator_)
 	{	// we try to find the first final state that has an outgoing transition
-		stateClusterIterator_ = aut_.transitions_->find(*stateSetIterator_);
+		stateClusterIterator_ = aut_.clusterMap()->find(*stateSetIterator_);
 
-		if (stateClusterIterator_ != aut_.transitions_->end())
+		if (stateClusterIterator_ != aut_.clusterMap()->end())
 		{
 			break;
 		}
@@ -212,11 +230,14 @@ AcceptTransIterator& AcceptTransIterator::operator++()
 
 
 ExplicitTreeAutCore::ExplicitTreeAutCore(
-	TupleCache&          tupleCache,
+	const TupleCachePtr& tupleCache,
 	AlphabetType&        alphabet) :
 	cache_(tupleCache),
 	finalStates_(),
 	transitions_(StateToTransitionClusterMapPtr(new StateToTransitionClusterMap())),
+	frozen_(),
+	incrReach_(),
+	simCache_(),
 	alphabet_(alphabet)
 { }
 
@@ -228,11 +249,15 @@ ExplicitTreeAutCore::ExplicitTreeAutCore(
 	cache_(aut.cache_),
 	finalStates_(),
 	transitions_(),
+	frozen_(),
+	incrReach_(),
+	simCache_(),
 	alphabet_(aut.alphabet_)
 {
 	if (copyTrans)
 	{
 		transitions_ = aut.transitions_;
+		frozen_ = aut.frozen_;
 	}
 	else
 	{
@@ -251,18 +276,26 @@ ExplicitTreeAutCore::ExplicitTreeAutCore(
 	cache_(aut.cache_),
 	finalStates_(std::move(aut.finalStates_)),
 	transitions_(std::move(aut.transitions_)),
+	frozen_(std::move(aut.frozen_)),
+	incrReach_(std::move(aut.incrReach_)),
+	simCache_(std::move(aut.simCache_)),
 	alphabet_(std::move(aut.alphabet_))
 { }
 
 
 ExplicitTreeAutCore::ExplicitTreeAutCore(
 	const ExplicitTreeAutCore&    aut,
-	TupleCache&                   tupleCache) :
+	const TupleCachePtr&          tupleCache) :
 	cache_(tupleCache),
 	finalStates_(aut.finalStates_),
 	transitions_(aut.transitions_),
+	frozen_(aut.frozen_),
+	incrReach_(),
+	simCache_(),
 	alphabet_(aut.alphabet_)
-{ }
+{
+	cache_->retain(aut.cache_);
+}
 
 
 ExplicitTreeAutCore& ExplicitTreeAutCore::operator=(
@@ -272,8 +305,11 @@ ExplicitTreeAutCore& ExplicitTreeAutCore::operator=(
 	{
 		finalStates_ = rhs.finalStates_;
 		transitions_ = rhs.transitions_;
+		frozen_      = rhs.frozen_;
+		incrReach_.reset();
+		this->clearSimulationCache();
 		alphabet_    = rhs.alphabet_;
-		// NOTE: we don't care about cache_
+		cache_       = rhs.cache_;
 	}
 
 	return *this;
@@ -287,15 +323,161 @@ ExplicitTreeAutCore& ExplicitTreeAutCore::operator=(
 
 	finalStates_ = std::move(rhs.finalStates_);
 	transitions_ = std::move(rhs.transitions_);
+	frozen_      = std::move(rhs.frozen_);
+	incrReach_   = std::move(rhs.incrReach_);
+	simCache_    = std::move(rhs.simCache_);
 	alphabet_    = std::move(rhs.alphabet_);
-	// NOTE: we don't care about cache_
+	cache_       = rhs.cache_;
 
 	return *this;
 }
 
 
+void ExplicitTreeAutCore::AddTransitions(
+	const std::vector<Transition>&    transitions)
+{
+	if (transitions.empty())
+	{
+		return;
+	}
+
+	// sort the transitions so that all transitions with the same parent (and
+	// the same symbol) are processed together
+	std::vector<const Transition*> sorted;
+	sorted.reserve(transitions.size());
+	for (const Transition& trans : transitions)
+	{
+		sorted.push_back(&trans);
+	}
+
+	std::sort(sorted.begin(), sorted.end(),
+		[](const Transition* lhs, const Transition* rhs){ return *lhs < *rhs; });
+	sorted.erase(std::unique(sorted.begin(), sorted.end(),
+		[](const Transition* lhs, const Transition* rhs){ return *lhs == *rhs; }),
+		sorted.end());
+
+	size_t parentCnt = 1;
+	for (size_t i = 1; i < sorted.size(); ++i)
+	{
+		if (sorted[i - 1]->GetParent() != sorted[i]->GetParent())
+		{
+			++parentCnt;
+		}
+	}
+
+	const StateToTransitionClusterMapPtr& clusterMap = this->uniqueClusterMap();
+	clusterMap->reserve(clusterMap->size() + parentCnt);
+
+	auto it = sorted.cbegin();
+	while (sorted.cend() != it)
+	{	// for every parent
+		const StateType& parent = (*it)->GetParent();
+
+		auto parentEnd = it;
+		size_t symbolCnt = 0;
+		for ( ; (sorted.cend() != parentEnd) && ((*parentEnd)->GetParent() == parent);
+			++parentEnd)
+		{
+			if ((parentEnd == it) ||
+				((*(parentEnd - 1))->GetSymbol() != (*parentEnd)->GetSymbol()))
+			{
+				++symbolCnt;
+			}
+		}
+
+		const TransitionClusterPtr& cluster = clusterMap->uniqueCluster(parent);
+		cluster->reserve(cluster->size() + symbolCnt);
+
+		while (parentEnd != it)
+		{	// for every symbol
+			const SymbolType& symbol = (*it)->GetSymbol();
+
+			const TuplePtrSetPtr& tupleSet = cluster->uniqueTuplePtrSet(symbol);
+			for ( ; (parentEnd != it) && ((*it)->GetSymbol() == symbol); ++it)
+			{
+				TuplePtr tuple = this->tupleLookup((*it)->GetChildren());
+				tupleSet->insert(tuple);
+
+				if (incrReach_)
+				{
+					this->notifyTransitionAdded(tuple, symbol, parent);
+				}
+			}
+		}
+	}
+}
+
+
 ExplicitTreeAutCore ExplicitTreeAutCore::Reduce(
 	const ReduceParam&            params) const
+{
+	switch (params.GetRelation())
+	{
+		case ReduceParam::e_reduce_relation::TA_DOWNWARD:
+		{
+			return this->reduceWithSimulation(
+				SimParam::e_sim_relation::TA_DOWNWARD, params.GetCancellationToken());
+		}
+
+		case ReduceParam::e_reduce_relation::TA_UPWARD:
+		{
+			// the translation for upward simulation expects every state to be the
+			// parent of some transition
+			ExplicitTreeAutCore trimmed = this->RemoveUselessStates();
+			if (trimmed.clusterMap()->empty())
+			{
+				return trimmed;
+			}
+
+			// ... and the states to be numbered 0..n-1, while removing useless
+			// states leaves gaps in the numbering
+			StateToStateMap stateMap;
+			size_t stateCnt = 0;
+			StateToStateTranslWeak stateTransl(stateMap,
+				[&stateCnt](const StateType&){ return stateCnt++; });
+
+			ExplicitTreeAutCore reduced = trimmed.ReindexStates(stateTransl)
+				.reduceWithSimulation(
+					SimParam::e_sim_relation::TA_UPWARD, params.GetCancellationToken());
+
+			// give the states back their original numbers
+			StateToStateMap backMap;
+			for (const auto& stateIndexPair : stateMap)
+			{
+				backMap.insert(std::make_pair(stateIndexPair.second, stateIndexPair.first));
+			}
+
+			return reduced.CollapseStates(backMap);
+		}
+
+		case ReduceParam::e_reduce_relation::TA_DOWNWARD_UPWARD:
+		{
+			ReduceParam downParams;
+			downParams.SetRelation(ReduceParam::e_reduce_relation::TA_DOWNWARD);
+			downParams.SetCancellationToken(params.GetCancellationToken());
+			ReduceParam upParams;
+			upParams.SetRelation(ReduceParam::e_reduce_relation::TA_UPWARD);
+			upParams.SetCancellationToken(params.GetCancellationToken());
+
+			return this->Reduce(downParams).Reduce(upParams);
+		}
+
+		case ReduceParam::e_reduce_relation::TA_BISIMULATION:
+		{
+			return this->reduceWithBisimulation(params.GetCancellationToken());
+		}
+
+		default:
+		{
+			throw std::runtime_error("Unknown reduction parameters");
+		}
+	}
+}
+
+
+ExplicitTreeAutCore ExplicitTreeAutCore::reduceWithSimulation(
+	SimParam::e_sim_relation      relation,
+	const CancellationToken*      cancel) const
 {
     /*
 	typedef Util::TwoWayDict<
@@ -318,22 +500,12 @@ ExplicitTreeAutCore ExplicitTreeAutCore::Reduce(
 	 this->BuildStateIndex(stateTranslator);
 
 	SimParam simParam;
-	switch (params.GetRelation())
-	{
-		case ReduceParam::e_reduce_relation::TA_DOWNWARD:
-		{
-			simParam.SetRelation(SimParam::e_sim_relation::TA_DOWNWARD);
-            simParam.SetNumStates(stateCnt);
-			break;
-		}
-
-		default:
-		{
-			assert(false);
-		}
-	}
+	simParam.SetRelation(relation);
+	simParam.SetNumStates(stateCnt);
+	simParam.SetCancellationToken(cancel);
 
-	StateDiscontBinaryRelation sim = this->ComputeSimulation(simParam);
+	// the sparse form suffices as only the equivalence classes are needed
+	StateSparseDiscontBinaryRelation sim = this->ComputeSparseSimulation(simParam);
 
 	//assert(false);
 
@@ -400,7 +572,7 @@ std::string ExplicitTreeAutCore::ToString() const
 	result += "\n";
 	result += "Transitions\n";
 
-	for (const auto& stClusterPair: *this->transitions_) {
+	for (const auto& stClusterPair: *this->clusterMap()) {
 		const StateType& parent = stClusterPair.first;
 		std::string parentStr = "q" + Convert::ToString(parent);
 
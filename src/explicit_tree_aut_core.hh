@@ -11,6 +11,9 @@
 #ifndef _VATA_EXPLICIT_TREE_AUT_CORE_HH_
 #define _VATA_EXPLICIT_TREE_AUT_CORE_HH_
 
+// Standard library headers
+#include <mutex>
+
 // VATA headers
 #include <vata/aut_base.hh>
 #include <vata/explicit_tree_aut.hh>
@@ -22,8 +25,10 @@
 
 #include <vata/explicit_lts.hh>
 #include <vata/incl_param.hh>
+#include <vata/isect_param.hh>
 
-#include "util/cache.hh"
+#include "explicit_tree_frozen.hh"
+#include "util/arena.hh"
 
 
 namespace VATA
@@ -45,11 +50,25 @@ namespace VATA
 		using StateType        = ExplicitTreeAut::StateType;
 		using FinalStateSet    = ExplicitTreeAut::FinalStateSet;
 		using SymbolType       = ExplicitTreeAut::SymbolType;
-		using TuplePtr         = std::shared_ptr<ExplicitTreeAut::StateTuple>;
+		using TuplePtr         = Util::Arena<ExplicitTreeAut::StateTuple>::Ptr;
 		using TuplePtrSet      = std::set<TuplePtr>;
 		using TuplePtrSetPtr   = std::shared_ptr<TuplePtrSet>;
 		using Transition       = ExplicitTreeAut::Transition;
 
+		using FrozenTransitionsPtr = std::shared_ptr<const FrozenTransitions>;
+
+		class FrozenStorage;
+		using FrozenStoragePtr = std::shared_ptr<const FrozenStorage>;
+
+		class IncrementalReachability;
+		using IncrementalReachabilityPtr = std::shared_ptr<IncrementalReachability>;
+
+		class SimulationCache;
+		using SimulationCachePtr = std::shared_ptr<SimulationCache>;
+
+		struct InclusionSimulation;
+		using InclusionSimulationPtr = std::shared_ptr<const InclusionSimulation>;
+
 		class BaseTransIterator;
 		class Iterator;
 		class AcceptTransIterator;
@@ -113,12 +132,90 @@ namespace VATA
 			}
 		};
 
+		using StateToTransitionClusterMapPtr = std::shared_ptr<StateToTransitionClusterMap>;
+
 		class AcceptTrans;
 		class DownAccessor;
 	}
 }
 
 
+/**
+ * @brief  Transitions of a frozen automaton
+ *
+ * A frozen automaton keeps only the compact storage of its transitions (its
+ * cluster map is released).  Algorithms that do not traverse the compact
+ * storage get the cluster map rebuilt from it, sharing the interned tuples,
+ * upon the first request; the rebuilt map is kept together with the storage.
+ * Rebuilding is thread-safe.
+ */
+class VATA::ExplicitTreeAutCoreUtil::FrozenStorage
+{
+private:  // data members
+
+	FrozenTransitions transitions_;
+
+	mutable std::once_flag clusterMapFlag_;
+	mutable StateToTransitionClusterMapPtr clusterMap_;
+
+private:  // methods
+
+	FrozenStorage(const FrozenStorage&);
+	FrozenStorage& operator=(const FrozenStorage&);
+
+public:   // methods
+
+	explicit FrozenStorage(
+		const StateToTransitionClusterMap&     clusterMap) :
+		transitions_(clusterMap),
+		clusterMapFlag_(),
+		clusterMap_()
+	{ }
+
+	const FrozenTransitions& GetTransitions() const
+	{
+		return transitions_;
+	}
+
+	/**
+	 * @brief  Returns the cluster map with the transitions
+	 *
+	 * The map is rebuilt upon the first call.
+	 */
+	const StateToTransitionClusterMapPtr& GetClusterMap() const
+	{
+		std::call_once(clusterMapFlag_, [this]()
+			{
+				StateToTransitionClusterMapPtr clusterMap(new StateToTransitionClusterMap());
+				clusterMap->reserve(transitions_.ParentCount());
+
+				for (size_t p = 0; p < transitions_.ParentCount(); ++p)
+				{
+					const TransitionClusterPtr& cluster =
+						clusterMap->uniqueCluster(transitions_.GetParent(p));
+					cluster->reserve(transitions_.SymbolsEnd(p) - transitions_.SymbolsBegin(p));
+
+					for (size_t s = transitions_.SymbolsBegin(p); s < transitions_.SymbolsEnd(p); ++s)
+					{
+						const TuplePtrSetPtr& tupleSet =
+							cluster->uniqueTuplePtrSet(transitions_.GetSymbol(s));
+
+						for (size_t t = transitions_.TuplesBegin(s); t < transitions_.TuplesEnd(s); ++t)
+						{
+							tupleSet->insert(
+								transitions_.GetTuplePtrById(transitions_.GetTupleId(t)));
+						}
+					}
+				}
+
+				clusterMap_ = clusterMap;
+			});
+
+		return clusterMap_;
+	}
+};
+
+
 /**
  * @brief  Base class for transition iterators
  */
@@ -404,7 +501,8 @@ private:  // data types
 	using TuplePtrSet      = ExplicitTreeAutCoreUtil::TuplePtrSet;
 	using TuplePtrSetPtr   = ExplicitTreeAutCoreUtil::TuplePtrSetPtr;
 	using TupleSet         = std::set<StateTuple>;
-	using TupleCache       = Util::Cache<StateTuple>;
+	using TupleCache       = Util::Arena<StateTuple>;
+	using TupleCachePtr    = TupleCache::ArenaPtr;
 
 	using SymbolDict                      = ExplicitTreeAut::SymbolDict;
 	using StringSymbolToSymbolTranslStrict= ExplicitTreeAut::StringSymbolToSymbolTranslStrict;
@@ -419,19 +517,70 @@ private:  // data types
 	using TransitionCluster              = ExplicitTreeAutCoreUtil::TransitionCluster;
 	using TransitionClusterPtr           = ExplicitTreeAutCoreUtil::TransitionClusterPtr;
 	using StateToTransitionClusterMap    = ExplicitTreeAutCoreUtil::StateToTransitionClusterMap;
-	using StateToTransitionClusterMapPtr = std::shared_ptr<StateToTransitionClusterMap>;
+	using StateToTransitionClusterMapPtr = ExplicitTreeAutCoreUtil::StateToTransitionClusterMapPtr;
+
+	using FrozenTransitions              = ExplicitTreeAutCoreUtil::FrozenTransitions;
+	using FrozenTransitionsPtr           = ExplicitTreeAutCoreUtil::FrozenTransitionsPtr;
+	using FrozenStorage                  = ExplicitTreeAutCoreUtil::FrozenStorage;
+	using FrozenStoragePtr               = ExplicitTreeAutCoreUtil::FrozenStoragePtr;
+
+	using IncrementalReachability        = ExplicitTreeAutCoreUtil::IncrementalReachability;
+	using IncrementalReachabilityPtr     = ExplicitTreeAutCoreUtil::IncrementalReachabilityPtr;
+
+	using SimulationCache                = ExplicitTreeAutCoreUtil::SimulationCache;
+	using SimulationCachePtr             = ExplicitTreeAutCoreUtil::SimulationCachePtr;
+	using InclusionSimulation            = ExplicitTreeAutCoreUtil::InclusionSimulation;
+	using InclusionSimulationPtr         = ExplicitTreeAutCoreUtil::InclusionSimulationPtr;
 
 	using Convert          = VATA::Util::Convert;
 
 
 private:  // data members
 
-	TupleCache& cache_;
+	/**
+	 * @brief  The arena of tuples of the automaton
+	 *
+	 * Tuples are handles into the arena, so the arena is shared by all
+	 * automata whose transitions may contain its tuples.
+	 */
+	TupleCachePtr cache_;
 
 	FinalStateSet finalStates_;
 
+	/**
+	 * @brief  The transitions of the automaton
+	 *
+	 * It is @p nullptr while the automaton is frozen; the transitions are then
+	 * kept in @p frozen_ only (see clusterMap()).
+	 */
 	StateToTransitionClusterMapPtr transitions_;
 
+	/**
+	 * @brief  Compact read-only storage of the transitions
+	 *
+	 * Created by Freeze(), which releases @p transitions_, and dropped whenever
+	 * the transitions are modified (see uniqueClusterMap()).
+	 */
+	FrozenStoragePtr frozen_;
+
+	/**
+	 * @brief  Productive states maintained incrementally
+	 *
+	 * Created by EnableIncrementalReachability() and updated by
+	 * AddTransition() and AddTransitions().  It is not copied together with
+	 * the automaton and it is dropped by Clear().
+	 */
+	IncrementalReachabilityPtr incrReach_;
+
+	/**
+	 * @brief  Cache of computed simulations
+	 *
+	 * Created by EnableSimulationCache() and cleared whenever the transitions
+	 * are modified (see uniqueClusterMap()).  It is not copied together with
+	 * the automaton.
+	 */
+	SimulationCachePtr simCache_;
+
 	/**
 	 * @brief  The alphabet of the automaton
 	 *
@@ -442,7 +591,14 @@ private:  // data members
 
 	static AlphabetType globalAlphabet_;
 
-	static TupleCache globalTupleCache_;
+	/**
+	 * @brief  Returns the arena of tuples used by default
+	 *
+	 * All automata created with the default arena while it exists share it, so
+	 * that their tuples can be mixed; the arena is freed at once when there is
+	 * no such automaton.
+	 */
+	static TupleCachePtr defaultTupleCache();
 
 private:  // methods
 
@@ -464,13 +620,38 @@ private:  // methods
 
 	TuplePtr tupleLookup(const StateTuple& tuple)
 	{
-		return cache_.lookup(tuple);
+		return cache_->lookup(tuple);
+	}
+
+
+	/**
+	 * @brief  Returns the transitions for reading
+	 *
+	 * For a frozen automaton, the cluster map is rebuilt from the frozen
+	 * storage upon the first call.
+	 */
+	const StateToTransitionClusterMapPtr& clusterMap() const
+	{
+		if (nullptr != transitions_)
+		{
+			return transitions_;
+		}
+
+		assert(nullptr != frozen_);
+		return frozen_->GetClusterMap();
 	}
 
 
 	const StateToTransitionClusterMapPtr& uniqueClusterMap()
 	{
-		assert(nullptr != transitions_);
+		if (nullptr == transitions_)
+		{
+			transitions_ = this->clusterMap();
+		}
+
+		// the transitions are about to be modified
+		frozen_.reset();
+		this->clearSimulationCache();
 
 		if (!transitions_.unique())
 		{
@@ -494,11 +675,143 @@ private:  // methods
 	}
 
 
+	/**
+	 * @brief  Updates the incrementally maintained productive states
+	 *
+	 * Needs to be called for every transition added to the automaton while
+	 * @p incrReach_ is not @p nullptr.
+	 */
+	void notifyTransitionAdded(
+		const TuplePtr&           children,
+		const SymbolType&         symbol,
+		const StateType&          parent);
+
+
+	/**
+	 * @brief  Updates the count of productive final states in @p incrReach_
+	 *
+	 * Needs to be called for every state that becomes final while
+	 * @p incrReach_ is not @p nullptr.
+	 */
+	void notifyFinalStateAdded(
+		const StateType&          state);
+
+
+	void notifyFinalStatesErased();
+
+
+	void insertFinalState(
+		const StateType&          state)
+	{
+		if (finalStates_.insert(state).second && incrReach_)
+		{
+			this->notifyFinalStateAdded(state);
+		}
+	}
+
+
+	/**
+	 * @brief  Computes the states whose language is not empty
+	 *
+	 * The states are computed by a counter-based (Horn-SAT-like) bottom-up
+	 * propagation over the index of distinct tuples to their parents (the
+	 * symbols are irrelevant).  Every tuple keeps the number of its distinct
+	 * children that have not been reached yet and fires when it drops to
+	 * zero, so the computation runs in time linear in the size of transitions.
+	 *
+	 * @param[out]  reachable    The set of reachable states
+	 * @param[in]   stopAtFinal  Stop as soon as a final state is reached?
+	 *
+	 * @returns  @p true if the computation stopped at a final state, @p false
+	 *           otherwise
+	 */
+	bool computeBottomUpReachable(
+		std::unordered_set<StateType>&      reachable,
+		bool                                stopAtFinal) const;
+
+
+	/**
+	 * @brief  Checks language emptiness using @p incrReach_
+	 *
+	 * Takes constant time, @p incrReach_ counts the productive final states.
+	 */
+	bool isLangEmptyIncremental() const;
+
+
+	/**
+	 * @brief  Drops all simulations in the cache (if enabled)
+	 *
+	 * The cache holds pointers to the transitions, so this needs to be done
+	 * before checking whether the transitions are shared.
+	 */
+	void clearSimulationCache();
+
+
+	StateDiscontBinaryRelation computeSimulationUncached(
+		const VATA::SimParam&          params) const;
+
+
+	StateSparseDiscontBinaryRelation computeSparseSimulationUncached(
+		const VATA::SimParam&          params) const;
+
+
+	/**
+	 * @brief  Computes the simulation for inclusion checking
+	 *
+	 * The simulation is computed on the union of @p smaller and @p *this (the
+	 * bigger automaton).
+	 *
+	 * @param[in]  smaller  The smaller automaton (with states disjoint from
+	 *                      the states of @p *this)
+	 * @param[in]  params   Parameters of inclusion checking
+	 */
+	StateDiscontBinaryRelation computeInclusionSimulation(
+		const ExplicitTreeAutCore&    smaller,
+		const VATA::InclParam&        params) const;
+
+
+	/**
+	 * @brief  Sanitizes automata and computes the simulation for inclusion
+	 *
+	 * @p smaller and @p *this (the bigger automaton) are sanitized for
+	 * inclusion checking and the simulation is computed on the union of the
+	 * sanitized automata.  If the simulation cache of @p *this is enabled, the
+	 * result is stored there under the transitions of both automata.
+	 *
+	 * @param[in]  smaller  The smaller automaton
+	 * @param[in]  params   Parameters of inclusion checking
+	 */
+	InclusionSimulationPtr getInclusionSimulation(
+		const ExplicitTreeAutCore&    smaller,
+		const VATA::InclParam&        params) const;
+
+
+	/**
+	 * @brief  Collapses states equivalent w.r.t. a simulation
+	 */
+	ExplicitTreeAutCore reduceWithSimulation(
+		SimParam::e_sim_relation      relation,
+		const CancellationToken*      cancel) const;
+
+
+	/**
+	 * @brief  Collapses states equivalent w.r.t. downward bisimulation
+	 */
+	ExplicitTreeAutCore reduceWithBisimulation(
+		const CancellationToken*      cancel) const;
+
+
+	template <class Index>
+	ExplicitLTS translateDownwardFrozen(
+		size_t        numStates,
+		Index&        stateIndex) const;
+
+
 public:   // methods
 
 
 	explicit ExplicitTreeAutCore(
-		TupleCache&                   tupleCache = globalTupleCache_,
+		const TupleCachePtr&          tupleCache = defaultTupleCache(),
 		AlphabetType&                 alphabet = globalAlphabet_);
 
 
@@ -524,9 +837,16 @@ public:   // methods
 		ExplicitTreeAutCore&&         aut);
 
 
+	/**
+	 * @brief  Copies an automaton with another arena of tuples
+	 *
+	 * The new automaton shares the transitions (and their tuples) with @p aut,
+	 * but new tuples are interned in @p tupleCache, which retains the arena of
+	 * @p aut.
+	 */
 	ExplicitTreeAutCore(
 		const ExplicitTreeAutCore&    aut,
-		TupleCache&                   tupleCache);
+		const TupleCachePtr&          tupleCache);
 
 
 	ExplicitTreeAutCore& operator=(
@@ -548,13 +868,19 @@ public:   // methods
 	void SetStateFinal(
 		const StateType&          state)
 	{
-		finalStates_.insert(state);
+		// the upward simulation depends on final states
+		this->clearSimulationCache();
+		this->insertFinalState(state);
 	}
 
 	void SetStatesFinal(
         const std::set<StateType>&    states)
 	{
-		finalStates_.insert(states.begin(), states.end());
+		this->clearSimulationCache();
+		for (const StateType& state : states)
+		{
+			this->insertFinalState(state);
+		}
 	}
 
 	bool IsStateFinal(
@@ -565,7 +891,13 @@ public:   // methods
 
 	void EraseFinalStates()
 	{
+		this->clearSimulationCache();
 		finalStates_.clear();
+
+		if (incrReach_)
+		{
+			this->notifyFinalStatesErased();
+		}
 	}
 
 	AcceptTrans GetAcceptTrans() const
@@ -575,9 +907,101 @@ public:   // methods
 
 	const StateToTransitionClusterMapPtr& GetTransitions() const
 	{
-		return transitions_;
+		return this->clusterMap();
+	}
+
+	/**
+	 * @brief  Replaces the transitions by their compact read-only storage
+	 *
+	 * After the call, intersection, removal of useless states,
+	 * TranslateDownward() and the non-recursive downward inclusion traverse
+	 * the transitions using the compact storage (see GetFrozenTransitions()).
+	 * The cluster map of transitions is released; the other algorithms get it
+	 * rebuilt from the storage once.  The storage is dropped upon the first
+	 * modification of the transitions.
+	 */
+	void Freeze()
+	{
+		if (!frozen_)
+		{
+			assert(nullptr != transitions_);
+
+			frozen_ = FrozenStoragePtr(new FrozenStorage(*transitions_));
+			transitions_ = nullptr;
+		}
+	}
+
+	bool IsFrozen() const
+	{
+		return nullptr != frozen_;
 	}
 
+	/**
+	 * @brief  Returns the compact read-only storage of transitions
+	 *
+	 * @returns  The storage created by Freeze() or @p nullptr if the automaton
+	 *           is not frozen
+	 */
+	FrozenTransitionsPtr GetFrozenTransitions() const
+	{
+		if (!frozen_)
+		{
+			return nullptr;
+		}
+
+		return FrozenTransitionsPtr(frozen_, &frozen_->GetTransitions());
+	}
+
+	/**
+	 * @brief  Starts maintaining the set of productive states incrementally
+	 *
+	 * The productive states (states with a non-empty language) are computed
+	 * once and then updated whenever a transition is added, so that
+	 * IsLangEmpty() and IsStateProductive() do not traverse the whole
+	 * automaton.  The incremental mode is not copied together with the
+	 * automaton and it is switched off by Clear().
+	 */
+	void EnableIncrementalReachability();
+
+	void DisableIncrementalReachability()
+	{
+		incrReach_.reset();
+	}
+
+	bool IsIncrementalReachabilityEnabled() const
+	{
+		return nullptr != incrReach_;
+	}
+
+	/**
+	 * @brief  Starts caching computed simulations
+	 *
+	 * Simulations computed by ComputeSimulation(), ComputeSparseSimulation(),
+	 * and by inclusion checking (if it is not given a simulation) are kept
+	 * until the transitions are modified.
+	 */
+	void EnableSimulationCache();
+
+	void DisableSimulationCache()
+	{
+		simCache_.reset();
+	}
+
+	bool IsSimulationCacheEnabled() const
+	{
+		return nullptr != simCache_;
+	}
+
+	/**
+	 * @brief  Checks whether the language of a state is not empty
+	 *
+	 * Takes constant time in the incremental mode (see
+	 * EnableIncrementalReachability()), otherwise the productive states are
+	 * computed.
+	 */
+	bool IsStateProductive(
+		const StateType&          state) const;
+
    /**
     * @brief Retrieves a container with all states of the automaton
     *
@@ -588,10 +1012,12 @@ public:   // methods
 
 	void Clear()
 	{
-		assert(nullptr != transitions_);
+		incrReach_.reset();
+		this->clearSimulationCache();
 
-		if (!transitions_.unique())
+		if ((nullptr == transitions_) || !transitions_.unique())
 		{
+			frozen_.reset();
 			transitions_ = StateToTransitionClusterMapPtr(
 				new StateToTransitionClusterMap());
 		}
@@ -638,19 +1064,38 @@ public:   // methods
 		const SymbolType&         symbol,
 		const StateType&          parent)
 	{
-		this->internalAddTransition(this->tupleLookup(children), symbol, parent);
+		TuplePtr tuple = this->tupleLookup(children);
+		this->internalAddTransition(tuple, symbol, parent);
+
+		if (incrReach_)
+		{
+			this->notifyTransitionAdded(tuple, symbol, parent);
+		}
 	}
 
+	/**
+	 * @brief  Adds a batch of transitions
+	 *
+	 * The transitions are sorted and deduplicated, the tables are reserved
+	 * for the new parent states and symbols, and the copy-on-write checks are
+	 * performed only once for every parent state and every (parent, symbol)
+	 * pair.
+	 *
+	 * @param[in]  transitions  The transitions to be added
+	 */
+	void AddTransitions(
+		const std::vector<Transition>&    transitions);
+
 
 	bool ContainsTransition(
 		const StateTuple&         children,
 		const SymbolType&         symbol,
 		const StateType&          parent)
 	{
-		assert(nullptr != transitions_);
+		const StateToTransitionClusterMap& clusterMap = *this->clusterMap();
 
-		auto itStateToClusterMap = transitions_->find(parent);
-		if (transitions_->end() != itStateToClusterMap)
+		auto itStateToClusterMap = clusterMap.find(parent);
+		if (clusterMap.end() != itStateToClusterMap)
 		{
 			assert(nullptr != itStateToClusterMap->second);
 			const TransitionCluster& cluster = *itStateToClusterMap->second;
@@ -677,9 +1122,15 @@ public:   // methods
 			trans.GetParent());
 	}
 
-	bool AreTransitionsEmpty()
+	bool AreTransitionsEmpty() const
 	{
-		return this->uniqueClusterMap()->empty();
+		if (nullptr != transitions_)
+		{
+			return transitions_->empty();
+		}
+
+		assert(nullptr != frozen_);
+		return 0 == frozen_->GetTransitions().ParentCount();
 	}
 
 //	static void CopyTransitions(
@@ -706,11 +1157,15 @@ protected:// methods
 			symbolTransl(StringRank(symbolRankPair.first, symbolRankPair.second));
 		}
 
+		this->clearSimulationCache();
 		for (const AutDescription::State& s : desc.finalStates)
 		{
-			finalStates_.insert(stateTransl(s));
+			this->insertFinalState(stateTransl(s));
 		}
 
+		std::vector<Transition> transitions;
+		transitions.reserve(desc.transitions.size());
+
 		for (const AutDescription::Transition& t : desc.transitions)
 		{
 			// traverse the transitions
@@ -725,11 +1180,12 @@ protected:// methods
 				children.push_back(stateTransl(c));
 			}
 
-			this->AddTransition(
-				children,
-				symbolTransl(StringRank(symbolStr, children.size())),
-				stateTransl(parentStr));
+			SymbolType symbol = symbolTransl(StringRank(symbolStr, children.size()));
+
+			transitions.push_back(Transition(stateTransl(parentStr), symbol, children));
 		}
+
+		this->AddTransitions(transitions);
 	}
 
 
@@ -786,7 +1242,7 @@ public:   // methods
 			index(state);
 		}
 
-		for (auto& stateClusterPair : *transitions_)
+		for (auto& stateClusterPair : *this->clusterMap())
 		{
 			assert(stateClusterPair.second);
 
@@ -825,7 +1281,7 @@ public:   // methods
 
 		auto clusterMap = dst.uniqueClusterMap();
 
-		for (auto& stateClusterPair : *transitions_)
+		for (auto& stateClusterPair : *this->clusterMap())
 		{
 			assert(stateClusterPair.second);
 
@@ -860,7 +1316,7 @@ public:   // methods
 		Index&                    index,
 		bool                      addFinalStates = true) const
 	{
-		ExplicitTreeAutCore res;
+		ExplicitTreeAutCore res(cache_);
 		this->ReindexStates(res, index, addFinalStates);
 		res.SetAlphabet(this->GetAlphabet());
 
@@ -897,10 +1353,7 @@ public:   // methods
 		const StateSetLight&         rhsSet,
 		OperationFunc&               opFunc)
 	{
-		assert(nullptr != lhs.transitions_);
-		assert(nullptr != rhs.transitions_);
-
-		auto leftCluster = ExplicitTreeAutCore::genericLookup(*lhs.transitions_, lhsState);
+		auto leftCluster = ExplicitTreeAutCore::genericLookup(*lhs.clusterMap(), lhsState);
 
 		if (!leftCluster)
 		{
@@ -911,7 +1364,7 @@ public:   // methods
 
 		for (const StateType& rhsState : rhsSet)
 		{
-			auto rightCluster = ExplicitTreeAutCore::genericLookup(*rhs.transitions_, rhsState);
+			auto rightCluster = ExplicitTreeAutCore::genericLookup(*rhs.clusterMap(), rhsState);
 
 			if (rightCluster)
 			{
@@ -1040,7 +1493,9 @@ public:   // methods
 		const VATA::SimParam&          params) const;
 
 	StateDiscontBinaryRelation ComputeDownwardSimulation(
-		size_t                         size) const;
+		size_t                         size,
+		size_t                         numThreads = 1,
+		const CancellationToken*       cancel = nullptr) const;
 
 	// template <class Index>
 	// AutBase::StateBinaryRelation ComputeDownwardSimulation(
@@ -1052,13 +1507,43 @@ public:   // methods
 		const VATA::SimParam&          params) const;
 
 	StateDiscontBinaryRelation ComputeUpwardSimulation(
-		size_t                         size) const;
+		size_t                         size,
+		size_t                         numThreads = 1,
+		const CancellationToken*       cancel = nullptr) const;
 
 	// template <class Index>
 	// AutBase::StateBinaryRelation ComputeUpwardSimulation(
 	// 	size_t                   size,
 	// 	const Index&             index) const;
 
+	/**
+	 * @brief  Computes the simulation in a sparse form
+	 *
+	 * The same as ComputeSimulation(), but the result is kept as classes of
+	 * simulation-equivalent states and the order on them, so its size is not
+	 * quadratic in the number of states.
+	 */
+	StateSparseDiscontBinaryRelation ComputeSparseSimulation(
+		const VATA::SimParam&          params) const;
+
+	/**
+	 * @brief  Recomputes the simulation after the automaton has been modified
+	 *
+	 * The original simulation, extended with pairs that may have become valid
+	 * due to the modification, is used as the initial approximation of the
+	 * simulation.
+	 *
+	 * @param[in]  params              Parameters of the simulation
+	 * @param[in]  oldSim              The simulation before the modification
+	 * @param[in]  addedTransitions    Transitions added to the automaton
+	 * @param[in]  removedTransitions  Transitions removed from the automaton
+	 */
+	StateDiscontBinaryRelation RecomputeSimulation(
+		const VATA::SimParam&                  params,
+		const StateDiscontBinaryRelation&      oldSim,
+		const std::vector<Transition>&         addedTransitions,
+		const std::vector<Transition>&         removedTransitions) const;
+
 
 	static ExplicitTreeAutCore Union(
 		const ExplicitTreeAutCore&            lhs,
@@ -1078,12 +1563,59 @@ public:   // methods
 		VATA::AutBase::ProductTranslMap*     pTranslMap = nullptr);
 
 
+	static ExplicitTreeAutCore Intersection(
+		const ExplicitTreeAutCore&           lhs,
+		const ExplicitTreeAutCore&           rhs,
+		const VATA::IsectParam&              params,
+		VATA::AutBase::ProductTranslMap*     pTranslMap = nullptr);
+
+
+	/**
+	 * @brief  Top-down product construction using a pool of threads
+	 *
+	 * Product states are explored by @p numThreads threads (0 denotes the
+	 * number of hardware threads) using a work-stealing worklist and a
+	 * concurrent map of product states.  The result is the same as the result
+	 * of Intersection() up to renaming of states.
+	 */
+	static ExplicitTreeAutCore IntersectionParallel(
+		const ExplicitTreeAutCore&           lhs,
+		const ExplicitTreeAutCore&           rhs,
+		size_t                               numThreads,
+		VATA::AutBase::ProductTranslMap*     pTranslMap = nullptr);
+
+
 	static ExplicitTreeAutCore IntersectionBU(
 		const ExplicitTreeAutCore&           lhs,
 		const ExplicitTreeAutCore&           rhs,
 		VATA::AutBase::ProductTranslMap*     pTranslMap = nullptr);
 
 
+	/**
+	 * @brief  Checks whether the intersection of languages is empty
+	 *
+	 * The product of the automata is explored bottom-up on the fly, without
+	 * being constructed, and the exploration stops as soon as a product state
+	 * accepting in all automata is derived.
+	 *
+	 * @param[in]   auts      The automata (at least one)
+	 * @param[out]  pWitness  If not @p nullptr and the intersection is not
+	 *                        empty, a tree from the intersection is stored here
+	 *                        (as an automaton accepting exactly the tree)
+	 *
+	 * @returns  @p true if the intersection is empty, @p false otherwise
+	 */
+	static bool IsIntersectionEmpty(
+		const std::vector<const ExplicitTreeAutCore*>&    auts,
+		ExplicitTreeAutCore*                              pWitness = nullptr);
+
+
+	static bool IsIntersectionEmpty(
+		const ExplicitTreeAutCore&           lhs,
+		const ExplicitTreeAutCore&           rhs,
+		ExplicitTreeAutCore*                 pWitness = nullptr);
+
+
 	ExplicitTreeAutCore GetCandidateTree() const;
 
 
@@ -1115,28 +1647,100 @@ public:   // methods
 	}
 
 
+	/**
+	 * @brief  Checks inclusion
+	 *
+	 * If @p counterexample is not @p nullptr and the inclusion does not hold,
+	 * a tree accepted by @p smaller but not by @p bigger is added to it.
+	 */
 	static bool CheckInclusion(
 		const ExplicitTreeAutCore&          smaller,
 		const ExplicitTreeAutCore&          bigger,
+		const VATA::InclParam&              params,
+		ExplicitTreeAutCore*                counterexample = nullptr);
+
+
+	static std::vector<bool> CheckInclusionBatch(
+		const ExplicitTreeAutCore&                      smaller,
+		const std::vector<const ExplicitTreeAutCore*>&  biggers,
+		const VATA::InclParam&                          params,
+		bool                                            stopAtFirstSuccess);
+
+
+	static bool CheckInclusionPortfolio(
+		const ExplicitTreeAutCore&          smaller,
+		const ExplicitTreeAutCore&          bigger,
+		const std::vector<InclParam>&       configs,
+		size_t*                             winner);
+
+
+	static std::vector<InclParam> GetDefaultInclusionPortfolio();
+
+
+	static bool CheckEquivalence(
+		const ExplicitTreeAutCore&          lhs,
+		const ExplicitTreeAutCore&          rhs,
 		const VATA::InclParam&              params);
 
 
 	template <
 		class Rel>
 	ExplicitTreeAutCore ComplementWithPreorder(
-		const Rel&                          preorder) const;
+		const Rel&                          preorder,
+		const CancellationToken*            cancel = nullptr) const;
 
 
-	ExplicitTreeAutCore Complement() const;
+	ExplicitTreeAutCore Complement(
+		const CancellationToken*            cancel = nullptr) const;
+
+
+	/**
+	 * @brief  Bottom-up subset construction
+	 *
+	 * States of the result are sets of states (macrostates) of this
+	 * automaton.  If @p pUpwardSim is not @p nullptr, states upward-simulated
+	 * by other states of the same macrostate are removed from it.
+	 *
+	 * @param[in]  pUpwardSim  Upward simulation on states of the automaton
+	 *                         (optional)
+	 *
+	 * @returns  A deterministic automaton with the same language
+	 */
+	ExplicitTreeAutCore Determinize(
+		const StateDiscontBinaryRelation*     pUpwardSim = nullptr) const;
+
+
+	/**
+	 * @brief  Minimization of a bottom-up deterministic automaton
+	 *
+	 * Useless states are removed first, then the coarsest partition of states
+	 * compatible with the transitions is computed by Hopcroft's partition
+	 * refinement.  A transition @p a(q_1, ..., q_k) -> q yields for every
+	 * position i an edge from @p q_i to @p q labelled by the context (@p a,
+	 * i, and the other children), which reduces the problem to minimization of
+	 * a partial deterministic word automaton.  Blocks of states and cords of
+	 * edges split each other, and only the smaller part of a split set is
+	 * used as a splitter.  No relation on states is computed.  The refinement
+	 * takes O(r * m * log(n)) steps, where n is the number of states, m is the
+	 * number of transitions and r is the maximum rank of symbols.
+	 *
+	 * @returns  The minimal deterministic automaton with the same language
+	 *
+	 * @throws  std::runtime_error  if the automaton is not deterministic
+	 */
+	ExplicitTreeAutCore Minimize() const;
 
 
 	bool IsLangEmpty() const
 	{
-		ExplicitTreeAutCore autTmp = this->RemoveUselessStates();
+		if (incrReach_)
+		{
+			return this->isLangEmptyIncremental();
+		}
 
-		// after removing useless states, we just need to check whether there is
-		// a~final state in the automaton
-		return autTmp.GetFinalStates().empty();
+		// the language is empty iff no final state is reachable bottom-up
+		std::unordered_set<StateType> reachable;
+		return !this->computeBottomUpReachable(reachable, true);
 	}
 
 
@@ -57,13 +57,11 @@ ExplicitTreeAutCore ExplicitTreeAutCore::GetCandidateTree() const
 	std::vector<TransitionInfoPtr> reachableTransitions;
 	std::list<StateType> newStates;
 
-	assert(nullptr != transitions_);
-
 	size_t remaining = 0;
 
 	// Cycle builds information structure about transitions and also
 	// saves the reachable transitions (start states)
-	for (auto& stateClusterPair : *transitions_)
+	for (auto& stateClusterPair : *this->clusterMap())
 	{
 		assert(stateClusterPair.second);
 
@@ -159,6 +157,7 @@ found_:
 	if (!remaining)
 	{
 		result.transitions_ = transitions_;
+		result.frozen_ = frozen_;
 
 		return result.RemoveUnreachableStates();
 	}
@@ -12,7 +12,8 @@
 
 using VATA::ExplicitTreeAutCore;
 
-ExplicitTreeAutCore ExplicitTreeAutCore::Complement() const
+ExplicitTreeAutCore ExplicitTreeAutCore::Complement(
+	const CancellationToken*            cancel) const
 {
 	typedef AutBase::StateType StateType;
 	typedef std::unordered_map<StateType, StateType> StateDict;
@@ -27,9 +28,10 @@ ExplicitTreeAutCore ExplicitTreeAutCore::Complement() const
 	this->BuildStateIndex(stateTranslator);
 
 	return this->ComplementWithPreorder(
-		Util::Identity(stateCnt)
+		Util::Identity(stateCnt),
 		/* ComputeDownwardSimulation(
 			aut, stateDict.size(), Util::TranslatorStrict<StateDict>(stateDict)
 		)*/
+		cancel
 	);
 }
@@ -105,7 +105,7 @@ private:
 		SymbolIndex&                 symbolIndex,
 		const Aut&                   aut)
 	{
-		for (auto& stateClusterPair : *aut.transitions_)
+		for (auto& stateClusterPair : *aut.clusterMap())
 		{
 			assert(stateClusterPair.second);
 
@@ -149,7 +149,8 @@ public:
 		Aut&                               dst,
 		const Aut&                         src,
 		const typename Aut::AlphabetType&  alphabet,
-		const Rel&                         preorder)
+		const Rel&                         preorder,
+		const CancellationToken*           cancel = nullptr)
 	{
 		typedef std::vector<VATA::ExplicitTreeAutCore::StateType> StateSet;
 		typedef typename VATA::Util::Antichain1C<VATA::ExplicitTreeAutCore::StateType> Antichain1C;
@@ -238,6 +239,11 @@ public:
 
 		while (todo.size())
 		{
+			if (nullptr != cancel)
+			{
+				cancel->Poll();
+			}
+
 			const auto P = *todo.begin();
 
 			todo.erase(todo.begin());
@@ -307,6 +313,11 @@ public:
 
 				do
 				{
+					if (nullptr != cancel)
+					{
+						cancel->Poll();
+					}
+
 					// we loop for each choice function
 					for (size_t i = 0; i < choiceFunction.size(); ++i)
 					{
@@ -361,7 +372,8 @@ public:
 template <
 	class Rel>
 VATA::ExplicitTreeAutCore VATA::ExplicitTreeAutCore::ComplementWithPreorder(
-	const Rel&                             preorder) const
+	const Rel&                             preorder,
+	const CancellationToken*               cancel) const
 {
 	ExplicitTreeAutCore res;
 
@@ -369,7 +381,8 @@ VATA::ExplicitTreeAutCore VATA::ExplicitTreeAutCore::ComplementWithPreorder(
 		res,
 		*this,
 		this->GetAlphabet(),
-		preorder);
+		preorder,
+		cancel);
 
 	return res.RemoveUselessStates();
 }
@@ -0,0 +1,325 @@
+/*****************************************************************************
+ *  VATA Tree Automata Library
+ *
+ *  Copyright (c) 2015  Ondra Lengal <ilengal@fit.vutbr.cz>
+ *
+ *  Description:
+ *    Implementation of Determinize() on explicit tree automata.
+ *
+ *****************************************************************************/
+
+// VATA headers
+#include <vata/vata.hh>
+#include <vata/util/transl_weak.hh>
+
+// Standard library headers
+#include <algorithm>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include <boost/functional/hash.hpp>
+
+#include "explicit_tree_aut_core.hh"
+#include "util/expl_bu_index.hh"
+
+using VATA::ExplicitTreeAutCore;
+
+namespace
+{
+	using MacroState = std::vector<StateType>;
+
+	bool contains(const MacroState& macroState, const StateType& state)
+	{
+		return std::binary_search(macroState.begin(), macroState.end(), state);
+	}
+}
+
+
+ExplicitTreeAutCore ExplicitTreeAutCore::Determinize(
+	const StateDiscontBinaryRelation*     pUpwardSim) const
+{
+	// symbols are not translated
+	std::unordered_map<SymbolType, size_t> symbolMap;
+	Util::TranslatorWeak2<std::unordered_map<SymbolType, size_t>>
+		symbolTranslator(symbolMap, [](const SymbolType& sym){ return sym; });
+
+	// symbol -> position -> state -> transitions
+	SymbolToDoubleIndexedTransitionListMap index;
+	SymbolToTransitionListMap leaves;
+	bottomUpIndex2(*this, index, leaves, symbolTranslator);
+
+	// for every state the pairs of symbols and positions in which it occurs
+	std::unordered_map<StateType, std::vector<std::pair<SymbolType, size_t>>> occurrences;
+	for (const auto& symbolListPair : index)
+	{
+		for (size_t pos = 0; pos < symbolListPair.second.size(); ++pos)
+		{
+			const IndexedTransitionList& stateLists = symbolListPair.second[pos];
+			for (StateType state = 0; state < stateLists.size(); ++state)
+			{
+				if (!stateLists[state].empty())
+				{
+					occurrences[state].push_back(std::make_pair(symbolListPair.first, pos));
+				}
+			}
+		}
+	}
+
+	// for every state the states simulating it (upward)
+	std::unordered_map<StateType, std::unordered_set<StateType>> simulatedBy;
+	if (nullptr != pUpwardSim)
+	{
+		StateDiscontBinaryRelation::IndexType simIndex;
+		pUpwardSim->buildIndex(simIndex);
+
+		for (const auto& stateImagesPair : simIndex)
+		{
+			simulatedBy[stateImagesPair.first].insert(
+				stateImagesPair.second.begin(), stateImagesPair.second.end());
+		}
+	}
+
+	// removes states simulated by other states of the macrostate; from every
+	// class of simulation-equivalent states, the smallest one is kept
+	auto pruneF = [&simulatedBy](MacroState& macroState)
+	{
+		if (simulatedBy.empty())
+		{
+			return;
+		}
+
+		auto isSimulatedF = [&simulatedBy](const StateType& lhs, const StateType& rhs)
+		{
+			auto it = simulatedBy.find(lhs);
+			return (simulatedBy.end() != it) && (it->second.end() != it->second.find(rhs));
+		};
+
+		MacroState pruned;
+		for (const StateType& state : macroState)
+		{
+			bool dominated = false;
+			for (const StateType& other : macroState)
+			{
+				if ((other != state) && isSimulatedF(state, other) &&
+					(!isSimulatedF(other, state) || (other < state)))
+				{
+					dominated = true;
+					break;
+				}
+			}
+
+			if (!dominated)
+			{
+				pruned.push_back(state);
+			}
+		}
+
+		macroState = std::move(pruned);
+	};
+
+	ExplicitTreeAutCore res(*this, false, false);
+
+	std::unordered_map<MacroState, StateType, boost::hash<MacroState>> macroStateMap;
+	std::vector<const MacroState*> macroStates;
+
+	// for every symbol and position the macrostates (in the order of their
+	// identifiers) containing a state with a transition over the symbol that
+	// has the state at the position
+	std::unordered_map<SymbolType, std::vector<std::vector<StateType>>> active;
+
+	auto getMacroStateF = [&](MacroState&& macroState) -> StateType
+	{
+		auto insRes = macroStateMap.insert(
+			std::make_pair(std::move(macroState), macroStates.size()));
+		if (!insRes.second)
+		{
+			return insRes.first->second;
+		}
+
+		const StateType id = insRes.first->second;
+		const MacroState& inserted = insRes.first->first;
+		macroStates.push_back(&inserted);
+
+		for (const StateType& state : inserted)
+		{
+			if (this->IsStateFinal(state))
+			{
+				res.SetStateFinal(id);
+			}
+
+			auto occIt = occurrences.find(state);
+			if (occurrences.end() == occIt)
+			{
+				continue;
+			}
+
+			for (const auto& symbolPosPair : occIt->second)
+			{
+				std::vector<std::vector<StateType>>& symbolActive = active[symbolPosPair.first];
+				if (symbolActive.empty())
+				{
+					symbolActive.resize(index.at(symbolPosPair.first).size());
+				}
+
+				std::vector<StateType>& ids = symbolActive[symbolPosPair.second];
+				if (ids.empty() || (ids.back() != id))
+				{
+					ids.push_back(id);
+				}
+			}
+		}
+
+		return id;
+	};
+
+	// first, process leaves
+	for (const auto& symbolListPair : leaves)
+	{
+		MacroState macroState;
+		for (const TransitionPtr& trans : symbolListPair.second)
+		{
+			macroState.push_back(trans->state());
+		}
+
+		std::sort(macroState.begin(), macroState.end());
+		macroState.erase(std::unique(macroState.begin(), macroState.end()), macroState.end());
+		pruneF(macroState);
+
+		StateType parent = getMacroStateF(std::move(macroState));
+		res.AddTransition(StateTuple(), symbolListPair.first, parent);
+	}
+
+	// then, process macrostates in the order of their creation; tuples of
+	// macrostates are enumerated when their largest component is processed
+	for (StateType current = 0; current < macroStates.size(); ++current)
+	{
+		std::unordered_set<SymbolType> symbols;
+		for (const StateType& state : *macroStates[current])
+		{
+			auto occIt = occurrences.find(state);
+			if (occurrences.end() != occIt)
+			{
+				for (const auto& symbolPosPair : occIt->second)
+				{
+					symbols.insert(symbolPosPair.first);
+				}
+			}
+		}
+
+		for (const SymbolType& symbol : symbols)
+		{
+			const DoubleIndexedTransitionList& symbolIndex = index.at(symbol);
+			const std::vector<std::vector<StateType>>& symbolActive = active.at(symbol);
+			const size_t arity = symbolIndex.size();
+
+			// the active macrostates not larger than 'current' for every position
+			std::vector<std::vector<StateType>> candidates(arity);
+			for (size_t pos = 0; pos < arity; ++pos)
+			{
+				const std::vector<StateType>& ids = symbolActive[pos];
+				candidates[pos].assign(ids.begin(),
+					std::upper_bound(ids.begin(), ids.end(), current));
+			}
+
+			for (size_t fixedPos = 0; fixedPos < arity; ++fixedPos)
+			{	// 'current' is the first occurrence of 'current' in the tuple
+				if (candidates[fixedPos].empty() || (candidates[fixedPos].back() != current))
+				{
+					continue;
+				}
+
+				std::vector<std::vector<StateType>> ranges(arity);
+				bool emptyRange = false;
+				for (size_t pos = 0; pos < arity; ++pos)
+				{
+					if (pos < fixedPos)
+					{
+						ranges[pos].assign(candidates[pos].begin(),
+							std::lower_bound(candidates[pos].begin(), candidates[pos].end(), current));
+					}
+					else if (pos == fixedPos)
+					{
+						ranges[pos].push_back(current);
+					}
+					else
+					{
+						ranges[pos] = candidates[pos];
+					}
+
+					emptyRange = emptyRange || ranges[pos].empty();
+				}
+
+				if (emptyRange)
+				{
+					continue;
+				}
+
+				std::vector<size_t> indices(arity, 0);
+				StateTuple children(arity);
+				while (true)
+				{
+					for (size_t pos = 0; pos < arity; ++pos)
+					{
+						children[pos] = ranges[pos][indices[pos]];
+					}
+
+					// collect parents of transitions with children in the macrostates
+					MacroState parents;
+					const IndexedTransitionList& fixedLists = symbolIndex[fixedPos];
+					for (const StateType& state : *macroStates[current])
+					{
+						if (fixedLists.size() <= state)
+						{
+							continue;
+						}
+
+						for (const TransitionPtr& trans : fixedLists[state])
+						{
+							const StateTuple& transChildren = trans->children();
+							bool matches = true;
+							for (size_t pos = 0; pos < arity; ++pos)
+							{
+								if ((pos != fixedPos) &&
+									!contains(*macroStates[children[pos]], transChildren[pos]))
+								{
+									matches = false;
+									break;
+								}
+							}
+
+							if (matches)
+							{
+								parents.push_back(trans->state());
+							}
+						}
+					}
+
+					if (!parents.empty())
+					{
+						std::sort(parents.begin(), parents.end());
+						parents.erase(std::unique(parents.begin(), parents.end()), parents.end());
+						pruneF(parents);
+
+						StateType parent = getMacroStateF(std::move(parents));
+						res.AddTransition(children, symbol, parent);
+					}
+
+					size_t pos = 0;
+					while ((pos < arity) && (++indices[pos] == ranges[pos].size()))
+					{
+						indices[pos] = 0;
+						++pos;
+					}
+
+					if (arity == pos)
+					{
+						break;
+					}
+				}
+			}
+		}
+	}
+
+	return res;
+}
@@ -0,0 +1,695 @@
+/*****************************************************************************
+ *  VATA Tree Automata Library
+ *
+ *  Copyright (c) 2015  Ondra Lengal <ilengal@fit.vutbr.cz>
+ *
+ *  Description:
+ *    Implementation of upward equivalence and congruence-based inclusion
+ *    checking of explicit tree automata.
+ *
+ *****************************************************************************/
+
+// VATA headers
+#include <vata/vata.hh>
+#include <vata/cancellation_token.hh>
+#include <vata/util/transl_weak.hh>
+
+// Standard library headers
+#include <algorithm>
+#include <deque>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include <boost/functional/hash.hpp>
+
+#include "explicit_tree_equiv_up.hh"
+#include "util/expl_bu_index.hh"
+
+using VATA::ExplicitTreeAutCore;
+using VATA::ExplicitUpwardEquivalence;
+using VATA::InclParam;
+
+namespace
+{
+	using MacroState = std::vector<StateType>;
+
+	/// a pair of identifiers of macrostates of the left and the right automaton
+	using MacroStatePair = std::pair<StateType, StateType>;
+
+	bool contains(const MacroState& macroState, const StateType& state)
+	{
+		return std::binary_search(macroState.begin(), macroState.end(), state);
+	}
+
+	bool isSubset(const MacroState& lhs, const MacroState& rhs)
+	{
+		return std::includes(rhs.begin(), rhs.end(), lhs.begin(), lhs.end());
+	}
+
+	void normalize(MacroState& macroState)
+	{
+		std::sort(macroState.begin(), macroState.end());
+		macroState.erase(std::unique(macroState.begin(), macroState.end()),
+			macroState.end());
+	}
+}
+
+
+bool ExplicitUpwardEquivalence::Check(
+	const ExplicitTreeAutCore&            lhs,
+	const ExplicitTreeAutCore&            rhs,
+	InclParam::e_search_order             order,
+	const CancellationToken*              cancel)
+{
+	return ExplicitUpwardEquivalence::explore(lhs, rhs, order, cancel, false);
+}
+
+
+bool ExplicitUpwardEquivalence::CheckInclusion(
+	const ExplicitTreeAutCore&            smaller,
+	const ExplicitTreeAutCore&            bigger,
+	InclParam::e_search_order             order,
+	const CancellationToken*              cancel,
+	ExplicitTreeAutCore*                  counterexample)
+{
+	return ExplicitUpwardEquivalence::explore(smaller, bigger, order, cancel,
+		true, counterexample);
+}
+
+
+bool ExplicitUpwardEquivalence::explore(
+	const ExplicitTreeAutCore&            lhs,
+	const ExplicitTreeAutCore&            rhs,
+	InclParam::e_search_order             order,
+	const CancellationToken*              cancel,
+	bool                                  inclusion,
+	ExplicitTreeAutCore*                  counterexample)
+{
+	using SymbolType = ExplicitTreeAutCore::SymbolType;
+
+	// symbols are numbered (the numbering is used by counterexamples)
+	std::unordered_map<SymbolType, size_t> symbolMap;
+	size_t symbolCnt = 0;
+	Util::TranslatorWeak2<std::unordered_map<SymbolType, size_t>>
+		symbolTranslator(symbolMap, [&symbolCnt](const SymbolType&){ return symbolCnt++; });
+
+	// symbol -> position -> state -> transitions, for both automata; a state
+	// is in macrostates of one side only if the automata are disjoint, so the
+	// transitions of the other automaton do not fire
+	SymbolToDoubleIndexedTransitionListMap index;
+	SymbolToTransitionListMap lhsLeaves;
+	SymbolToTransitionListMap rhsLeaves;
+	bottomUpIndex2(lhs, index, lhsLeaves, symbolTranslator);
+	bottomUpIndex2(rhs, index, rhsLeaves, symbolTranslator);
+
+	// for every state the pairs of symbols and positions in which it occurs
+	std::unordered_map<StateType, std::vector<std::pair<SymbolType, size_t>>> occurrences;
+	for (const auto& symbolListPair : index)
+	{
+		for (size_t pos = 0; pos < symbolListPair.second.size(); ++pos)
+		{
+			const IndexedTransitionList& stateLists = symbolListPair.second[pos];
+			for (StateType state = 0; state < stateLists.size(); ++state)
+			{
+				if (!stateLists[state].empty())
+				{
+					occurrences[state].push_back(std::make_pair(symbolListPair.first, pos));
+				}
+			}
+		}
+	}
+
+	std::unordered_map<MacroState, StateType, boost::hash<MacroState>> macroStateMap;
+	std::vector<const MacroState*> macroStates;
+
+	auto getMacroStateF = [&macroStateMap, &macroStates](const MacroState& macroState)
+	{
+		auto it = macroStateMap.find(macroState);
+		if (macroStateMap.end() != it)
+		{
+			return it->second;
+		}
+
+		it = macroStateMap.insert(std::make_pair(macroState, macroStates.size())).first;
+		macroStates.push_back(&it->first);
+
+		return it->second;
+	};
+
+	// the explored relation, in the order of discovery
+	std::vector<MacroStatePair> pairs;
+
+	// the trees reaching the pairs of the relation (if a counterexample is
+	// requested)
+	std::vector<WitnessNodePtr> trees;
+	std::unordered_set<MacroStatePair, boost::hash<MacroStatePair>> pairSet;
+
+	// pairs of the relation that became unions of other (not dropped) pairs;
+	// they are not combined with other pairs any more
+	std::vector<bool> dropped;
+
+	// pairs found to be unions of pairs of the relation
+	std::unordered_set<MacroStatePair, boost::hash<MacroStatePair>> coveredSet;
+
+	// for inclusion, the normal forms of right macrostates (by identifiers)
+	// together with the number of pairs of the relation they were computed
+	// from; a normal form does not change by dropping pairs, since the left
+	// macrostate of a dropped pair is included in the left macrostates of
+	// the pairs covering it
+	std::unordered_map<StateType, std::pair<MacroState, size_t>> normalForms;
+
+	// for inclusion, the union of the left macrostates of the pairs (but
+	// 'exclude') with the right macrostate included in 'right'
+	auto normalFormF = [&pairs, &dropped, &macroStates](
+		const MacroState&      right,
+		size_t                 begin,
+		size_t                 exclude,
+		MacroState&            normalForm)
+	{
+		for (size_t i = begin; i < pairs.size(); ++i)
+		{
+			if ((exclude == i) || ((exclude < pairs.size()) && dropped[i]))
+			{	// when checking whether a pair is to be dropped, the pairs dropped
+				// before are skipped, since they may be covered by the pair
+				continue;
+			}
+
+			const MacroStatePair& macroStatePair = pairs[i];
+			if (isSubset(*macroStates[macroStatePair.second], right))
+			{
+				const MacroState& pairLeft = *macroStates[macroStatePair.first];
+				normalForm.insert(normalForm.end(), pairLeft.begin(), pairLeft.end());
+			}
+		}
+
+		normalize(normalForm);
+	};
+
+	// the relation contains a pair if its components are unions of components
+	// of some of its pairs, i.e., of all its pairs below the pair; for
+	// inclusion, it also contains pairs with a smaller left or a bigger right
+	// macrostate
+	auto isCoveredF = [&](
+		const MacroState&      left,
+		const MacroState&      right,
+		size_t                 exclude)
+	{
+		if (inclusion)
+		{
+			MacroState normalForm;
+			normalFormF(right, 0, exclude, normalForm);
+			return isSubset(left, normalForm);
+		}
+
+		std::unordered_set<StateType> coveredLeft;
+		std::unordered_set<StateType> coveredRight;
+		for (size_t i = 0; i < pairs.size(); ++i)
+		{
+			if (dropped[i] || (exclude == i))
+			{
+				continue;
+			}
+
+			const MacroStatePair& macroStatePair = pairs[i];
+			const MacroState& pairLeft = *macroStates[macroStatePair.first];
+			const MacroState& pairRight = *macroStates[macroStatePair.second];
+			if (!isSubset(pairLeft, left) || !isSubset(pairRight, right))
+			{
+				continue;
+			}
+
+			coveredLeft.insert(pairLeft.begin(), pairLeft.end());
+			coveredRight.insert(pairRight.begin(), pairRight.end());
+			if ((coveredLeft.size() == left.size()) &&
+				(coveredRight.size() == right.size()))
+			{
+				return true;
+			}
+		}
+
+		return false;
+	};
+
+	auto isAcceptingF = [](
+		const ExplicitTreeAutCore&       aut,
+		const MacroState&                macroState)
+	{
+		for (const StateType& state : macroState)
+		{
+			if (aut.IsStateFinal(state))
+			{
+				return true;
+			}
+		}
+
+		return false;
+	};
+
+	std::deque<size_t> workset;
+
+	// the processed pairs (identifiers in 'pairs') in the order of processing
+	std::vector<size_t> processed;
+
+	// the tree with the symbol at the root and the trees of the processed pairs
+	// in 'tuple' (if not @p nullptr) as its subtrees
+	auto makeTreeF = [&trees, &processed](
+		const SymbolType&                 symbol,
+		const std::vector<size_t>*        tuple)
+	{
+		std::shared_ptr<WitnessNode> node(new WitnessNode(symbol));
+		if (nullptr != tuple)
+		{
+			for (size_t processedIndex : *tuple)
+			{
+				assert(processed[processedIndex] < trees.size());
+				node->children.push_back(trees[processed[processedIndex]]);
+			}
+		}
+
+		return WitnessNodePtr(node);
+	};
+
+	// adds the pair of macrostates reached by the tree of 'symbol' over the
+	// pairs in 'tuple' to the relation; returns @p false (and sets the
+	// counterexample) if exactly one of them is accepting
+	auto addPairF = [&](
+		const MacroState&                 left,
+		const MacroState&                 right,
+		const SymbolType&                 symbol,
+		const std::vector<size_t>*        tuple)
+	{
+		if (left.empty() && (inclusion || right.empty()))
+		{	// the tree is not in the left language, nor are trees above it
+			return true;
+		}
+
+		MacroStatePair macroStatePair(
+			getMacroStateF(left), getMacroStateF(right));
+		if (pairSet.end() != pairSet.find(macroStatePair))
+		{
+			return true;
+		}
+
+		if (coveredSet.end() != coveredSet.find(macroStatePair))
+		{
+			return true;
+		}
+
+		const MacroState& pairLeft = *macroStates[macroStatePair.first];
+		const MacroState& pairRight = *macroStates[macroStatePair.second];
+		if (inclusion)
+		{	// the cached normal form is extended by the pairs found since it was
+			// last used
+			auto& normalFormCountPair = normalForms[macroStatePair.second];
+			normalFormF(pairRight, normalFormCountPair.second, pairs.size(),
+				normalFormCountPair.first);
+			normalFormCountPair.second = pairs.size();
+			if (isSubset(pairLeft, normalFormCountPair.first))
+			{
+				coveredSet.insert(macroStatePair);
+				return true;
+			}
+
+			if (isAcceptingF(lhs, pairLeft) && !isAcceptingF(rhs, pairRight))
+			{
+				if (nullptr != counterexample)
+				{
+					ExplicitUpwardInclusion::AddCounterexample(
+						*makeTreeF(symbol, tuple), symbolMap, *counterexample);
+				}
+
+				return false;
+			}
+		}
+		else
+		{
+			if (isCoveredF(pairLeft, pairRight, pairs.size()))
+			{	// unions of the relation do not change by dropping pairs, so the
+				// pair stays covered
+				coveredSet.insert(macroStatePair);
+				return true;
+			}
+
+			if (isAcceptingF(lhs, pairLeft) != isAcceptingF(rhs, pairRight))
+			{
+				return false;
+			}
+		}
+
+		const size_t pairId = pairs.size();
+		workset.push_back(pairId);
+		pairs.push_back(macroStatePair);
+		if (nullptr != counterexample)
+		{
+			trees.push_back(makeTreeF(symbol, tuple));
+		}
+		dropped.push_back(false);
+		pairSet.insert(macroStatePair);
+
+		// pairs above the new pair may have become unions of other pairs
+		for (size_t i = 0; i < pairId; ++i)
+		{
+			const MacroState& otherLeft = *macroStates[pairs[i].first];
+			const MacroState& otherRight = *macroStates[pairs[i].second];
+			if (dropped[i] || !isSubset(pairRight, otherRight))
+			{
+				continue;
+			}
+
+			if (inclusion)
+			{	// only pairs sharing a left state with the new pair may be covered
+				// by it
+				if (!std::any_of(pairLeft.begin(), pairLeft.end(),
+					[&otherLeft](const StateType& state){ return contains(otherLeft, state); }))
+				{
+					continue;
+				}
+			}
+			else if (!isSubset(pairLeft, otherLeft))
+			{
+				continue;
+			}
+
+			if (isCoveredF(otherLeft, otherRight, i))
+			{
+				dropped[i] = true;
+			}
+		}
+
+		return true;
+	};
+
+	// first, process leaves
+	std::unordered_set<SymbolType> leafSymbols;
+	for (const auto& symbolListPair : lhsLeaves)
+	{
+		leafSymbols.insert(symbolListPair.first);
+	}
+
+	for (const auto& symbolListPair : rhsLeaves)
+	{
+		leafSymbols.insert(symbolListPair.first);
+	}
+
+	auto leafTargetsF = [](
+		const SymbolToTransitionListMap&      leaves,
+		const SymbolType&                     symbol)
+	{
+		MacroState macroState;
+		auto it = leaves.find(symbol);
+		if (leaves.end() != it)
+		{
+			for (const TransitionPtr& trans : it->second)
+			{
+				macroState.push_back(trans->state());
+			}
+		}
+
+		normalize(macroState);
+		return macroState;
+	};
+
+	for (const SymbolType& symbol : leafSymbols)
+	{
+		if (!addPairF(leafTargetsF(lhsLeaves, symbol), leafTargetsF(rhsLeaves, symbol),
+			symbol, nullptr))
+		{
+			return false;
+		}
+	}
+
+	// for every symbol and position the processed pairs (indices to
+	// 'processed') containing a state with a transition over the symbol that
+	// has the state at the position
+	std::unordered_map<SymbolType, std::vector<std::vector<size_t>>> active;
+
+	// then, process the pairs; tuples of pairs are enumerated when their
+	// last processed component is processed
+	while (!workset.empty())
+	{
+		size_t pairId;
+		if (InclParam::e_search_order::breadth == order)
+		{
+			pairId = workset.front();
+			workset.pop_front();
+		}
+		else
+		{
+			pairId = workset.back();
+			workset.pop_back();
+		}
+
+		if (nullptr != cancel)
+		{
+			cancel->Poll();
+		}
+
+		if (dropped[pairId])
+		{
+			continue;
+		}
+
+		const MacroState& currentLeft = *macroStates[pairs[pairId].first];
+		const MacroState& currentRight = *macroStates[pairs[pairId].second];
+
+		const size_t current = processed.size();
+		processed.push_back(pairId);
+
+		std::unordered_set<SymbolType> symbols;
+		for (const MacroState* macroState : {&currentLeft, &currentRight})
+		{
+			for (const StateType& state : *macroState)
+			{
+				auto occIt = occurrences.find(state);
+				if (occurrences.end() == occIt)
+				{
+					continue;
+				}
+
+				for (const auto& symbolPosPair : occIt->second)
+				{
+					symbols.insert(symbolPosPair.first);
+
+					std::vector<std::vector<size_t>>& symbolActive = active[symbolPosPair.first];
+					if (symbolActive.empty())
+					{
+						symbolActive.resize(index.at(symbolPosPair.first).size());
+					}
+
+					std::vector<size_t>& ids = symbolActive[symbolPosPair.second];
+					if (ids.empty() || (ids.back() != current))
+					{
+						ids.push_back(current);
+					}
+				}
+			}
+		}
+
+		for (const SymbolType& symbol : symbols)
+		{
+			const DoubleIndexedTransitionList& symbolIndex = index.at(symbol);
+			const std::vector<std::vector<size_t>>& symbolActive = active.at(symbol);
+			const size_t arity = symbolIndex.size();
+
+			for (size_t fixedPos = 0; fixedPos < arity; ++fixedPos)
+			{	// 'current' is the first occurrence of 'current' in the tuple
+				if (symbolActive[fixedPos].empty() ||
+					(symbolActive[fixedPos].back() != current))
+				{
+					continue;
+				}
+
+				const IndexedTransitionList& fixedLists = symbolIndex[fixedPos];
+
+				// the position of the children by which transitions are looked up
+				const size_t keyPos = (0 == fixedPos)? 1 : 0;
+
+				// for either side, the transitions with a state of 'current' at the
+				// fixed position, sorted by their child at 'keyPos' (for unary
+				// symbols, the key is 0), and their children at every position
+				std::vector<std::pair<StateType, const Transition*>> keyed[2];
+				std::vector<std::unordered_set<StateType>> children(arity);
+				const MacroState* currentSides[2] = {&currentLeft, &currentRight};
+				for (size_t side = 0; side < 2; ++side)
+				{
+					for (const StateType& state : *currentSides[side])
+					{
+						if (fixedLists.size() <= state)
+						{
+							continue;
+						}
+
+						for (const TransitionPtr& trans : fixedLists[state])
+						{
+							const StateTuple& transChildren = trans->children();
+							keyed[side].push_back(std::make_pair(
+								(1 == arity)? 0 : transChildren[keyPos], trans.get()));
+
+							for (size_t pos = 0; pos < arity; ++pos)
+							{
+								children[pos].insert(transChildren[pos]);
+							}
+						}
+					}
+
+					std::sort(keyed[side].begin(), keyed[side].end());
+				}
+
+				// the macrostate at a position of a tuple of processed pairs
+				auto macroStateF = [&](
+					const std::vector<size_t>&        tuple,
+					size_t                            pos,
+					size_t                            side) -> const MacroState&
+				{
+					const MacroStatePair& macroStatePair = pairs[processed[tuple[pos]]];
+					return *macroStates[(0 == side)? macroStatePair.first : macroStatePair.second];
+				};
+
+				// only pairs containing a child of the transitions need to be combined
+				auto isRelevantF = [&](size_t processedIndex, size_t pos)
+				{
+					const std::vector<size_t> tuple(arity, processedIndex);
+					for (size_t side = 0; side < 2; ++side)
+					{
+						for (const StateType& state : macroStateF(tuple, pos, side))
+						{
+							if (children[pos].end() != children[pos].find(state))
+							{
+								return true;
+							}
+						}
+					}
+
+					return false;
+				};
+
+				std::vector<std::vector<size_t>> ranges(arity);
+				bool emptyRange = false;
+				for (size_t pos = 0; pos < arity; ++pos)
+				{
+					if (pos == fixedPos)
+					{
+						ranges[pos].push_back(current);
+						continue;
+					}
+
+					for (size_t processedIndex : symbolActive[pos])
+					{
+						if (((pos > fixedPos) || (processedIndex < current)) &&
+							!dropped[processed[processedIndex]] &&
+							isRelevantF(processedIndex, pos))
+						{
+							ranges[pos].push_back(processedIndex);
+						}
+					}
+
+					if (ranges[pos].empty())
+					{
+						emptyRange = true;
+						break;
+					}
+				}
+
+				if (emptyRange)
+				{
+					continue;
+				}
+
+				const MacroState unaryKey(1, 0);
+
+				// collects parents of transitions with children in the left or the
+				// right macrostates of the tuple
+				auto parentsF = [&](
+					const std::vector<size_t>&        tuple,
+					size_t                            side,
+					MacroState&                       parents)
+				{
+					parents.clear();
+
+					// the transitions are joined with the macrostate at 'keyPos'
+					const MacroState& keyMacroState = (1 == arity)?
+						unaryKey : macroStateF(tuple, keyPos, side);
+					auto keyLessF = [](
+						const std::pair<StateType, const Transition*>&    keyTransPair,
+						const StateType&                                  key)
+					{
+						return keyTransPair.first < key;
+					};
+
+					auto transIt = keyed[side].cbegin();
+					for (const StateType& key : keyMacroState)
+					{
+						transIt = std::lower_bound(transIt, keyed[side].cend(), key, keyLessF);
+						for ( ; (keyed[side].cend() != transIt) && (transIt->first == key); ++transIt)
+						{
+							const StateTuple& transChildren = transIt->second->children();
+							bool matches = true;
+							for (size_t pos = 0; pos < arity; ++pos)
+							{
+								if ((pos != fixedPos) && (pos != keyPos) &&
+									!contains(macroStateF(tuple, pos, side), transChildren[pos]))
+								{
+									matches = false;
+									break;
+								}
+							}
+
+							if (matches)
+							{
+								parents.push_back(transIt->second->state());
+							}
+						}
+
+						if (keyed[side].cend() == transIt)
+						{
+							break;
+						}
+					}
+
+					normalize(parents);
+				};
+
+				MacroState leftParents;
+				MacroState rightParents;
+
+				std::vector<size_t> indices(arity, 0);
+				std::vector<size_t> tuple(arity);
+				while (true)
+				{
+					for (size_t pos = 0; pos < arity; ++pos)
+					{
+						tuple[pos] = ranges[pos][indices[pos]];
+					}
+
+					if (nullptr != cancel)
+					{
+						cancel->Poll();
+					}
+
+					parentsF(tuple, 0, leftParents);
+					parentsF(tuple, 1, rightParents);
+					if (!addPairF(leftParents, rightParents, symbol, &tuple))
+					{
+						return false;
+					}
+
+					size_t pos = 0;
+					while ((pos < arity) && (++indices[pos] == ranges[pos].size()))
+					{
+						indices[pos] = 0;
+						++pos;
+					}
+
+					if (arity == pos)
+					{
+						break;
+					}
+				}
+			}
+		}
+	}
+
+	return true;
+}
@@ -0,0 +1,125 @@
+/*****************************************************************************
+ *  VATA Tree Automata Library
+ *
+ *  Copyright (c) 2015  Ondra Lengal <ilengal@fit.vutbr.cz>
+ *
+ *  Description:
+ *    Upward equivalence and congruence-based inclusion checking for
+ *    explicitly represented tree automata.
+ *
+ *****************************************************************************/
+
+#ifndef _VATA_EXPLICIT_TREE_EQUIV_UP_HH_
+#define _VATA_EXPLICIT_TREE_EQUIV_UP_HH_
+
+#include <vata/incl_param.hh>
+
+#include "explicit_tree_aut_core.hh"
+#include "explicit_tree_incl_up.hh"
+
+namespace VATA { class ExplicitUpwardEquivalence; }
+
+
+/**
+ * @brief  One-pass upward equivalence checking
+ *
+ * The check explores pairs of macrostates (X, Y) such that X and Y are the
+ * sets of states that a tree reaches in the left and the right automaton
+ * respectively, and fails once it finds a pair where exactly one of the
+ * macrostates contains a final state.  Both directions of the equivalence
+ * are thus checked by a single exploration, instead of two inclusion checks.
+ *
+ * The explored relation is a bisimulation up to union: a pair whose
+ * components are unions of the components of other pairs of the relation is
+ * not explored, and a pair that becomes such a union later is no longer
+ * combined with other pairs.  (Since the successors of a tuple of pairs are
+ * computed component-wise, unions of pairs are closed under successors.
+ * Closing the relation under transitivity, as is done for finite automata, is
+ * not sound for symbols of arity greater than one, where the successors mix
+ * components of different pairs.)  Inclusion is checked by the same
+ * exploration, see CheckInclusion().
+ */
+class VATA::ExplicitUpwardEquivalence
+{
+public:
+
+	/**
+	 * @brief  Checks language equivalence of two automata
+	 *
+	 * The automata may share states, but then every transition of either
+	 * automaton whose children are states of the other automaton needs to
+	 * be a transition of the other automaton as well.
+	 *
+	 * @param[in]  lhs     The left automaton
+	 * @param[in]  rhs     The right automaton
+	 * @param[in]  order   The order in which pairs of macrostates are explored
+	 * @param[in]  cancel  A token cancelling the check (may be @p nullptr)
+	 *
+	 * @returns  @p true if the languages of @p lhs and @p rhs are equal,
+	 *           @p false otherwise
+	 */
+	static bool Check(
+		const ExplicitTreeAutCore&            lhs,
+		const ExplicitTreeAutCore&            rhs,
+		InclParam::e_search_order             order,
+		const CancellationToken*              cancel = nullptr);
+
+	/**
+	 * @brief  Checks language inclusion of two automata
+	 *
+	 * The explored pairs (X, Y) are those of the equivalence check, where X
+	 * and Y are sets of states of @p smaller and @p bigger respectively, and
+	 * the check fails once X contains a final state and Y does not.  The
+	 * relation is a simulation up to union and weakening: (X, Y) is not
+	 * explored if X is included in the normal form of Y, i.e., in the union
+	 * of X' over the pairs (X', Y') of the relation with Y' included in Y.
+	 * The normal form of every explored Y is cached and extended only by the
+	 * pairs found since it was last used (this corresponds to the rewriting of
+	 * the bigger macrostate in the congruence algorithm for finite automata).
+	 *
+	 * Every explored pair is reached by a tree built from the trees of the
+	 * pairs it was computed from, so if a counterexample is requested, the
+	 * trees are recorded for the pairs of the relation and the tree of the
+	 * failing pair is the counterexample.
+	 *
+	 * @param[in]  smaller  The smaller automaton
+	 * @param[in]  bigger   The bigger automaton (with states disjoint from the
+	 *                      states of @p smaller)
+	 * @param[in]  order    The order in which pairs of macrostates are explored
+	 * @param[in]  cancel   A token cancelling the check (may be @p nullptr)
+	 * @param[out] counterexample  If not @p nullptr and the inclusion does not
+	 *                      hold, a tree of @p smaller that is not accepted by
+	 *                      @p bigger is added to it
+	 *
+	 * @returns  @p true if the language of @p smaller is included in the
+	 *           language of @p bigger, @p false otherwise
+	 */
+	static bool CheckInclusion(
+		const ExplicitTreeAutCore&            smaller,
+		const ExplicitTreeAutCore&            bigger,
+		InclParam::e_search_order             order,
+		const CancellationToken*              cancel = nullptr,
+		ExplicitTreeAutCore*                  counterexample = nullptr);
+
+private:
+
+	using WitnessNode    = ExplicitUpwardInclusion::WitnessNode;
+	using WitnessNodePtr = ExplicitUpwardInclusion::WitnessNodePtr;
+
+	/**
+	 * @brief  Explores pairs of macrostates of @p lhs and @p rhs
+	 *
+	 * @p inclusion selects between the equivalence and the inclusion check.
+	 * If @p counterexample is not @p nullptr and the check fails, it is added
+	 * the tree reaching the failing pair.
+	 */
+	static bool explore(
+		const ExplicitTreeAutCore&            lhs,
+		const ExplicitTreeAutCore&            rhs,
+		InclParam::e_search_order             order,
+		const CancellationToken*              cancel,
+		bool                                  inclusion,
+		ExplicitTreeAutCore*                  counterexample = nullptr);
+};
+
+#endif
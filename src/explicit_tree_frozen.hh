@@ -0,0 +1,363 @@
+/*****************************************************************************
+ *  VATA Tree Automata Library
+ *
+ *  Copyright (c) 2015  Ondra Lengal <ilengal@fit.vutbr.cz>
+ *
+ *  Description:
+ *    Compact read-only (frozen) storage of transitions of an explicitly
+ *    represented tree automaton.
+ *
+ *****************************************************************************/
+
+#ifndef _VATA_EXPLICIT_TREE_FROZEN_HH_
+#define _VATA_EXPLICIT_TREE_FROZEN_HH_
+
+// Standard library headers
+#include <algorithm>
+#include <limits>
+#include <unordered_map>
+#include <vector>
+
+// VATA headers
+#include <vata/explicit_tree_aut.hh>
+
+#include "util/arena.hh"
+
+
+namespace VATA
+{
+	namespace ExplicitTreeAutCoreUtil
+	{
+		class FrozenTransitions;
+	}
+}
+
+
+/**
+ * @brief  Compact read-only storage of transitions
+ *
+ * The transitions are stored in a compressed sparse row (CSR) layout: parent
+ * states are kept in a sorted array, every parent owns a contiguous (sorted)
+ * range of symbols, and every (parent, symbol) pair owns a contiguous range of
+ * tuple identifiers.  Tuples are not copied: every distinct tuple is kept
+ * once, as the handle of the tuple interned in the arena of the automaton, and
+ * it is identified by its index.
+ *
+ * All the parts are addressed by indices (and not by iterators) so that
+ * algorithms can traverse the structure using plain integer loops, e.g.
+ *
+ * @code
+ *   for (size_t p = 0; p < frozen.ParentCount(); ++p)
+ *     for (size_t s = frozen.SymbolsBegin(p); s < frozen.SymbolsEnd(p); ++s)
+ *       for (size_t t = frozen.TuplesBegin(s); t < frozen.TuplesEnd(s); ++t)
+ *         f(frozen.GetParent(p), frozen.GetSymbol(s), frozen.GetTuple(t));
+ * @endcode
+ */
+class VATA::ExplicitTreeAutCoreUtil::FrozenTransitions
+{
+public:   // data types
+
+	using StateType      = ExplicitTreeAut::StateType;
+	using SymbolType     = ExplicitTreeAut::SymbolType;
+	using StateTuple     = ExplicitTreeAut::StateTuple;
+	using TuplePtr       = Util::Arena<StateTuple>::Ptr;
+
+	/**
+	 * @brief  A light-weight view of a tuple stored inside the structure
+	 */
+	class TupleRef
+	{
+	private:  // data members
+
+		const StateType* begin_;
+		const StateType* end_;
+
+	public:   // methods
+
+		TupleRef(
+			const StateType*        begin,
+			const StateType*        end) :
+			begin_(begin),
+			end_(end)
+		{ }
+
+		const StateType* begin() const { return begin_; }
+		const StateType* end() const { return end_; }
+
+		size_t size() const { return end_ - begin_; }
+		bool empty() const { return begin_ == end_; }
+
+		const StateType& operator[](size_t i) const
+		{
+			assert(i < this->size());
+			return begin_[i];
+		}
+	};
+
+	/// value returned by lookup methods when the item is not present
+	static const size_t NotFound = std::numeric_limits<size_t>::max();
+
+private:  // data members
+
+	/// sorted parent states
+	std::vector<StateType> parents_;
+
+	/// for every parent the beginning of its range in @p symbols_
+	std::vector<size_t> parentOffsets_;
+
+	/// symbols (sorted within the range of every parent)
+	std::vector<SymbolType> symbols_;
+
+	/// for every symbol entry the beginning of its range in @p tupleIds_
+	std::vector<size_t> symbolOffsets_;
+
+	/// identifiers of tuples of transitions
+	std::vector<size_t> tupleIds_;
+
+	/// the distinct tuples (indexed by their identifiers)
+	std::vector<TuplePtr> tuples_;
+
+public:   // methods
+
+	/**
+	 * @brief  Builds the frozen storage from a cluster map
+	 *
+	 * @param[in]  clusterMap  Mapping of parent states to transition clusters
+	 *                         (as used in ExplicitTreeAutCore)
+	 */
+	template <class ClusterMap>
+	explicit FrozenTransitions(
+		const ClusterMap&               clusterMap) :
+		parents_(),
+		parentOffsets_(),
+		symbols_(),
+		symbolOffsets_(),
+		tupleIds_(),
+		tuples_()
+	{
+		using Cluster     = typename ClusterMap::mapped_type::element_type;
+		using TupleSet    = typename Cluster::mapped_type::element_type;
+		using ClusterPtr  = const Cluster*;
+		using TupleSetPtr = const TupleSet*;
+
+		std::vector<std::pair<StateType, ClusterPtr>> clusters;
+		clusters.reserve(clusterMap.size());
+		size_t symbolCnt = 0;
+		for (auto& stateClusterPair : clusterMap)
+		{
+			assert(nullptr != stateClusterPair.second);
+			clusters.push_back(std::make_pair(
+				stateClusterPair.first, stateClusterPair.second.get()));
+			symbolCnt += stateClusterPair.second->size();
+		}
+
+		std::sort(clusters.begin(), clusters.end(),
+			[](const std::pair<StateType, ClusterPtr>& lhs,
+				const std::pair<StateType, ClusterPtr>& rhs)
+			{ return lhs.first < rhs.first; });
+
+		parents_.reserve(clusters.size());
+		parentOffsets_.reserve(clusters.size() + 1);
+		symbols_.reserve(symbolCnt);
+		symbolOffsets_.reserve(symbolCnt + 1);
+
+		// tuples in the cluster map are interned, so we may identify them by
+		// their handles
+		std::unordered_map<TuplePtr, size_t, boost::hash<TuplePtr>> tupleMap;
+		std::vector<std::pair<SymbolType, TupleSetPtr>> symbolSets;
+		std::vector<TuplePtr> tuples;
+
+		for (auto& stateClusterPair : clusters)
+		{
+			parents_.push_back(stateClusterPair.first);
+			parentOffsets_.push_back(symbols_.size());
+
+			symbolSets.clear();
+			for (auto& symbolTupleSetPair : *stateClusterPair.second)
+			{
+				assert(nullptr != symbolTupleSetPair.second);
+				if (!symbolTupleSetPair.second->empty())
+				{
+					symbolSets.push_back(std::make_pair(
+						symbolTupleSetPair.first, symbolTupleSetPair.second.get()));
+				}
+			}
+
+			std::sort(symbolSets.begin(), symbolSets.end(),
+				[](const std::pair<SymbolType, TupleSetPtr>& lhs,
+					const std::pair<SymbolType, TupleSetPtr>& rhs)
+				{ return lhs.first < rhs.first; });
+
+			for (auto& symbolTupleSetPair : symbolSets)
+			{
+				symbols_.push_back(symbolTupleSetPair.first);
+				symbolOffsets_.push_back(tupleIds_.size());
+
+				tuples.assign(
+					symbolTupleSetPair.second->begin(), symbolTupleSetPair.second->end());
+
+				// order tuples by their content to make the layout deterministic
+				std::sort(tuples.begin(), tuples.end(),
+					[](const TuplePtr& lhs, const TuplePtr& rhs)
+					{ return *lhs < *rhs; });
+
+				for (const TuplePtr& tuple : tuples)
+				{
+					assert(nullptr != tuple);
+
+					auto insRes = tupleMap.insert(std::make_pair(tuple, tupleMap.size()));
+					if (insRes.second)
+					{	// a new tuple
+						tuples_.push_back(tuple);
+					}
+
+					tupleIds_.push_back(insRes.first->second);
+				}
+			}
+		}
+
+		parentOffsets_.push_back(symbols_.size());
+		symbolOffsets_.push_back(tupleIds_.size());
+
+		tupleIds_.shrink_to_fit();
+		tuples_.shrink_to_fit();
+	}
+
+	size_t ParentCount() const
+	{
+		return parents_.size();
+	}
+
+	size_t TransitionCount() const
+	{
+		return tupleIds_.size();
+	}
+
+	size_t TupleCount() const
+	{
+		return tuples_.size();
+	}
+
+	const StateType& GetParent(size_t parentIdx) const
+	{
+		assert(parentIdx < parents_.size());
+		return parents_[parentIdx];
+	}
+
+	size_t SymbolsBegin(size_t parentIdx) const
+	{
+		assert(parentIdx + 1 < parentOffsets_.size());
+		return parentOffsets_[parentIdx];
+	}
+
+	size_t SymbolsEnd(size_t parentIdx) const
+	{
+		assert(parentIdx + 1 < parentOffsets_.size());
+		return parentOffsets_[parentIdx + 1];
+	}
+
+	const SymbolType& GetSymbol(size_t symbolIdx) const
+	{
+		assert(symbolIdx < symbols_.size());
+		return symbols_[symbolIdx];
+	}
+
+	size_t TuplesBegin(size_t symbolIdx) const
+	{
+		assert(symbolIdx + 1 < symbolOffsets_.size());
+		return symbolOffsets_[symbolIdx];
+	}
+
+	size_t TuplesEnd(size_t symbolIdx) const
+	{
+		assert(symbolIdx + 1 < symbolOffsets_.size());
+		return symbolOffsets_[symbolIdx + 1];
+	}
+
+	/**
+	 * @brief  Returns the identifier of the tuple of a transition
+	 *
+	 * Equal tuples have equal identifiers.
+	 */
+	size_t GetTupleId(size_t transIdx) const
+	{
+		assert(transIdx < tupleIds_.size());
+		return tupleIds_[transIdx];
+	}
+
+	/**
+	 * @brief  Returns the handle of the interned tuple with an identifier
+	 */
+	const TuplePtr& GetTuplePtrById(size_t tupleId) const
+	{
+		assert(tupleId < tuples_.size());
+		return tuples_[tupleId];
+	}
+
+	TupleRef GetTupleById(size_t tupleId) const
+	{
+		const StateTuple& tuple = *this->GetTuplePtrById(tupleId);
+		return TupleRef(tuple.data(), tuple.data() + tuple.size());
+	}
+
+	TupleRef GetTuple(size_t transIdx) const
+	{
+		return this->GetTupleById(this->GetTupleId(transIdx));
+	}
+
+	/**
+	 * @brief  Finds the index of a parent state
+	 *
+	 * @returns  The index of @p state or @p NotFound
+	 */
+	size_t FindParent(const StateType& state) const
+	{
+		auto it = std::lower_bound(parents_.begin(), parents_.end(), state);
+		if ((parents_.end() == it) || (*it != state))
+		{
+			return NotFound;
+		}
+
+		return it - parents_.begin();
+	}
+
+	/**
+	 * @brief  Finds the index of a symbol in the range of a parent
+	 *
+	 * @returns  The index of @p symbol or @p NotFound
+	 */
+	size_t FindSymbol(size_t parentIdx, const SymbolType& symbol) const
+	{
+		auto first = symbols_.begin() + this->SymbolsBegin(parentIdx);
+		auto last = symbols_.begin() + this->SymbolsEnd(parentIdx);
+		auto it = std::lower_bound(first, last, symbol);
+		if ((last == it) || (*it != symbol))
+		{
+			return NotFound;
+		}
+
+		return it - symbols_.begin();
+	}
+
+	/**
+	 * @brief  Calls @p func for every transition
+	 *
+	 * The functor is called as @p func(parent, symbol, tupleId, tuple).
+	 */
+	template <class Func>
+	void ForeachTransition(Func func) const
+	{
+		for (size_t p = 0; p < parents_.size(); ++p)
+		{
+			for (size_t s = parentOffsets_[p]; s < parentOffsets_[p + 1]; ++s)
+			{
+				for (size_t t = symbolOffsets_[s]; t < symbolOffsets_[s + 1]; ++t)
+				{
+					func(parents_[p], symbols_[s], tupleIds_[t], this->GetTuple(t));
+				}
+			}
+		}
+	}
+};
+
+#endif
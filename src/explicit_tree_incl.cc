@@ -9,9 +9,19 @@
  *****************************************************************************/
 
 // VATA headers
+#include <vata/cancellation_token.hh>
 #include <vata/incl_param.hh>
 
+// Standard library headers
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <vector>
+
 #include "explicit_tree_aut_core.hh"
+#include "explicit_tree_equiv_up.hh"
+#include "explicit_tree_sim_cache.hh"
+#include "util/parallel_worklist.hh"
 #include "explicit_tree_incl_up.hh"
 #include "explicit_tree_incl_down.hh"
 #include "tree_incl_down.hh"
@@ -19,99 +29,442 @@
 #include "down_tree_opt_incl_fctor.hh"
 
 using VATA::ExplicitTreeAutCore;
+using VATA::ExplicitUpwardEquivalence;
 using VATA::ExplicitUpwardInclusion;
 
+namespace
+{
+	/**
+	 * @brief  Prebuilt indices of the smaller automaton
+	 *
+	 * Only the index needed by the algorithm selected by the parameters is
+	 * built.
+	 */
+	class SmallerIndices
+	{
+	public:
+
+		VATA::ExplicitUpwardInclusion::SmallerIndex      up;
+		VATA::ExplicitDownwardInclusion::SmallerIndex    down;
+
+	private:
+
+		SmallerIndices(const SmallerIndices&);
+		SmallerIndices& operator=(const SmallerIndices&);
+
+	public:
+
+		SmallerIndices(
+			const ExplicitTreeAutCore&         smaller,
+			const VATA::InclParam&             params) :
+			up(),
+			down()
+		{
+			using VATA::InclParam;
+
+			if (InclParam::e_algorithm::congruences == params.GetAlgorithm())
+			{	// the congruence algorithm indexes both automata together
+				return;
+			}
+
+			if (InclParam::e_direction::upward == params.GetDirection())
+			{
+				VATA::ExplicitUpwardInclusion::IndexSmaller(smaller, up);
+			}
+			else if (!params.GetUseRecursion())
+			{
+				VATA::ExplicitDownwardInclusion::IndexSmaller(smaller, down);
+			}
+		}
+	};
+
+
+	/**
+	 * @brief  Finds a counterexample to inclusion using upward antichains
+	 *
+	 * Used for the algorithms that do not keep track of the trees they
+	 * explore, once they found that the inclusion does not hold.  The states
+	 * of the automata need to be disjoint.
+	 */
+	void findCounterexample(
+		const ExplicitTreeAutCore&             smaller,
+		const ExplicitTreeAutCore&             bigger,
+		const VATA::InclParam&                 params,
+		ExplicitTreeAutCore&                   counterexample)
+	{
+		VATA::AutBase::StateType states = 0;
+		for (const ExplicitTreeAutCore* aut : {&smaller, &bigger})
+		{
+			for (const VATA::AutBase::StateType& state : aut->GetUsedStates())
+			{
+				states = std::max(states, state + 1);
+			}
+		}
+
+		bool result = ExplicitUpwardInclusion::Check(smaller, bigger,
+			VATA::Util::Identity(states), 1, params.GetCancellationToken(),
+			&counterexample);
+
+		assert(!result);
+		(void)result;
+	}
+
+
+	/**
+	 * @brief  Checks inclusion using a preorder
+	 *
+	 * @p Rel is the type of the preorder, i.e., the identity, or the dense or
+	 * the sparse simulation.  If @p indices is not @p nullptr, it is the
+	 * prebuilt index of @p smaller.  If @p counterexample is not @p nullptr,
+	 * the counterexample (if any) is added to it.
+	 */
+	template <
+		class Rel>
+	bool checkInclusionWithRel(
+		const ExplicitTreeAutCore&             smaller,
+		const ExplicitTreeAutCore&             bigger,
+		const VATA::InclParam&                 params,
+		const Rel&                             rel,
+		const SmallerIndices*                  indices = nullptr,
+		ExplicitTreeAutCore*                   counterexample = nullptr)
+	{
+		using VATA::InclParam;
+
+		bool result;
+
+		switch (params.GetOptions())
+		{
+			case InclParam::ANTICHAINS_UP_NOSIM:
+			case InclParam::ANTICHAINS_UP_SIM:
+			{
+				// the upward algorithm keeps track of the counterexample itself
+				if (nullptr != indices)
+				{
+					return ExplicitUpwardInclusion::Check(indices->up, smaller, bigger, rel,
+						params.GetNumThreads(), params.GetCancellationToken(), counterexample);
+				}
+
+				return ExplicitUpwardInclusion::Check(smaller, bigger, rel,
+					params.GetNumThreads(), params.GetCancellationToken(), counterexample);
+			}
+
+			case InclParam::ANTICHAINS_DOWN_NONREC_NOSIM:
+			case InclParam::ANTICHAINS_DOWN_NONREC_SIM:
+			{
+				if (nullptr != indices)
+				{
+					result = VATA::ExplicitDownwardInclusion::Check(indices->down, smaller,
+						bigger, rel, params.GetNumThreads(), params.GetCancellationToken());
+				}
+				else
+				{
+					result = VATA::ExplicitDownwardInclusion::Check(smaller, bigger, rel,
+						params.GetNumThreads(), params.GetCancellationToken());
+				}
+
+				break;
+			}
+
+			case InclParam::ANTICHAINS_DOWN_REC_NOSIM:
+			case InclParam::ANTICHAINS_DOWN_REC_SIM:
+			{
+				result = VATA::CheckDownwardTreeInclusion<ExplicitTreeAutCore,
+					VATA::DownwardInclusionFunctor>(smaller, bigger, rel,
+					params.GetCancellationToken());
+				break;
+			}
+
+			case InclParam::ANTICHAINS_DOWN_REC_OPT_NOSIM:
+			case InclParam::ANTICHAINS_DOWN_REC_OPT_SIM:
+			{
+				result = VATA::CheckDownwardTreeInclusion<ExplicitTreeAutCore,
+					VATA::OptDownwardInclusionFunctor>(smaller, bigger, rel,
+					params.GetCancellationToken());
+				break;
+			}
+
+			case InclParam::CONGR_DEPTH_NOSIM:
+			case InclParam::CONGR_BREADTH_NOSIM:
+			{
+				// the congruence algorithm keeps track of the counterexample itself
+				return ExplicitUpwardEquivalence::CheckInclusion(smaller, bigger,
+					params.GetSearchOrder(), params.GetCancellationToken(), counterexample);
+			}
+
+			default:
+			{
+				throw VATA::NotImplementedException("Inclusion:\n" +
+					params.toString());
+			}
+		}
+
+		if (!result && (nullptr != counterexample))
+		{	// the downward algorithms do not keep track of the counterexample
+			findCounterexample(smaller, bigger, params, *counterexample);
+		}
+
+		return result;
+	}
+}
+
 bool ExplicitTreeAutCore::CheckInclusion(
 	const ExplicitTreeAutCore&             smaller,
 	const ExplicitTreeAutCore&             bigger,
+	const VATA::InclParam&                 params,
+	ExplicitTreeAutCore*                   counterexample)
+{
+	if (nullptr != counterexample)
+	{
+		counterexample->SetAlphabet(smaller.GetAlphabet());
+	}
+
+	if (params.GetUseSimulation())
+	{
+		if (!params.HasSimulation())
+		{	// sanitize the automata and compute the simulation on their union (or
+			// take both from the cache of the bigger automaton)
+			if (smaller.GetTransitions()->empty())
+			{	// the language of the smaller automaton is empty
+				return true;
+			}
+
+			InclusionSimulationPtr inclSim = bigger.getInclusionSimulation(smaller, params);
+			assert(nullptr != inclSim);
+
+			if (inclSim->smaller.GetTransitions()->empty())
+			{	// the language of the smaller automaton is empty
+				return true;
+			}
+
+			return checkInclusionWithRel(inclSim->smaller, inclSim->bigger, params,
+				inclSim->sim, nullptr, counterexample);
+		}
+		else if (params.HasSparseSimulation())
+		{
+			return checkInclusionWithRel(smaller, bigger, params,
+				params.GetSparseSimulation(), nullptr, counterexample);
+		}
+		else
+		{
+			return checkInclusionWithRel(smaller, bigger, params,
+				params.GetSimulation(), nullptr, counterexample);
+		}
+	}
+
+	ExplicitTreeAutCore newSmaller = smaller;
+	ExplicitTreeAutCore newBigger = bigger;
+
+	typename AutBase::StateType states =
+		AutBase::SanitizeAutsForInclusion(newSmaller, newBigger);
+
+	// sanitization creates new automata, keep them frozen if the input was
+	if (smaller.IsFrozen())
+	{
+		newSmaller.Freeze();
+	}
+
+	if (bigger.IsFrozen())
+	{
+		newBigger.Freeze();
+	}
+
+	assert(static_cast<typename AutBase::StateType>(-1) != states);
+
+	return checkInclusionWithRel(newSmaller, newBigger, params,
+		Util::Identity(states), nullptr, counterexample);
+}
+
+
+bool ExplicitTreeAutCore::CheckEquivalence(
+	const ExplicitTreeAutCore&             lhs,
+	const ExplicitTreeAutCore&             rhs,
 	const VATA::InclParam&                 params)
 {
-	ExplicitTreeAutCore newSmaller;
-	ExplicitTreeAutCore newBigger;
-	typename AutBase::StateType states = static_cast<typename AutBase::StateType>(-1);
+	ExplicitTreeAutCore newLhs = lhs;
+	ExplicitTreeAutCore newRhs = rhs;
 
-	if (!params.GetUseSimulation())
+	AutBase::SanitizeAutsForInclusion(newLhs, newRhs);
+
+	return ExplicitUpwardEquivalence::Check(newLhs, newRhs,
+		params.GetSearchOrder(), params.GetCancellationToken());
+}
+
+
+std::vector<bool> ExplicitTreeAutCore::CheckInclusionBatch(
+	const ExplicitTreeAutCore&                      smaller,
+	const std::vector<const ExplicitTreeAutCore*>&  biggers,
+	const VATA::InclParam&                          params,
+	bool                                            stopAtFirstSuccess)
+{
+	std::vector<bool> result(biggers.size(), false);
+	if (biggers.empty())
 	{
-		newSmaller = smaller;
-		newBigger = bigger;
+		return result;
+	}
+
+	// the smaller automaton is sanitized and indexed only once; the states of
+	// every bigger automaton are then numbered after its states
+	StateType stateCnt = 0;
+	StateToStateMap stateMap;
+	StateToStateTranslWeak stateTrans(stateMap,
+		[&stateCnt](const StateType&){return stateCnt++;});
 
-		states = AutBase::SanitizeAutsForInclusion(newSmaller, newBigger);
+	ExplicitTreeAutCore newSmaller = smaller.RemoveUselessStates().ReindexStates(stateTrans);
+	if (smaller.IsFrozen())
+	{
+		newSmaller.Freeze();
 	}
 
-	switch (params.GetOptions())
+	const StateType smallerStates = stateCnt;
+
+	const SmallerIndices indices(newSmaller, params);
+
+	// a simulation given in the parameters is not on the sanitized states, so
+	// the simulation is always computed on the union of the automata
+	auto checkSanitized = [&newSmaller, &indices](
+		const ExplicitTreeAutCore&      newBigger,
+		const InclParam&                checkParams,
+		StateType                       states) -> bool
 	{
-		case InclParam::ANTICHAINS_UP_NOSIM:
+		if (!checkParams.GetUseSimulation())
 		{
-			assert(static_cast<typename AutBase::StateType>(-1) != states);
+			return checkInclusionWithRel(newSmaller, newBigger, checkParams,
+				Util::Identity(states), &indices);
+		}
 
-			return ExplicitUpwardInclusion::Check(newSmaller, newBigger,
-				Util::Identity(states));
+		if (newSmaller.GetTransitions()->empty())
+		{	// the language of the smaller automaton is empty
+			return true;
 		}
 
-		case InclParam::ANTICHAINS_UP_SIM:
-		{
-			assert(static_cast<typename AutBase::StateType>(-1) == states);
+		return checkInclusionWithRel(newSmaller, newBigger, checkParams,
+			newBigger.computeInclusionSimulation(newSmaller, checkParams), &indices);
+	};
 
-			return ExplicitUpwardInclusion::Check(smaller, bigger,
-				params.GetSimulation());
-		}
+	auto sanitizeBigger = [&smallerStates](
+		const ExplicitTreeAutCore&      bigger,
+		StateType&                      states) -> ExplicitTreeAutCore
+	{
+		states = smallerStates;
+		StateToStateMap biggerMap;
+		StateToStateTranslWeak biggerTrans(biggerMap,
+			[&states](const StateType&){return states++;});
 
-		case InclParam::ANTICHAINS_DOWN_NONREC_NOSIM:
+		ExplicitTreeAutCore newBigger = bigger.RemoveUselessStates().ReindexStates(biggerTrans);
+		if (bigger.IsFrozen())
 		{
-			assert(static_cast<typename AutBase::StateType>(-1) != states);
-
-			return ExplicitDownwardInclusion::Check(newSmaller, newBigger,
-				Util::Identity(states));
+			newBigger.Freeze();
 		}
 
-		case InclParam::ANTICHAINS_DOWN_NONREC_SIM:
-		{
-			assert(static_cast<typename AutBase::StateType>(-1) == states);
+		return newBigger;
+	};
 
-			return ExplicitDownwardInclusion::Check(smaller, bigger,
-				params.GetSimulation());
-		}
+	const size_t numThreads = Util::GetNumThreads(params.GetNumThreads());
 
-		case InclParam::ANTICHAINS_DOWN_REC_NOSIM:
+	if (1 == numThreads)
+	{
+		for (size_t i = 0; i < biggers.size(); ++i)
 		{
-			assert(static_cast<typename AutBase::StateType>(-1) != states);
+			assert(nullptr != biggers[i]);
 
-			return CheckDownwardTreeInclusion<ExplicitTreeAutCore,
-				VATA::DownwardInclusionFunctor>(newSmaller, newBigger,
-					Util::Identity(states));
-		}
+			StateType states;
+			ExplicitTreeAutCore newBigger = sanitizeBigger(*biggers[i], states);
 
-		case InclParam::ANTICHAINS_DOWN_REC_OPT_NOSIM:
-		{
-			assert(static_cast<typename AutBase::StateType>(-1) != states);
+			result[i] = checkSanitized(newBigger, params, states);
 
-			return CheckDownwardTreeInclusion<ExplicitTreeAutCore,
-				VATA::OptDownwardInclusionFunctor>(newSmaller, newBigger,
-					Util::Identity(states));
+			if (result[i] && stopAtFirstSuccess)
+			{
+				break;
+			}
 		}
 
-		case InclParam::ANTICHAINS_DOWN_REC_SIM:
-		{
-			assert(static_cast<typename AutBase::StateType>(-1) == states);
+		return result;
+	}
 
-			return CheckDownwardTreeInclusion<ExplicitTreeAutCore,
-				VATA::DownwardInclusionFunctor>(smaller, bigger,
-					params.GetSimulation());
-		}
+	// the tuple cache is not thread-safe, so the bigger automata are
+	// sanitized before the checks, which only read them
+	std::vector<ExplicitTreeAutCore> newBiggers;
+	std::vector<StateType> biggerStates(biggers.size());
+	newBiggers.reserve(biggers.size());
+	for (size_t i = 0; i < biggers.size(); ++i)
+	{
+		assert(nullptr != biggers[i]);
+
+		newBiggers.push_back(sanitizeBigger(*biggers[i], biggerStates[i]));
+	}
 
-		case InclParam::ANTICHAINS_DOWN_REC_OPT_SIM:
+	// every check has its own token, so that the checks following the first
+	// success can be cancelled
+	std::vector<std::unique_ptr<CancellationToken>> tokens;
+	for (size_t i = 0; i < biggers.size(); ++i)
+	{
+		tokens.emplace_back(new CancellationToken(params.GetCancellationToken()));
+	}
+
+	std::mutex mutex;
+	size_t firstSuccess = biggers.size();
+
+	// the checks themselves are sequential
+	InclParam checkParams = params;
+	checkParams.SetNumThreads(1);
+
+	Util::ParallelWorklist<size_t> worklist(numThreads);
+	for (size_t i = biggers.size(); i > 0; --i)
+	{	// workers take their items from the back, so the first automata are
+		// checked first
+		worklist.Push((i - 1) % numThreads, i - 1);
+	}
+
+	worklist.Run([&](size_t /* workerId */, size_t i)
 		{
-			assert(static_cast<typename AutBase::StateType>(-1) == states);
+			if (stopAtFirstSuccess)
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				if (firstSuccess < i)
+				{
+					return;
+				}
+			}
 
-			return CheckDownwardTreeInclusion<ExplicitTreeAutCore,
-				VATA::OptDownwardInclusionFunctor>(smaller, bigger,
-					params.GetSimulation());
-		}
+			InclParam localParams = checkParams;
+			localParams.SetCancellationToken(tokens[i].get());
+
+			bool res;
+			try
+			{
+				res = checkSanitized(newBiggers[i], localParams, biggerStates[i]);
+			}
+			catch (const OperationCancelledException&)
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				if (stopAtFirstSuccess && (firstSuccess < i))
+				{	// cancelled by a success of a preceding check
+					return;
+				}
+
+				throw;
+			}
 
-		default:
+			std::lock_guard<std::mutex> lock(mutex);
+			result[i] = res;
+
+			if (res && stopAtFirstSuccess && (i < firstSuccess))
+			{
+				firstSuccess = i;
+				for (size_t j = i + 1; j < tokens.size(); ++j)
+				{
+					tokens[j]->Cancel();
+				}
+			}
+		});
+
+	if (stopAtFirstSuccess)
+	{	// only the first success is reported
+		for (size_t i = firstSuccess + 1; i < result.size(); ++i)
 		{
-			throw NotImplementedException("Inclusion:\n" +
-				params.toString());
+			result[i] = false;
 		}
 	}
+
+	return result;
 }
@@ -9,8 +9,11 @@
  *****************************************************************************/
 
 // Standard library headers
-#include <set>
 #include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <set>
 
 // VATA headers
 #include <vata/vata.hh>
@@ -22,6 +25,7 @@
 #include "util/cache.hh"
 #include "util/cached_binary_op.hh"
 #include "util/caching_allocator.hh"
+#include "util/parallel_worklist.hh"
 
 // TODO: a lot in common with src/explicit_tree_incl_up.cc
 
@@ -253,6 +257,68 @@ private:
 	ExpandCallEmulator& operator=(const ExpandCallEmulator&);
 };
 
+/**
+ * @brief  Pairs found not to be included, shared by parallel workers
+ *
+ * The pairs are only appended, so that every worker can import the pairs
+ * published since its last import.
+ */
+class SharedNonInclusion
+{
+	std::mutex mutex_;
+	std::vector<std::pair<SmallerType, StateSet>> pairs_;
+	std::atomic<size_t> size_;
+
+public:
+
+	SharedNonInclusion() : mutex_(), pairs_(), size_(0) { }
+
+	void publish(const SmallerType& p_S, const StateSet& P_B)
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+
+		pairs_.push_back(std::make_pair(p_S, P_B));
+		size_ = pairs_.size();
+	}
+
+	size_t size() const
+	{
+		return size_;
+	}
+
+	template <class Func>
+	void forEachFrom(size_t from, Func func)
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+
+		for (size_t i = from; i < pairs_.size(); ++i)
+		{
+			func(pairs_[i].first, pairs_[i].second);
+		}
+	}
+};
+
+/**
+ * @brief  State of a worker of the parallel inclusion check
+ *
+ * The worker checks the root pair only for the transitions under the symbol
+ * @p rootSymbol of the smaller automaton.
+ */
+struct WorkerContext
+{
+	size_t rootSymbol;
+	const std::atomic<bool>* cancelled;
+	SharedNonInclusion* shared;
+	size_t imported;
+
+	WorkerContext(const std::atomic<bool>* cancelled, SharedNonInclusion* shared) :
+		rootSymbol(),
+		cancelled(cancelled),
+		shared(shared),
+		imported(0)
+	{ }
+};
+
 #define EXPAND_CALL(ret)\
 	retAddr = ret;\
 	goto _call;
@@ -289,7 +355,9 @@ inline bool expand(
 	const DoubleIndexedTupleList&                   smallerIndex,
 	const DoubleIndexedTupleList&                   biggerIndex,
 	const StateDiscontBinaryRelation::IndexType&    ind,
-	const StateDiscontBinaryRelation::IndexType&    inv)
+	const StateDiscontBinaryRelation::IndexType&    inv,
+	const VATA::CancellationToken*                  cancel,
+	WorkerContext*                                  worker = nullptr)
 {
 	auto noncachedLte = [&ind](const StateSet* x, const StateSet* y) -> bool
 	{
@@ -336,7 +404,36 @@ inline bool expand(
 	size_t retAddr = 0;
 
 	bool found = false; // return value of simulated calls
+
+	// polls the token (which checks its budgets); the exception is rethrown
+	// once the call stack is unwound
+	auto isCancelled = [cancel, worker]() -> bool
+	{
+		if ((nullptr != worker) && *worker->cancelled)
+		{
+			return true;
+		}
+
+		if (nullptr != cancel)
+		{
+			try
+			{
+				cancel->Poll();
+			}
+			catch (const VATA::OperationCancelledException&)
+			{
+				return true;
+			}
+		}
+
+		return false;
+	};
 _call:
+	if (isCancelled())
+	{
+		goto _cancel;
+	}
+
 	if (smallerIndex.size() <= r_i)
 	{
 		found = true;
@@ -362,6 +459,24 @@ _call:
 
 	assert(r_i < inv.size());
 
+	if ((nullptr != worker) && (worker->imported < worker->shared->size()))
+	{	// import the pairs found not to be included by other workers
+		worker->shared->forEachFrom(worker->imported,
+			[&](const SmallerType& q, const StateSet& Q)
+			{
+				BiggerType T = biggerTypeCache.lookup(Q);
+
+				if (!nonincluded.contains(inv.at(q), T, gte))
+				{
+					nonincluded.refine(ind.at(q), T, lte);
+					nonincluded.insert(q, T);
+				}
+
+				++worker->imported;
+			}
+		);
+	}
+
 	if (nonincluded.contains(inv.at(r_i), S, gte))
 	{
 		found = false;
@@ -377,6 +492,9 @@ _call:
 
 	for (top.a = 0; top.a < smallerIndex[top.p_S].size(); ++top.a)
 	{
+		if ((nullptr != worker) && (0 == top.retAddr) && (worker->rootSymbol != top.a))
+			continue;
+
 		smallerTupleSet = &smallerIndex[top.p_S][top.a];
 
 		if (smallerTupleSet->empty())
@@ -456,6 +574,11 @@ _simret:
 
 			do
 			{
+				if (isCancelled())
+				{
+					goto _cancel;
+				}
+
 				// we loop for each choice function
 				found = false;
 
@@ -513,6 +636,11 @@ _stdret:
 					{
 						nonincluded.refine(ind.at(r_i), S, lte);
 						nonincluded.insert(r_i, S);
+
+						if (nullptr != worker)
+						{
+							worker->shared->publish(r_i, *S);
+						}
 					}
 				}
 
@@ -534,6 +662,19 @@ _end:
 	assert(callEmulator.empty());
 
 	return found;
+_cancel:
+	while (!callEmulator.empty())
+	{
+		callEmulator.pop(top);
+	}
+
+	if (nullptr != cancel)
+	{
+		cancel->Poll();
+	}
+
+	// another worker found a counterexample, the result does not matter
+	return true;
 }
 } // namespace
 
@@ -544,7 +685,8 @@ bool VATA::ExplicitDownwardInclusion::checkInternal(
 	const DoubleIndexedTupleList&                 biggerIndex,
 	const ExplicitTreeAutCore::FinalStateSet&     biggerFinalStates,
 	const StateDiscontBinaryRelation::IndexType&  ind,
-	const StateDiscontBinaryRelation::IndexType&  inv)
+	const StateDiscontBinaryRelation::IndexType&  inv,
+	const CancellationToken*                      cancel)
 {
 	Util::CachedBinaryOp<const StateSet*, const StateSet*, bool> lteCache;
 
@@ -566,9 +708,104 @@ bool VATA::ExplicitDownwardInclusion::checkInternal(
 
 	for (auto& f : smallerFinalStates)
 	{
-		if (!expand(biggerTypeCache, lteCache, nonincluded, f, biggerF, smallerIndex, biggerIndex, ind, inv))
+		if (!expand(biggerTypeCache, lteCache, nonincluded, f, biggerF, smallerIndex, biggerIndex, ind, inv, cancel))
 			return false;
 	}
 
 	return true;
 }
+
+
+bool VATA::ExplicitDownwardInclusion::checkInternalParallel(
+	const DoubleIndexedTupleList&                 smallerIndex,
+	const ExplicitTreeAutCore::FinalStateSet&     smallerFinalStates,
+	const DoubleIndexedTupleList&                 biggerIndex,
+	const ExplicitTreeAutCore::FinalStateSet&     biggerFinalStates,
+	const StateDiscontBinaryRelation::IndexType&  ind,
+	const StateDiscontBinaryRelation::IndexType&  inv,
+	size_t                                        numThreads,
+	const CancellationToken*                      cancel)
+{
+	struct Task
+	{
+		SmallerType p_S;
+		size_t symbol;
+	};
+
+	// a thread-local copy of the data of the sequential check
+	struct Worker
+	{
+		Util::CachedBinaryOp<const StateSet*, const StateSet*, bool> lteCache;
+		BiggerTypeCache biggerTypeCache;
+		Antichain2C nonincluded;
+		WorkerContext context;
+
+		Worker(const std::atomic<bool>* cancelled, SharedNonInclusion* shared) :
+			lteCache(),
+			biggerTypeCache(
+				[this](const StateSet* v)
+				{
+					lteCache.invalidateFirst(v);
+					lteCache.invalidateSecond(v);
+				}
+			),
+			nonincluded(),
+			context(cancelled, shared)
+		{ }
+
+	private:
+
+		Worker(const Worker&);
+		Worker& operator=(const Worker&);
+	};
+
+	numThreads = Util::GetNumThreads(numThreads);
+
+	std::vector<size_t> v(biggerFinalStates.begin(), biggerFinalStates.end());
+
+	std::sort(v.begin(), v.end());
+
+	Util::ParallelWorklist<Task> worklist(numThreads);
+
+	size_t taskCnt = 0;
+	for (auto& f : smallerFinalStates)
+	{
+		if (smallerIndex.size() <= f)
+			continue;
+
+		for (size_t a = 0; a < smallerIndex[f].size(); ++a)
+		{
+			if (!smallerIndex[f][a].empty())
+			{
+				worklist.Push(taskCnt++ % numThreads, Task{f, a});
+			}
+		}
+	}
+
+	std::atomic<bool> counterexample(false);
+	SharedNonInclusion shared;
+
+	std::vector<std::unique_ptr<Worker>> workers;
+	for (size_t i = 0; i < numThreads; ++i)
+	{
+		workers.push_back(std::unique_ptr<Worker>(new Worker(&counterexample, &shared)));
+	}
+
+	worklist.Run([&](size_t workerId, const Task& task)
+		{
+			Worker& worker = *workers[workerId];
+
+			worker.context.rootSymbol = task.symbol;
+
+			if (!expand(worker.biggerTypeCache, worker.lteCache, worker.nonincluded,
+				task.p_S, worker.biggerTypeCache.lookup(v), smallerIndex, biggerIndex,
+				ind, inv, cancel, &worker.context))
+			{
+				counterexample = true;
+				worklist.Stop();
+			}
+		}
+	);
+
+	return !counterexample;
+}
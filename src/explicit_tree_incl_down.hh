@@ -29,6 +29,12 @@ public:
 
 private:
 
+	/**
+	 * @brief  Builds the top-down index of an automaton
+	 *
+	 * The index points to the tuples of the automaton (also if it is frozen),
+	 * so the automaton needs to outlive the index.
+	 */
 	template <
 		class Aut,
 		class SymbolIndex>
@@ -37,7 +43,43 @@ private:
 		DoubleIndexedTupleList&     topDownIndex,
 		SymbolIndex&                symbolIndex)
 	{
-		for (auto& stateClusterPair : *aut.transitions_)
+		if (aut.frozen_)
+		{
+			const auto& frozen = aut.frozen_->GetTransitions();
+
+			for (size_t p = 0; p < frozen.ParentCount(); ++p)
+			{
+				const auto& parent = frozen.GetParent(p);
+				if (parent >= topDownIndex.size())
+				{
+					topDownIndex.resize(parent + 1);
+				}
+
+				auto& indexedTupleList = topDownIndex[parent];
+
+				for (size_t s = frozen.SymbolsBegin(p); s < frozen.SymbolsEnd(p); ++s)
+				{
+					SymbolType symbol = symbolIndex[frozen.GetSymbol(s)];
+
+					if (symbol >= indexedTupleList.size())
+					{
+						indexedTupleList.resize(symbol + 1);
+					}
+
+					auto& tupleList = indexedTupleList[symbol];
+
+					for (size_t t = frozen.TuplesBegin(s); t < frozen.TuplesEnd(s); ++t)
+					{
+						tupleList.push_back(
+							frozen.GetTuplePtrById(frozen.GetTupleId(t)).get());
+					}
+				}
+			}
+
+			return;
+		}
+
+		for (auto& stateClusterPair : *aut.clusterMap())
 		{
 			assert(stateClusterPair.second);
 
@@ -74,33 +116,136 @@ private:
 
 public:
 
+	/**
+	 * @brief  Checks language inclusion of two automata
+	 *
+	 * @param[in]  smaller     The smaller automaton
+	 * @param[in]  bigger      The bigger automaton
+	 * @param[in]  preorder    A simulation on the states of both automata
+	 * @param[in]  numThreads  The number of threads (0 denotes the number of
+	 *                         hardware threads)
+	 * @param[in]  cancel      A token cancelling the check (may be @p nullptr)
+	 */
 	template <
 		class Aut,
 		class Rel>
 	static bool Check(
 		const Aut&            smaller,
 		const Aut&            bigger,
-		const Rel&            preorder)
+		const Rel&            preorder,
+		size_t                numThreads = 1,
+		const CancellationToken* cancel = nullptr)
+	{
+		SmallerIndex smallerIndex;
+
+		ExplicitDownwardInclusion::IndexSmaller(smaller, smallerIndex);
+
+		return ExplicitDownwardInclusion::Check(
+			smallerIndex, smaller, bigger, preorder, numThreads, cancel);
+	}
+
+	/**
+	 * @brief  The index of the smaller automaton
+	 *
+	 * The index may be shared by checks of the smaller automaton against
+	 * several bigger automata (also concurrently).  It points to the tuples
+	 * of the smaller automaton, which needs to outlive it.
+	 */
+	class SmallerIndex
 	{
-		DoubleIndexedTupleList smallerIndex, biggerIndex;
+	public:
+
+		DoubleIndexedTupleList                     index;
+
+		/// the numbering of symbols of the smaller automaton
+		std::unordered_map<SymbolType, size_t>     symbolMap;
+
+	private:
+
+		SmallerIndex(const SmallerIndex&);
+		SmallerIndex& operator=(const SmallerIndex&);
+
+	public:
+
+		SmallerIndex() :
+			index(),
+			symbolMap()
+		{ }
+	};
 
+	/**
+	 * @brief  Builds the index of the smaller automaton
+	 */
+	template <
+		class Aut>
+	static void IndexSmaller(
+		const Aut&        smaller,
+		SmallerIndex&     smallerIndex)
+	{
 		size_t symbolCnt = 0;
-		std::unordered_map<typename Aut::SymbolType, size_t> symbolMap;
-		Util::TranslatorWeak2<std::unordered_map<typename Aut::SymbolType, size_t>>
+		Util::TranslatorWeak2<std::unordered_map<SymbolType, size_t>>
+			symbolTranslator(
+				smallerIndex.symbolMap,
+				[&symbolCnt](const SymbolType&){ return symbolCnt++; }
+			);
+
+		ExplicitDownwardInclusion::topDownIndex(
+			smaller, smallerIndex.index, symbolTranslator);
+	}
+
+	/**
+	 * @brief  Checks language inclusion using a prebuilt index of the smaller
+	 *         automaton
+	 *
+	 * @param[in]  smallerIndex  The index of @p smaller (see IndexSmaller())
+	 * @param[in]  smaller       The smaller automaton
+	 * @param[in]  bigger        The bigger automaton
+	 * @param[in]  preorder      A simulation on the states of both automata
+	 * @param[in]  numThreads    The number of threads (0 denotes the number of
+	 *                           hardware threads)
+	 * @param[in]  cancel        A token cancelling the check (may be @p nullptr)
+	 */
+	template <
+		class Aut,
+		class Rel>
+	static bool Check(
+		const SmallerIndex&      smallerIndex,
+		const Aut&               smaller,
+		const Aut&               bigger,
+		const Rel&               preorder,
+		size_t                   numThreads = 1,
+		const CancellationToken* cancel = nullptr)
+	{
+		DoubleIndexedTupleList biggerIndex;
+
+		// symbols of the bigger automaton missing in the smaller one are
+		// numbered after the symbols of the smaller automaton
+		std::unordered_map<SymbolType, size_t> symbolMap = smallerIndex.symbolMap;
+		size_t symbolCnt = symbolMap.size();
+		Util::TranslatorWeak2<std::unordered_map<SymbolType, size_t>>
 			symbolTranslator(
 				symbolMap,
-				[&symbolCnt](const typename Aut::SymbolType&){ return symbolCnt++; }
+				[&symbolCnt](const SymbolType&){ return symbolCnt++; }
 			);
 
-		ExplicitDownwardInclusion::topDownIndex(smaller, smallerIndex, symbolTranslator);
-		ExplicitDownwardInclusion::topDownIndex(bigger, biggerIndex, symbolTranslator);
+		ExplicitDownwardInclusion::topDownIndex(
+			bigger, biggerIndex, symbolTranslator);
 
 		typename Rel::IndexType ind, inv;
 
 		preorder.buildIndex(ind, inv);
 
+		if (1 != numThreads)
+		{
+			return ExplicitDownwardInclusion::checkInternalParallel(
+				smallerIndex.index, smaller.GetFinalStates(), biggerIndex,
+				bigger.GetFinalStates(), ind, inv, numThreads, cancel
+			);
+		}
+
 		return ExplicitDownwardInclusion::checkInternal(
-			smallerIndex, smaller.GetFinalStates(), biggerIndex, bigger.GetFinalStates(), ind, inv
+			smallerIndex.index, smaller.GetFinalStates(), biggerIndex,
+			bigger.GetFinalStates(), ind, inv, cancel
 		);
 	}
 
@@ -153,7 +298,27 @@ private:
 		const DoubleIndexedTupleList&                  biggerIndex,
 		const ExplicitTreeAutCore::FinalStateSet&      biggerFinalStates,
 		const StateDiscontBinaryRelation::IndexType&   ind,
-		const StateDiscontBinaryRelation::IndexType&   inv
+		const StateDiscontBinaryRelation::IndexType&   inv,
+		const CancellationToken*                       cancel
+	);
+
+	/**
+	 * @brief  The parallel version of checkInternal()
+	 *
+	 * Every final state of the smaller automaton and every symbol of its
+	 * transitions give an independent subproblem, which is checked by a single
+	 * thread of a work-stealing pool.  The threads share the pairs found not to be included
+	 * and stop as soon as one of them finds a counterexample.
+	 */
+	static bool checkInternalParallel(
+		const DoubleIndexedTupleList&                  smallerIndex,
+		const ExplicitTreeAutCore::FinalStateSet&      smallerFinalStates,
+		const DoubleIndexedTupleList&                  biggerIndex,
+		const ExplicitTreeAutCore::FinalStateSet&      biggerFinalStates,
+		const StateDiscontBinaryRelation::IndexType&   ind,
+		const StateDiscontBinaryRelation::IndexType&   inv,
+		size_t                                         numThreads,
+		const CancellationToken*                       cancel
 	);
 
 /*
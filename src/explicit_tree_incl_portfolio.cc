@@ -0,0 +1,167 @@
+/*****************************************************************************
+ *  VATA Tree Automata Library
+ *
+ *  Copyright (c) 2015  Ondra Lengal <ilengal@fit.vutbr.cz>
+ *
+ *  Description:
+ *    Implementation of the portfolio inclusion check of explicit tree
+ *    automata.
+ *
+ *****************************************************************************/
+
+// VATA headers
+#include <vata/vata.hh>
+#include <vata/cancellation_token.hh>
+#include <vata/incl_param.hh>
+
+// Standard library headers
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "explicit_tree_aut_core.hh"
+
+using VATA::ExplicitTreeAutCore;
+using VATA::InclParam;
+
+
+std::vector<InclParam> ExplicitTreeAutCore::GetDefaultInclusionPortfolio()
+{
+	std::vector<InclParam> configs;
+
+	for (bool useSim : {false, true})
+	{
+		InclParam up;
+		up.SetDirection(InclParam::e_direction::upward);
+		up.SetUseSimulation(useSim);
+		configs.push_back(up);
+
+		InclParam down;
+		down.SetDirection(InclParam::e_direction::downward);
+		down.SetUseSimulation(useSim);
+		configs.push_back(down);
+	}
+
+	InclParam downOpt;
+	downOpt.SetDirection(InclParam::e_direction::downward);
+	downOpt.SetUseRecursion(true);
+	downOpt.SetUseDownwardCacheImpl(true);
+	downOpt.SetUseSimulation(true);
+	configs.push_back(downOpt);
+
+	return configs;
+}
+
+
+bool ExplicitTreeAutCore::CheckInclusionPortfolio(
+	const ExplicitTreeAutCore&           smaller,
+	const ExplicitTreeAutCore&           bigger,
+	const std::vector<InclParam>&        configs,
+	size_t*                              winner)
+{
+	if (configs.empty())
+	{
+		throw std::runtime_error("No configuration for portfolio inclusion");
+	}
+
+	// every check has its own token, so that it is bounded by the budgets of
+	// its configuration, and all of them are cancelled by the winner
+	std::vector<std::unique_ptr<CancellationToken>> tokens;
+	for (const InclParam& config : configs)
+	{
+		tokens.emplace_back(new CancellationToken(config.GetCancellationToken()));
+	}
+
+	// the automata are sanitized only once for all checks; otherwise, every
+	// configuration that computes a simulation would sanitize them itself
+	ExplicitTreeAutCore sanSmaller = smaller;
+	ExplicitTreeAutCore sanBigger = bigger;
+
+	AutBase::SanitizeAutsForInclusion(sanSmaller, sanBigger);
+
+	// sanitization creates new automata, keep them frozen if the input was
+	if (smaller.IsFrozen())
+	{
+		sanSmaller.Freeze();
+	}
+
+	if (bigger.IsFrozen())
+	{
+		sanBigger.Freeze();
+	}
+
+	std::mutex mutex;
+	size_t first = configs.size();
+	bool result = false;
+	std::exception_ptr error = nullptr;
+
+	auto check = [&](size_t i)
+	{
+		// the tuple cache is not thread-safe, so the automata created during a
+		// check use a cache of the check; the transitions of the sanitized
+		// automata (and their tuples) are shared by all checks, which only read
+		// them
+		TupleCachePtr tupleCache(new TupleCache());
+
+		try
+		{
+			// a simulation given in the configuration is on the original states
+			const bool hasSim = configs[i].HasSimulation();
+			ExplicitTreeAutCore newSmaller(hasSim? smaller : sanSmaller, tupleCache);
+			ExplicitTreeAutCore newBigger(hasSim? bigger : sanBigger, tupleCache);
+
+			InclParam params = configs[i];
+			params.SetCancellationToken(tokens[i].get());
+
+			bool res = ExplicitTreeAutCore::CheckInclusion(newSmaller, newBigger, params);
+
+			std::lock_guard<std::mutex> lock(mutex);
+			if (configs.size() == first)
+			{	// the first answer wins, the other checks are cancelled
+				first = i;
+				result = res;
+				for (auto& token : tokens)
+				{
+					token->Cancel();
+				}
+			}
+		}
+		catch (...)
+		{	// a failing configuration (including one exceeding its budget) does
+			// not stop the others
+			std::lock_guard<std::mutex> lock(mutex);
+			if (nullptr == error)
+			{
+				error = std::current_exception();
+			}
+		}
+	};
+
+	std::vector<std::thread> threads;
+	for (size_t i = 1; i < configs.size(); ++i)
+	{
+		threads.push_back(std::thread(check, i));
+	}
+
+	check(0);
+
+	for (std::thread& thread : threads)
+	{
+		thread.join();
+	}
+
+	if (configs.size() == first)
+	{	// all checks failed
+		assert(nullptr != error);
+		std::rethrow_exception(error);
+	}
+
+	if (nullptr != winner)
+	{
+		*winner = first;
+	}
+
+	return result;
+}
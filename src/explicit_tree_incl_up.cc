@@ -11,6 +11,11 @@
 // Standard library headers
 #include <set>
 #include <algorithm>
+#include <atomic>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
 
 // VATA headers
 #include <vata/vata.hh>
@@ -21,6 +26,7 @@
 #include "explicit_tree_incl_up.hh"
 #include "util/cache.hh"
 #include "util/cached_binary_op.hh"
+#include "util/parallel_worklist.hh"
 
 
 typedef VATA::ExplicitTreeAutCore::StateType SmallerType;
@@ -37,6 +43,10 @@ typedef typename VATA::Util::Antichain2Cv2<SmallerType, BiggerType> Antichain2C;
 
 typedef std::pair<SmallerType, Antichain2C::TList::iterator> SmallerBiggerPair;
 
+typedef VATA::ExplicitTreeAutCore::StateDiscontBinaryRelation::IndexType IndexType;
+
+typedef VATA::BUIndexTransition BUTransition;
+
 
 namespace
 {	// anonymous namespace
@@ -205,6 +215,256 @@ public:
 		return state_.size();
 	}
 };
+
+
+/**
+ * @brief  Computes the antichain of the states reached by transitions
+ *
+ * @returns  @p true if a final state is reached, @p false otherwise
+ */
+template <class TransitionCont>
+bool computePost(
+	const TransitionCont&                               transitions,
+	const VATA::ExplicitTreeAutCore::FinalStateSet&     finalStates,
+	const IndexType&                                    ind,
+	const IndexType&                                    inv,
+	Antichain1C&                                        post)
+{
+	post.clear();
+	bool isAccepting = false;
+
+	for (auto& transition : transitions)
+	{
+		assert(transition);
+		assert(transition->state() < ind.size());
+
+		if (post.contains(ind.at(transition->state())))
+		{
+			continue;
+		}
+
+		assert(transition->state() < inv.size());
+
+		post.refine(inv.at(transition->state()));
+		post.insert(transition->state());
+
+		isAccepting = isAccepting || finalStates.count(transition->state());
+	}
+
+	return isAccepting;
+}
+
+
+/**
+ * @brief  Collects the transitions of the bigger automaton over @p symbol
+ *         whose children are in the current choice of macrostates
+ */
+template <class EvalTransitionsF>
+std::list<const BUTransition*> evalChoice(
+	const SymbolType&         symbol,
+	const ChoiceVector&       choiceVector,
+	EvalTransitionsF&         evalTransitions)
+{
+	assert(choiceVector(0));
+
+	auto firstSet = evalTransitions(symbol, 0, choiceVector(0).get());
+
+	assert(firstSet);
+
+	std::list<const BUTransition*> biggerTransitions(
+		firstSet->begin(), firstSet->end()
+	);
+
+	for (size_t k = 1; k < choiceVector.size(); ++k)
+	{
+		assert(choiceVector(k));
+
+		auto transitions = evalTransitions(
+			symbol, k, choiceVector(k).get()
+		);
+
+		assert(transitions);
+
+		intersectionByLookup(biggerTransitions, *transitions);
+	}
+
+	return biggerTransitions;
+}
+
+
+/**
+ * @brief  Records the trees reaching the pairs of the antichain
+ *
+ * Every pair (q, Q) is recorded with a tree accepted at q in the smaller
+ * automaton and reaching exactly (up to simulation) the states of Q in the
+ * bigger automaton, so that a counterexample can be reconstructed.
+ */
+class WitnessRecorder
+{
+public:   // data types
+
+	using WitnessNode     = VATA::ExplicitUpwardInclusion::WitnessNode;
+	using WitnessNodePtr  = VATA::ExplicitUpwardInclusion::WitnessNodePtr;
+
+private:  // data members
+
+	/// the macrostates are kept alive so that their addresses are not reused
+	std::map<
+		std::pair<SmallerType, const StateSet*>,
+		std::pair<BiggerType, WitnessNodePtr>
+	> trees_;
+
+public:   // methods
+
+	WitnessRecorder() :
+		trees_()
+	{ }
+
+	/**
+	 * @brief  Creates the tree of a transition of the smaller automaton
+	 *
+	 * The @p i-th subtree is the tree of the pair (@p children[i],
+	 * @p choice(i)).
+	 */
+	template <class ChoiceF>
+	WitnessNodePtr makeTree(
+		SymbolType                                        symbol,
+		const VATA::ExplicitTreeAutCore::StateTuple&      children,
+		const ChoiceF&                                    choice) const
+	{
+		std::shared_ptr<WitnessNode> node(new WitnessNode(symbol));
+
+		for (size_t i = 0; i < children.size(); ++i)
+		{
+			node->children.push_back(this->get(children[i], choice(i)));
+		}
+
+		return node;
+	}
+
+	void record(
+		const SmallerType&      q,
+		const BiggerType&       Q,
+		const WitnessNodePtr&   tree)
+	{
+		trees_.insert(std::make_pair(std::make_pair(q, Q.get()), std::make_pair(Q, tree)));
+	}
+
+	const WitnessNodePtr& get(
+		const SmallerType&      q,
+		const BiggerType&       Q) const
+	{
+		auto it = trees_.find(std::make_pair(q, Q.get()));
+		assert(trees_.end() != it);
+
+		return it->second.second;
+	}
+};
+
+
+/**
+ * @brief  Post(\emptyset): processes leaf transitions
+ *
+ * If @p recorder is not @p nullptr, the trees of the new pairs are recorded
+ * and the counterexample (if found) is stored into @p counterexample.
+ *
+ * @returns  @p false if a counterexample to inclusion is found, @p true
+ *           otherwise
+ */
+template <
+	class Lte,
+	class Gte>
+bool processLeaves(
+	const VATA::SymbolToTransitionListMap&              smallerLeaves,
+	const VATA::ExplicitTreeAutCore::FinalStateSet&     smallerFinalStates,
+	const VATA::SymbolToTransitionListMap&              biggerLeaves,
+	const VATA::ExplicitTreeAutCore::FinalStateSet&     biggerFinalStates,
+	const IndexType&                                    ind,
+	const IndexType&                                    inv,
+	Lte&                                                lte,
+	Gte&                                                gte,
+	BiggerTypeCache&                                    biggerTypeCache,
+	Antichain2C&                                        processed,
+	OrderedType&                                        next,
+	WitnessRecorder*                                    recorder = nullptr,
+	WitnessRecorder::WitnessNodePtr*                    counterexample = nullptr)
+{
+	if ((nullptr == recorder) && (biggerLeaves.size() < smallerLeaves.size()))
+	{	// the counterexample is not known
+		return false;
+	}
+
+	Antichain1C post;
+
+	for (const auto& symbolToTransitions : smallerLeaves)
+	{
+		const auto& symbol = symbolToTransitions.first;
+		bool isAccepting = false;
+		post.clear();
+
+		if (biggerLeaves.count(symbol))
+		{
+			for (auto& transition : biggerLeaves.at(symbol))
+			{
+				assert(transition);
+				assert(transition->children().empty());
+			}
+
+			isAccepting = computePost(biggerLeaves.at(symbol), biggerFinalStates,
+				ind, inv, post);
+		}
+
+		StateSet tmp(post.data().begin(), post.data().end());
+
+		std::sort(tmp.begin(), tmp.end());
+
+		auto ptr = biggerTypeCache.lookup(tmp);
+
+		for (auto& transition : smallerLeaves.at(symbol))
+		{
+			assert(transition);
+
+			if (!isAccepting && smallerFinalStates.count(transition->state()))
+			{
+				if (nullptr != recorder)
+				{
+					*counterexample = WitnessRecorder::WitnessNodePtr(
+						new WitnessRecorder::WitnessNode(symbol));
+				}
+
+				return false;
+			}
+
+			assert(transition->state() < ind.size());
+
+			if (checkIntersection(ind.at(transition->state()), tmp))
+			{
+				continue;
+			}
+
+			if (processed.contains(ind.at(transition->state()), ptr, lte))
+			{
+				continue;
+			}
+
+			if (nullptr != recorder)
+			{
+				recorder->record(transition->state(), ptr,
+					WitnessRecorder::WitnessNodePtr(new WitnessRecorder::WitnessNode(symbol)));
+			}
+
+			assert(transition->state() < inv.size());
+
+			processed.refine(inv.at(transition->state()), ptr, gte, Eraser(next));
+
+			Antichain2C::TList::iterator iter = processed.insert(transition->state(), ptr);
+
+			next.insert(std::make_pair(transition->state(), iter));
+		}
+	}
+
+	return true;
+}
 } // namespace
 
 
@@ -216,7 +476,9 @@ bool VATA::ExplicitUpwardInclusion::checkInternal(
 	const SymbolToDoubleIndexedTransitionListMap&     biggerIndex,
 	const ExplicitTreeAutCore::FinalStateSet&         biggerFinalStates,
 	const StateDiscontBinaryRelation::IndexType&      ind,
-	const StateDiscontBinaryRelation::IndexType&      inv)
+	const StateDiscontBinaryRelation::IndexType&      inv,
+	const CancellationToken*                          cancel,
+	WitnessNodePtr*                                   counterexample)
 {
 	auto noncachedLte = [&ind](const StateSet* x, const StateSet* y) -> bool
 	{
@@ -311,6 +573,12 @@ bool VATA::ExplicitUpwardInclusion::checkInternal(
 		}
 	);
 
+	// the trees reaching the pairs are only recorded if a counterexample is
+	// requested; the recorder holds macrostates of 'biggerTypeCache', so it
+	// is declared (and destroyed) after the cache
+	std::unique_ptr<WitnessRecorder> recorder(
+		(nullptr != counterexample)? new WitnessRecorder() : nullptr);
+
 	Antichain1C post;
 
 	Antichain2C temporary, processed;
@@ -321,76 +589,13 @@ bool VATA::ExplicitUpwardInclusion::checkInternal(
 
 	// Post(\emptyset)
 
-	if (biggerLeaves.size() < smallerLeaves.size())
+	if (!processLeaves(smallerLeaves, smallerFinalStates, biggerLeaves,
+		biggerFinalStates, ind, inv, lte, gte, biggerTypeCache, processed, next,
+		recorder.get(), counterexample))
 	{
 		return false;
 	}
 
-	for (const auto& symbolToTransitions : smallerLeaves)
-	{
-		const auto& symbol = symbolToTransitions.first;
-		post.clear();
-		isAccepting = false;
-		
-		if (biggerLeaves.count(symbol))
-		{
-			for (auto& transition : biggerLeaves.at(symbol))
-			{
-				assert(transition);
-				assert(transition->children().empty());
-				assert(transition->state() < ind.size());
-
-				if (post.contains(ind.at(transition->state())))
-				{
-					continue;
-				}
-
-				assert(transition->state() < inv.size());
-
-				post.refine(inv.at(transition->state()));
-				post.insert(transition->state());
-
-				isAccepting = isAccepting || biggerFinalStates.count(transition->state());
-			}
-		}
-
-		StateSet tmp(post.data().begin(), post.data().end());
-
-		std::sort(tmp.begin(), tmp.end());
-
-		auto ptr = biggerTypeCache.lookup(tmp);
-
-		for (auto& transition : smallerLeaves.at(symbol))
-		{
-			assert(transition);
-
-			if (!isAccepting && smallerFinalStates.count(transition->state()))
-			{
-				return false;
-			}
-
-			assert(transition->state() < ind.size());
-
-			if (checkIntersection(ind.at(transition->state()), tmp))
-			{
-				continue;
-			}
-
-			if (processed.contains(ind.at(transition->state()), ptr, lte))
-			{
-				continue;
-			}
-
-			assert(transition->state() < inv.size());
-
-			processed.refine(inv.at(transition->state()), ptr, gte, Eraser(next));
-
-			Antichain2C::TList::iterator iter = processed.insert(transition->state(), ptr);
-
-			next.insert(std::make_pair(transition->state(), iter));
-		}
-	}
-
 	SmallerType q;
 
 	Antichain2C::TList fixedList(1);
@@ -434,58 +639,30 @@ bool VATA::ExplicitUpwardInclusion::checkInternal(
 
 					do
 					{
-						post.clear();
-						isAccepting = false;
-
-						assert(choiceVector(0));
-
-						auto firstSet = evalTransitions(symbol, 0, choiceVector(0).get());
-
-						assert(firstSet);
-
-						std::list<const Transition*> biggerTransitions(
-							firstSet->begin(), firstSet->end()
-						);
-
-						for (size_t k = 1; k < choiceVector.size(); ++k)
+						if (nullptr != cancel)
 						{
-							assert(choiceVector(k));
-
-							auto transitions = evalTransitions(
-								symbol, k, choiceVector(k).get()
-							);
-
-							assert(transitions);
-
-							intersectionByLookup(biggerTransitions, *transitions);
+							cancel->Poll();
 						}
 
-						for (auto& biggerTransition : biggerTransitions)
-						{
-							assert(biggerTransition);
-							assert(biggerTransition->state() < ind.size());
-
-							if (post.contains(ind.at(biggerTransition->state())))
-							{
-								continue;
-							}
-
-							assert(biggerTransition->state() < inv.size());
-
-							post.refine(inv.at(biggerTransition->state()));
-							post.insert(biggerTransition->state());
+						std::list<const BUTransition*> biggerTransitions =
+							evalChoice(symbol, choiceVector, evalTransitions);
 
-							isAccepting = isAccepting ||
-								biggerFinalStates.count(biggerTransition->state());
-						}
+						isAccepting = computePost(biggerTransitions, biggerFinalStates,
+							ind, inv, post);
 
-						if (post.data().empty())
-						{
+						if (post.data().empty() && !recorder)
+						{	// the counterexample is not known
 							return false;
 						}
 
 						if (!isAccepting && smallerFinalStates.count(smallerTransition->state()))
 						{
+							if (recorder)
+							{
+								*counterexample = recorder->makeTree(
+									symbol, smallerTransition->children(), choiceVector);
+							}
+
 							return false;
 						}
 
@@ -512,6 +689,13 @@ bool VATA::ExplicitUpwardInclusion::checkInternal(
 						temporary.refine(inv.at(smallerTransition->state()), ptr, gte);
 						temporary.insert(smallerTransition->state(), ptr);
 
+						if (recorder)
+						{
+							recorder->record(smallerTransition->state(), ptr,
+								recorder->makeTree(symbol, smallerTransition->children(),
+								choiceVector));
+						}
+
 					} while (choiceVector.next());
 
 					for (auto& smallerBiggerListPair : temporary.data())
@@ -548,3 +732,318 @@ bool VATA::ExplicitUpwardInclusion::checkInternal(
 
 	return true;
 }
+
+
+bool VATA::ExplicitUpwardInclusion::checkInternalParallel(
+	const SymbolToTransitionListMap&                  smallerLeaves,
+	const IndexedSymbolToIndexedTransitionListMap&    smallerIndex,
+	const ExplicitTreeAutCore::FinalStateSet&         smallerFinalStates,
+	const SymbolToTransitionListMap&                  biggerLeaves,
+	const SymbolToDoubleIndexedTransitionListMap&     biggerIndex,
+	const ExplicitTreeAutCore::FinalStateSet&         biggerFinalStates,
+	const StateDiscontBinaryRelation::IndexType&      ind,
+	const StateDiscontBinaryRelation::IndexType&      inv,
+	size_t                                            numThreads,
+	const CancellationToken*                          cancel)
+{
+	numThreads = Util::GetNumThreads(numThreads);
+
+	// the antichain and the cache of comparisons are only used by the merging
+	// thread
+	auto noncachedLte = [&ind](const StateSet* x, const StateSet* y) -> bool
+	{
+		assert(x); assert(y);
+
+		for (auto& s1 : *x)
+		{
+			assert(s1 < ind.size());
+
+			if (!checkIntersection(ind.at(s1), *y))
+			{
+				return false;
+			}
+		}
+
+		return true;
+	};
+
+	Util::CachedBinaryOp<const StateSet*, const StateSet*, bool> lteCache;
+
+	auto lte = [&noncachedLte, &lteCache](const BiggerType& x, const BiggerType& y) -> bool
+	{
+		assert(x); assert(y);
+
+		return (x.get() == y.get())?(true):(lteCache.lookup(x.get(), y.get(), noncachedLte));
+	};
+
+	auto gte = [&lte](const BiggerType& x, const BiggerType& y) { return lte(y, x); };
+
+	typedef std::unordered_set<const BUTransition*> TransitionSet;
+	typedef typename std::shared_ptr<TransitionSet> TransitionSetPtr;
+
+	auto noncachedEvalTransitions = [&biggerIndex](const std::pair<SymbolType, size_t>& key,
+		const StateSet* states) -> TransitionSetPtr
+	{
+		assert(states);
+
+		TransitionSetPtr result = TransitionSetPtr(new TransitionSet());
+
+		if (!biggerIndex.count(key.first))
+		{
+			return result;
+		}
+
+		auto& iter = biggerIndex.at(key.first);
+
+		if (iter.size() <= key.second)
+		{
+			return result;
+		}
+
+		auto& indexedTransitionList = iter[key.second];
+
+		for (auto& state: *states)
+		{
+			if (state >= indexedTransitionList.size())
+			{
+				continue;
+			}
+
+			for (auto& transition : indexedTransitionList.at(state))
+			{
+				result->insert(transition.get());
+			}
+		}
+
+		return result;
+	};
+
+	// the cache of transitions is shared by the workers; it is mostly read,
+	// and the values are computed outside of the lock
+	Util::CachedBinaryOp<
+		std::pair<SymbolType, size_t>, const StateSet*, TransitionSetPtr
+	> evalTransitionsCache;
+	std::mutex evalTransitionsMutex;
+
+	auto evalTransitions = [&noncachedEvalTransitions, &evalTransitionsCache,
+		&evalTransitionsMutex](const SymbolType& symbol, size_t i, const StateSet* states)
+		-> TransitionSetPtr
+	{
+		assert(states);
+
+		const std::pair<SymbolType, size_t> key(symbol, i);
+
+		{
+			std::lock_guard<std::mutex> lock(evalTransitionsMutex);
+			const TransitionSetPtr* cached = evalTransitionsCache.find(key, states);
+			if (nullptr != cached)
+			{
+				return *cached;
+			}
+		}
+
+		TransitionSetPtr result = noncachedEvalTransitions(key, states);
+
+		std::lock_guard<std::mutex> lock(evalTransitionsMutex);
+		return evalTransitionsCache.lookup(key, states,
+			[&result](const std::pair<SymbolType, size_t>&, const StateSet*)
+			{
+				return result;
+			});
+	};
+
+	BiggerTypeCache biggerTypeCache(
+		[&lteCache, &evalTransitionsCache, &evalTransitionsMutex](const StateSet* v)
+		{
+			lteCache.invalidateFirst(v);
+			lteCache.invalidateSecond(v);
+
+			std::lock_guard<std::mutex> lock(evalTransitionsMutex);
+			evalTransitionsCache.invalidateSecond(v);
+		}
+	);
+
+	Antichain2C processed;
+
+	OrderedType next;
+
+	// Post(\emptyset)
+
+	if (!processLeaves(smallerLeaves, smallerFinalStates, biggerLeaves,
+		biggerFinalStates, ind, inv, lte, gte, biggerTypeCache, processed, next))
+	{
+		return false;
+	}
+
+	// a pair of a state of the smaller automaton and a macrostate of the bigger
+	// one, found by a worker
+	typedef std::pair<SmallerType, StateSet> Candidate;
+
+	struct Worker
+	{
+		Antichain1C post;
+		Antichain2C::TList fixedList;
+		ChoiceVector choiceVector;
+
+		explicit Worker(const Antichain2C& processed) :
+			post(),
+			fixedList(1),
+			choiceVector(processed, fixedList)
+		{ }
+	};
+
+	std::vector<std::unique_ptr<Worker>> workers;
+	for (size_t i = 0; i < numThreads; ++i)
+	{
+		workers.push_back(std::unique_ptr<Worker>(new Worker(processed)));
+	}
+
+	// pairs are taken from the smallest macrostates, as in the sequential
+	// version, in rounds of limited size
+	const size_t roundSize = 64 * numThreads;
+
+	std::vector<std::pair<SmallerType, BiggerType>> round;
+	std::vector<std::vector<Candidate>> candidates;
+	std::atomic<bool> counterexample(false);
+
+	while (!next.empty())
+	{
+		round.clear();
+		while (!next.empty() && (round.size() < roundSize))
+		{
+			round.push_back(std::make_pair(next.begin()->first, *next.begin()->second));
+			next.erase(next.begin());
+		}
+
+		candidates.clear();
+		candidates.resize(round.size());
+
+		Util::ParallelWorklist<size_t> worklist(numThreads);
+		for (size_t i = 0; i < round.size(); ++i)
+		{
+			worklist.Push(i % numThreads, i);
+		}
+
+		// the workers only read the antichain of processed pairs
+		worklist.Run([&](size_t workerId, size_t item)
+		{
+			Worker& worker = *workers[workerId];
+
+			const SmallerType q = round[item].first;
+			worker.fixedList.front() = round[item].second;
+
+			assert(q < inv.size());
+
+			if (!smallerIndex.count(q))
+			{
+				return;
+			}
+
+			std::set<Candidate> found;
+
+			for (const auto& symbolToIndexedTrans : smallerIndex.at(q))
+			{
+				const size_t symbol = symbolToIndexedTrans.first;
+				size_t j = 0;
+
+				for (auto& smallerTransitions : symbolToIndexedTrans.second)
+				{
+					for (auto& smallerTransition : smallerTransitions)
+					{
+						assert(smallerTransition);
+
+						if (!worker.choiceVector.build(smallerTransition->children(), j))
+						{
+							continue;
+						}
+
+						do
+						{
+							if (nullptr != cancel)
+							{
+								cancel->Poll();
+							}
+
+							std::list<const BUTransition*> biggerTransitions =
+								evalChoice(symbol, worker.choiceVector, evalTransitions);
+
+							bool isAccepting = computePost(biggerTransitions,
+								biggerFinalStates, ind, inv, worker.post);
+
+							if (worker.post.data().empty() ||
+								(!isAccepting && smallerFinalStates.count(smallerTransition->state())))
+							{
+								counterexample = true;
+								worklist.Stop();
+								return;
+							}
+
+							StateSet tmp(worker.post.data().begin(), worker.post.data().end());
+
+							std::sort(tmp.begin(), tmp.end());
+
+							assert(smallerTransition->state() < ind.size());
+
+							if (checkIntersection(ind.at(smallerTransition->state()), tmp))
+							{
+								continue;
+							}
+
+							found.insert(std::make_pair(smallerTransition->state(), std::move(tmp)));
+
+						} while (worker.choiceVector.next());
+					}
+
+					++j;
+				}
+			}
+
+			candidates[item].assign(found.begin(), found.end());
+		});
+
+		if (counterexample)
+		{
+			return false;
+		}
+
+		// release the pairs of the round before merging, so that macrostates
+		// which are no longer used can be freed
+		for (auto& smallerBiggerPair : round)
+		{
+			smallerBiggerPair.second = BiggerType();
+		}
+
+		for (auto& worker : workers)
+		{
+			worker->fixedList.front() = BiggerType();
+		}
+
+		// merge the found pairs into the antichain in the order of the round
+		for (const std::vector<Candidate>& itemCandidates : candidates)
+		{
+			for (const Candidate& candidate : itemCandidates)
+			{
+				const SmallerType& state = candidate.first;
+
+				auto ptr = biggerTypeCache.lookup(candidate.second);
+
+				assert(state < ind.size());
+
+				if (processed.contains(ind.at(state), ptr, lte))
+				{
+					continue;
+				}
+
+				assert(state < inv.size());
+
+				processed.refine(inv.at(state), ptr, gte, Eraser(next));
+
+				Antichain2C::TList::iterator iter = processed.insert(state, ptr);
+
+				next.insert(std::make_pair(state, iter));
+			}
+		}
+	}
+
+	return true;
+}
@@ -26,29 +26,145 @@ class VATA::ExplicitUpwardInclusion
 
 public:
 
+	/**
+	 * @brief  A node of a counterexample tree
+	 *
+	 * The symbol is the index of the symbol used by the check.
+	 */
+	struct WitnessNode
+	{
+		size_t                                              symbol;
+		std::vector<std::shared_ptr<const WitnessNode>>     children;
+
+		explicit WitnessNode(size_t sym) :
+			symbol(sym),
+			children()
+		{ }
+	};
+
+	using WitnessNodePtr = std::shared_ptr<const WitnessNode>;
+
+	/**
+	 * @brief  Checks language inclusion of two automata
+	 *
+	 * @param[in]  smaller     The smaller automaton
+	 * @param[in]  bigger      The bigger automaton
+	 * @param[in]  preorder    A simulation on the states of both automata
+	 * @param[in]  numThreads  The number of threads (0 denotes the number of
+	 *                         hardware threads)
+	 * @param[in]  cancel      A token cancelling the check (may be @p nullptr)
+	 * @param[out] counterexample  If not @p nullptr and the inclusion does not
+	 *                         hold, a tree of the smaller automaton that is not
+	 *                         accepted by the bigger automaton is added to it
+	 *                         (the check is then sequential)
+	 */
 	template <
 		class Aut,
 		class Rel>
 	static bool Check(
 		const Aut&        smaller,
 		const Aut&        bigger,
-		const Rel&        preorder)
+		const Rel&        preorder,
+		size_t            numThreads = 1,
+		const CancellationToken* cancel = nullptr,
+		ExplicitTreeAutCore*     counterexample = nullptr)
 	{
-		IndexedSymbolToIndexedTransitionListMap smallerIndex;
-		SymbolToDoubleIndexedTransitionListMap biggerIndex;
-		SymbolToTransitionListMap smallerLeaves, biggerLeaves;
+		SmallerIndex smallerIndex;
+
+		ExplicitUpwardInclusion::IndexSmaller(smaller, smallerIndex);
+
+		return ExplicitUpwardInclusion::Check(smallerIndex, smaller, bigger,
+			preorder, numThreads, cancel, counterexample);
+	}
+
+	/**
+	 * @brief  The index of the smaller automaton
+	 *
+	 * The index may be shared by checks of the smaller automaton against
+	 * several bigger automata (also concurrently).
+	 */
+	class SmallerIndex
+	{
+	public:
+
+		IndexedSymbolToIndexedTransitionListMap    index;
+		SymbolToTransitionListMap                  leaves;
+
+		/// the numbering of symbols of the smaller automaton
+		std::unordered_map<SymbolType, size_t>     symbolMap;
+
+	private:
+
+		SmallerIndex(const SmallerIndex&);
+		SmallerIndex& operator=(const SmallerIndex&);
+
+	public:
 
+		SmallerIndex() :
+			index(),
+			leaves(),
+			symbolMap()
+		{ }
+	};
+
+	/**
+	 * @brief  Builds the index of the smaller automaton
+	 */
+	template <
+		class Aut>
+	static void IndexSmaller(
+		const Aut&        smaller,
+		SmallerIndex&     smallerIndex)
+	{
 		size_t symbolCnt = 0;
-		std::unordered_map<typename Aut::SymbolType, size_t> symbolMap;
-		Util::TranslatorWeak2<std::unordered_map<typename Aut::SymbolType, size_t>>
+		Util::TranslatorWeak2<std::unordered_map<SymbolType, size_t>>
 			symbolTranslator(
-				symbolMap,
-				[&symbolCnt](const typename Aut::SymbolType&){ return symbolCnt++; }
+				smallerIndex.symbolMap,
+				[&symbolCnt](const SymbolType&){ return symbolCnt++; }
 			);
 
 		bottomUpIndex(
-			smaller, smallerIndex, smallerLeaves, symbolTranslator
+			smaller, smallerIndex.index, smallerIndex.leaves, symbolTranslator
 		);
+	}
+
+	/**
+	 * @brief  Checks language inclusion using a prebuilt index of the smaller
+	 *         automaton
+	 *
+	 * @param[in]  smallerIndex  The index of @p smaller (see IndexSmaller())
+	 * @param[in]  smaller       The smaller automaton
+	 * @param[in]  bigger        The bigger automaton
+	 * @param[in]  preorder      A simulation on the states of both automata
+	 * @param[in]  numThreads    The number of threads (0 denotes the number of
+	 *                           hardware threads)
+	 * @param[in]  cancel        A token cancelling the check (may be @p nullptr)
+	 * @param[out] counterexample  See the other Check()
+	 */
+	template <
+		class Aut,
+		class Rel>
+	static bool Check(
+		const SmallerIndex&      smallerIndex,
+		const Aut&               smaller,
+		const Aut&               bigger,
+		const Rel&               preorder,
+		size_t                   numThreads = 1,
+		const CancellationToken* cancel = nullptr,
+		ExplicitTreeAutCore*     counterexample = nullptr)
+	{
+		SymbolToDoubleIndexedTransitionListMap biggerIndex;
+		SymbolToTransitionListMap biggerLeaves;
+
+		// symbols of the bigger automaton missing in the smaller one are
+		// numbered after the symbols of the smaller automaton
+		std::unordered_map<SymbolType, size_t> symbolMap = smallerIndex.symbolMap;
+		size_t symbolCnt = symbolMap.size();
+		Util::TranslatorWeak2<std::unordered_map<SymbolType, size_t>>
+			symbolTranslator(
+				symbolMap,
+				[&symbolCnt](const SymbolType&){ return symbolCnt++; }
+			);
 
 		bottomUpIndex2(
 			bigger, biggerIndex, biggerLeaves, symbolTranslator
@@ -59,20 +175,110 @@ public:
 
 		preorder.buildIndex(ind, inv);
 
-		return ExplicitUpwardInclusion::checkInternal(
-			smallerLeaves,
-			smallerIndex,
+		if ((1 != numThreads) && (nullptr == counterexample))
+		{
+			return ExplicitUpwardInclusion::checkInternalParallel(
+				smallerIndex.leaves,
+				smallerIndex.index,
+				smaller.GetFinalStates(),
+				biggerLeaves,
+				biggerIndex,
+				bigger.GetFinalStates(),
+				ind,
+				inv,
+				numThreads,
+				cancel
+			);
+		}
+
+		WitnessNodePtr witness;
+
+		bool result = ExplicitUpwardInclusion::checkInternal(
+			smallerIndex.leaves,
+			smallerIndex.index,
 			smaller.GetFinalStates(),
 			biggerLeaves,
 			biggerIndex,
 			bigger.GetFinalStates(),
 			ind,
-			inv
+			inv,
+			cancel,
+			(nullptr != counterexample)? &witness : nullptr
 		);
+
+		if (!result && (nullptr != counterexample))
+		{
+			assert(nullptr != witness);
+
+			ExplicitUpwardInclusion::AddCounterexample(*witness, symbolMap, *counterexample);
+		}
+
+		return result;
+	}
+
+	/**
+	 * @brief  Adds a counterexample tree to an automaton
+	 *
+	 * The root of the tree gets a final state.
+	 *
+	 * @param[in]  witness    The tree
+	 * @param[in]  symbolMap  The numbering of symbols used in @p witness
+	 * @param[out] aut        The automaton
+	 */
+	static void AddCounterexample(
+		const WitnessNode&                              witness,
+		const std::unordered_map<SymbolType, size_t>&   symbolMap,
+		ExplicitTreeAutCore&                            aut)
+	{
+		std::vector<SymbolType> symbols(symbolMap.size());
+		for (const auto& symbolIndexPair : symbolMap)
+		{
+			assert(symbolIndexPair.second < symbols.size());
+			symbols[symbolIndexPair.second] = symbolIndexPair.first;
+		}
+
+		std::unordered_map<const WitnessNode*, StateType> states;
+		aut.SetStateFinal(ExplicitUpwardInclusion::buildTree(witness, symbols, states, aut));
 	}
 
 private:
 
+	/**
+	 * @brief  Adds the transitions of a counterexample tree to an automaton
+	 *
+	 * Every node of the tree gets a new state (shared subtrees get the same
+	 * state).
+	 *
+	 * @returns  The state of the root of the tree
+	 */
+	static StateType buildTree(
+		const WitnessNode&                                  node,
+		const std::vector<SymbolType>&                      symbols,
+		std::unordered_map<const WitnessNode*, StateType>&  states,
+		ExplicitTreeAutCore&                                aut)
+	{
+		auto it = states.find(&node);
+		if (states.end() != it)
+		{
+			return it->second;
+		}
+
+		StateTuple children;
+		for (const WitnessNodePtr& child : node.children)
+		{
+			assert(nullptr != child);
+			children.push_back(ExplicitUpwardInclusion::buildTree(*child, symbols, states, aut));
+		}
+
+		StateType state = states.size();
+		states.insert(std::make_pair(&node, state));
+
+		assert(node.symbol < symbols.size());
+		aut.AddTransition(children, symbols[node.symbol], state);
+
+		return state;
+	}
+
 	static bool checkInternal(
 		const SymbolToTransitionListMap&                  smallerLeaves,
 		const IndexedSymbolToIndexedTransitionListMap&    smallerIndex,
@@ -81,7 +287,31 @@ private:
 		const SymbolToDoubleIndexedTransitionListMap&     biggerIndex,
 		const ExplicitTreeAutCore::FinalStateSet&         biggerFinalStates,
 		const StateDiscontBinaryRelation::IndexType&      ind,
-		const StateDiscontBinaryRelation::IndexType&      inv
+		const StateDiscontBinaryRelation::IndexType&      inv,
+		const CancellationToken*                          cancel,
+		WitnessNodePtr*                                   counterexample
+	);
+
+	/**
+	 * @brief  The parallel version of checkInternal()
+	 *
+	 * The pairs to be processed are taken in rounds.  In every round, the
+	 * successors of the pairs are computed by several threads, which only read
+	 * the antichain of processed pairs, and the new pairs are then inserted into
+	 * the antichain (with subsumption) by a single thread, in the order of the
+	 * pairs of the round.
+	 */
+	static bool checkInternalParallel(
+		const SymbolToTransitionListMap&                  smallerLeaves,
+		const IndexedSymbolToIndexedTransitionListMap&    smallerIndex,
+		const ExplicitTreeAutCore::FinalStateSet&         smallerFinalStates,
+		const SymbolToTransitionListMap&                  biggerLeaves,
+		const SymbolToDoubleIndexedTransitionListMap&     biggerIndex,
+		const ExplicitTreeAutCore::FinalStateSet&         biggerFinalStates,
+		const StateDiscontBinaryRelation::IndexType&      ind,
+		const StateDiscontBinaryRelation::IndexType&      inv,
+		size_t                                            numThreads,
+		const CancellationToken*                          cancel
 	);
 };
 
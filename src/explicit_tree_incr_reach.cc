@@ -0,0 +1,99 @@
+/*****************************************************************************
+ *  VATA Tree Automata Library
+ *
+ *  Copyright (c) 2015  Ondra Lengal <ilengal@fit.vutbr.cz>
+ *
+ *  Description:
+ *    Implementation of incremental maintenance of productive states of
+ *    explicit tree automata.
+ *
+ *****************************************************************************/
+
+// VATA headers
+#include <vata/vata.hh>
+
+// Standard library headers
+#include <unordered_set>
+
+#include "explicit_tree_aut_core.hh"
+#include "explicit_tree_incr_reach.hh"
+
+using VATA::ExplicitTreeAutCore;
+
+
+void ExplicitTreeAutCore::notifyTransitionAdded(
+	const TuplePtr&           children,
+	const SymbolType&         symbol,
+	const StateType&          parent)
+{
+	assert(nullptr != incrReach_);
+
+	incrReach_->AddTransition(children, symbol, parent, finalStates_);
+}
+
+
+void ExplicitTreeAutCore::notifyFinalStateAdded(
+	const StateType&          state)
+{
+	assert(nullptr != incrReach_);
+
+	incrReach_->AddFinalState(state);
+}
+
+
+void ExplicitTreeAutCore::notifyFinalStatesErased()
+{
+	assert(nullptr != incrReach_);
+
+	incrReach_->ClearFinalStates();
+}
+
+
+void ExplicitTreeAutCore::EnableIncrementalReachability()
+{
+	if (incrReach_)
+	{
+		return;
+	}
+
+	incrReach_ = IncrementalReachabilityPtr(new IncrementalReachability());
+
+	for (auto& stateClusterPair : *this->clusterMap())
+	{
+		assert(stateClusterPair.second);
+
+		for (auto& symbolTupleSetPair : *stateClusterPair.second)
+		{
+			assert(symbolTupleSetPair.second);
+
+			for (auto& tuple : *symbolTupleSetPair.second)
+			{
+				incrReach_->AddTransition(tuple, symbolTupleSetPair.first,
+					stateClusterPair.first, finalStates_);
+			}
+		}
+	}
+}
+
+
+bool ExplicitTreeAutCore::IsStateProductive(
+	const StateType&          state) const
+{
+	if (incrReach_)
+	{
+		return incrReach_->IsProductive(state);
+	}
+
+	std::unordered_set<StateType> reachable;
+	this->computeBottomUpReachable(reachable, false);
+
+	return reachable.cend() != reachable.find(state);
+}
+
+
+bool ExplicitTreeAutCore::isLangEmptyIncremental() const
+{
+	assert(nullptr != incrReach_);
+
+	return incrReach_->IsLangEmpty();
+}
@@ -0,0 +1,196 @@
+/*****************************************************************************
+ *  VATA Tree Automata Library
+ *
+ *  Copyright (c) 2015  Ondra Lengal <ilengal@fit.vutbr.cz>
+ *
+ *  Description:
+ *    Incremental maintenance of productive states of an explicit tree
+ *    automaton.
+ *
+ *****************************************************************************/
+
+#ifndef _VATA_EXPLICIT_TREE_INCR_REACH_HH_
+#define _VATA_EXPLICIT_TREE_INCR_REACH_HH_
+
+// Standard library headers
+#include <algorithm>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "explicit_tree_aut_core.hh"
+#include "util/expl_bu_index.hh"
+
+
+/**
+ * @brief  Set of productive states maintained under addition of transitions
+ *
+ * A state is productive if it is reachable bottom-up, i.e., if its language is
+ * not empty.  Transitions that may still make their parent productive wait in
+ * the bottom-up index (see util/expl_bu_index.hh) under their children that
+ * are not productive yet, together with the number of such children.  When a
+ * state becomes productive, only the transitions waiting for it are updated,
+ * so the total cost is linear in the size of the added transitions.
+ */
+class VATA::ExplicitTreeAutCoreUtil::IncrementalReachability
+{
+private:  // data types
+
+	using TuplePtr         = ExplicitTreeAutCoreUtil::TuplePtr;
+
+	using StateSet         = std::unordered_set<StateType>;
+
+private:  // data members
+
+	/// the productive states
+	StateSet productive_;
+
+	/// the number of productive final states
+	size_t productiveFinal_;
+
+	/// for every state that is not productive the transitions waiting for it
+	std::unordered_map<StateType, TransitionList> waiting_;
+
+	/// for every waiting transition the number of its distinct children that
+	/// are not productive
+	std::unordered_map<const BUIndexTransition*, size_t> remaining_;
+
+private:  // methods
+
+	void makeProductive(
+		const StateType&          state,
+		const FinalStateSet&      finalStates)
+	{
+		if (!productive_.insert(state).second)
+		{
+			return;
+		}
+
+		productiveFinal_ += finalStates.count(state);
+
+		std::vector<StateType> newStates = {state};
+		while (!newStates.empty())
+		{
+			auto it = waiting_.find(newStates.back());
+			newStates.pop_back();
+
+			if (waiting_.end() == it)
+			{
+				continue;
+			}
+
+			TransitionList transitions = std::move(it->second);
+			waiting_.erase(it);
+
+			for (const TransitionPtr& trans : transitions)
+			{
+				auto remIt = remaining_.find(trans.get());
+				assert(remaining_.end() != remIt);
+				assert(0 < remIt->second);
+
+				if (0 != --remIt->second)
+				{
+					continue;
+				}
+
+				remaining_.erase(remIt);
+
+				if (productive_.insert(trans->state()).second)
+				{
+					productiveFinal_ += finalStates.count(trans->state());
+					newStates.push_back(trans->state());
+				}
+			}
+		}
+	}
+
+public:   // methods
+
+	IncrementalReachability() :
+		productive_(),
+		productiveFinal_(0),
+		waiting_(),
+		remaining_()
+	{ }
+
+	/**
+	 * @brief  Adds a transition
+	 *
+	 * @p finalStates are the final states of the automaton, they are used to
+	 * count the productive final states.
+	 */
+	void AddTransition(
+		const TuplePtr&           children,
+		const SymbolType&         symbol,
+		const StateType&          parent,
+		const FinalStateSet&      finalStates)
+	{
+		assert(nullptr != children);
+
+		if (productive_.cend() != productive_.find(parent))
+		{	// the transition cannot change anything
+			return;
+		}
+
+		std::vector<StateType> pending;
+		for (const StateType& child : *children)
+		{
+			if (productive_.cend() == productive_.find(child))
+			{
+				pending.push_back(child);
+			}
+		}
+
+		std::sort(pending.begin(), pending.end());
+		pending.erase(std::unique(pending.begin(), pending.end()), pending.end());
+
+		if (pending.empty())
+		{
+			this->makeProductive(parent, finalStates);
+			return;
+		}
+
+		TransitionPtr trans(new BUIndexTransition(children, symbol, parent));
+		remaining_.insert(std::make_pair(trans.get(), pending.size()));
+
+		for (const StateType& child : pending)
+		{
+			waiting_[child].push_back(trans);
+		}
+	}
+
+	/**
+	 * @brief  Notes that a state became final
+	 *
+	 * Needs to be called only for states that were not final before.
+	 */
+	void AddFinalState(const StateType& state)
+	{
+		productiveFinal_ += productive_.count(state);
+	}
+
+	void ClearFinalStates()
+	{
+		productiveFinal_ = 0;
+	}
+
+	bool IsProductive(const StateType& state) const
+	{
+		return productive_.cend() != productive_.find(state);
+	}
+
+	/**
+	 * @brief  Checks whether no final state is productive
+	 */
+	bool IsLangEmpty() const
+	{
+		return 0 == productiveFinal_;
+	}
+
+	const StateSet& GetProductiveStates() const
+	{
+		return productive_;
+	}
+};
+
+#endif
@@ -12,6 +12,7 @@
 #include <vata/vata.hh>
 
 // Standard library headers
+#include <stdexcept>
 #include <vector>
 
 
@@ -51,6 +52,104 @@ ExplicitTreeAutCore ExplicitTreeAutCore::Intersection(
 
 	auto transitions = res.transitions_;
 
+	if (lhs.frozen_ && rhs.frozen_)
+	{	// both automata are frozen, use the compact storage
+		const FrozenTransitions& lhsFrozen = lhs.frozen_->GetTransitions();
+		const FrozenTransitions& rhsFrozen = rhs.frozen_->GetTransitions();
+
+		ExplicitTreeAutCore::StateTuple children;
+
+		while (!stack.empty())
+		{
+			auto p = stack.back();
+
+			stack.pop_back();
+
+			size_t leftParent = lhsFrozen.FindParent(p->first.first);
+			if (FrozenTransitions::NotFound == leftParent)
+			{
+				continue;
+			}
+
+			size_t rightParent = rhsFrozen.FindParent(p->first.second);
+			if (FrozenTransitions::NotFound == rightParent)
+			{
+				continue;
+			}
+
+			ExplicitTreeAutCore::TransitionClusterPtr cluster(nullptr);
+
+			// symbols of both parents are sorted, so we merge the two ranges
+			size_t leftSym = lhsFrozen.SymbolsBegin(leftParent);
+			size_t leftSymEnd = lhsFrozen.SymbolsEnd(leftParent);
+			size_t rightSym = rhsFrozen.SymbolsBegin(rightParent);
+			size_t rightSymEnd = rhsFrozen.SymbolsEnd(rightParent);
+
+			while ((leftSym < leftSymEnd) && (rightSym < rightSymEnd))
+			{
+				const SymbolType& symbol = lhsFrozen.GetSymbol(leftSym);
+				if (symbol < rhsFrozen.GetSymbol(rightSym))
+				{
+					++leftSym;
+					continue;
+				}
+
+				if (rhsFrozen.GetSymbol(rightSym) < symbol)
+				{
+					++rightSym;
+					continue;
+				}
+
+				if (!cluster)
+				{
+					cluster = transitions->uniqueCluster(p->second);
+				}
+
+				auto tuplePtrSet = cluster->uniqueTuplePtrSet(symbol);
+
+				for (size_t lt = lhsFrozen.TuplesBegin(leftSym);
+					lt < lhsFrozen.TuplesEnd(leftSym); ++lt)
+				{
+					FrozenTransitions::TupleRef leftTuple = lhsFrozen.GetTuple(lt);
+
+					for (size_t rt = rhsFrozen.TuplesBegin(rightSym);
+						rt < rhsFrozen.TuplesEnd(rightSym); ++rt)
+					{
+						FrozenTransitions::TupleRef rightTuple = rhsFrozen.GetTuple(rt);
+
+						assert(leftTuple.size() == rightTuple.size());
+
+						children.clear();
+
+						for (size_t i = 0; i < leftTuple.size(); ++i)
+						{
+							auto u = pTranslMap->insert(
+								std::make_pair(
+									std::make_pair(leftTuple[i], rightTuple[i]),
+									pTranslMap->size()
+								)
+							);
+
+							if (u.second)
+							{
+								stack.push_back(&*u.first);
+							}
+
+							children.push_back(u.first->second);
+						}
+
+						tuplePtrSet->insert(res.tupleLookup(children));
+					}
+				}
+
+				++leftSym;
+				++rightSym;
+			}
+		}
+
+		return res;
+	}
+
 	while (!stack.empty())
 	{
 		auto p = stack.back();
@@ -58,7 +157,7 @@ ExplicitTreeAutCore ExplicitTreeAutCore::Intersection(
 		stack.pop_back();
 
 		auto leftCluster = ExplicitTreeAutCore::genericLookup(
-			*lhs.transitions_, p->first.first);
+			*lhs.clusterMap(), p->first.first);
 
 		if (!leftCluster)
 		{
@@ -66,7 +165,7 @@ ExplicitTreeAutCore ExplicitTreeAutCore::Intersection(
 		}
 
 		auto rightCluster = ExplicitTreeAutCore::genericLookup(
-			*rhs.transitions_, p->first.second);
+			*rhs.clusterMap(), p->first.second);
 
 		if (!rightCluster)
 		{
@@ -129,3 +228,36 @@ ExplicitTreeAutCore ExplicitTreeAutCore::Intersection(
 
 	return res;
 }
+
+
+ExplicitTreeAutCore ExplicitTreeAutCore::Intersection(
+	const ExplicitTreeAutCore&           lhs,
+	const ExplicitTreeAutCore&           rhs,
+	const VATA::IsectParam&              params,
+	VATA::AutBase::ProductTranslMap*     pTranslMap)
+{
+	switch (params.GetAlgorithm())
+	{
+		case IsectParam::e_isect_algorithm::TOP_DOWN:
+		{
+			return ExplicitTreeAutCore::Intersection(lhs, rhs, pTranslMap);
+		}
+
+		case IsectParam::e_isect_algorithm::BOTTOM_UP:
+		{
+			return ExplicitTreeAutCore::IntersectionBU(lhs, rhs, pTranslMap);
+		}
+
+		case IsectParam::e_isect_algorithm::TOP_DOWN_PARALLEL:
+		{
+			return ExplicitTreeAutCore::IntersectionParallel(
+				lhs, rhs, params.GetNumThreads(), pTranslMap);
+		}
+
+		default:
+		{
+			throw std::runtime_error("Invalid intersection algorithm: " +
+				params.toString());
+		}
+	}
+}
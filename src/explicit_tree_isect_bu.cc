@@ -109,7 +109,7 @@ ExplicitTreeAutCore ExplicitTreeAutCore::IntersectionBU(
 		}
 
 		const auto& leftCluster = ExplicitTreeAutCore::genericLookup(
-			*lhs.transitions_, p->first.first);
+			*lhs.clusterMap(), p->first.first);
 
 		if (!leftCluster)
 		{
@@ -117,7 +117,7 @@ ExplicitTreeAutCore ExplicitTreeAutCore::IntersectionBU(
 		}
 
 		const auto& rightCluster = ExplicitTreeAutCore::genericLookup(
-			*rhs.transitions_, p->first.second);
+			*rhs.clusterMap(), p->first.second);
 
 		if (!rightCluster)
 		{
@@ -0,0 +1,356 @@
+/*****************************************************************************
+ *  VATA Tree Automata Library
+ *
+ *  Copyright (c) 2015  Ondra Lengal <ilengal@fit.vutbr.cz>
+ *
+ *  Description:
+ *    Implementation of the on-the-fly check of emptiness of intersection of
+ *    explicit tree automata.
+ *
+ *****************************************************************************/
+
+// VATA headers
+#include <vata/vata.hh>
+#include <vata/util/transl_weak.hh>
+
+// Standard library headers
+#include <vector>
+#include <unordered_map>
+
+#include <boost/functional/hash.hpp>
+
+#include "explicit_tree_aut_core.hh"
+#include "util/expl_bu_index.hh"
+
+using VATA::ExplicitTreeAutCore;
+
+namespace
+{
+	/**
+	 * @brief  Enumerates all combinations of elements of a vector of lists
+	 *
+	 * Calls @p func(combination) for every vector of pointers to elements,
+	 * taking one element from each list (in the order of the lists).  The
+	 * enumeration stops as soon as @p func returns @p true.
+	 *
+	 * @returns  @p true if @p func returned @p true, @p false otherwise
+	 */
+	template <
+		class List,
+		class Func>
+	bool foreachCombination(
+		const std::vector<const List*>&                        lists,
+		std::vector<const typename List::value_type*>&         combination,
+		Func                                                   func)
+	{
+		for (const List* list : lists)
+		{
+			if (list->empty())
+			{
+				return false;
+			}
+		}
+
+		std::vector<size_t> indices(lists.size(), 0);
+		combination.resize(lists.size());
+
+		while (true)
+		{
+			for (size_t i = 0; i < lists.size(); ++i)
+			{
+				combination[i] = &(*lists[i])[indices[i]];
+			}
+
+			if (func(combination))
+			{
+				return true;
+			}
+
+			size_t i = 0;
+			while ((i < lists.size()) && (++indices[i] == lists[i]->size()))
+			{
+				indices[i] = 0;
+				++i;
+			}
+
+			if (lists.size() == i)
+			{
+				return false;
+			}
+		}
+	}
+}
+
+
+bool ExplicitTreeAutCore::IsIntersectionEmpty(
+	const std::vector<const ExplicitTreeAutCore*>&    auts,
+	ExplicitTreeAutCore*                              pWitness)
+{
+	assert(!auts.empty());
+
+	const size_t autCnt = auts.size();
+
+	// the symbols are not translated
+	std::unordered_map<SymbolType, size_t> symbolMap;
+	Util::TranslatorWeak2<std::unordered_map<SymbolType, size_t>>
+		symbolTranslator(symbolMap, [](const SymbolType& sym){ return sym; });
+
+	std::vector<IndexedSymbolToIndexedTransitionListMap> indices(autCnt);
+	std::vector<SymbolToTransitionListMap> leaves(autCnt);
+	for (size_t i = 0; i < autCnt; ++i)
+	{
+		assert(nullptr != auts[i]);
+		bottomUpIndex(*auts[i], indices[i], leaves[i], symbolTranslator);
+	}
+
+	// the transition by which a product state was derived (for the witness)
+	struct ProductTransition
+	{
+		SymbolType symbol_;
+		StateTuple children_;
+	};
+
+	using ProductMap = std::unordered_map<StateTuple, size_t, boost::hash<StateTuple>>;
+
+	ProductMap productMap;
+	std::vector<const StateTuple*> productStates;
+	std::vector<ProductTransition> productTransitions;
+	std::vector<size_t> workset;
+	size_t acceptingState = static_cast<size_t>(-1);
+
+	// returns true if an accepting product state has been derived
+	auto deriveF = [&](
+		StateTuple&&           productState,
+		const SymbolType&      symbol,
+		StateTuple&&           children) -> bool
+	{
+		auto insRes = productMap.insert(
+			std::make_pair(std::move(productState), productStates.size()));
+		if (!insRes.second)
+		{
+			return false;
+		}
+
+		size_t id = insRes.first->second;
+		productStates.push_back(&insRes.first->first);
+		productTransitions.push_back(ProductTransition{symbol, std::move(children)});
+		workset.push_back(id);
+
+		for (size_t i = 0; i < autCnt; ++i)
+		{
+			if (!auts[i]->IsStateFinal(insRes.first->first[i]))
+			{
+				return false;
+			}
+		}
+
+		acceptingState = id;
+		return true;
+	};
+
+	std::vector<const TransitionList*> lists(autCnt);
+	std::vector<const TransitionPtr*> combination;
+
+	// first, process leaves
+	for (const auto& symbolListPair : leaves[0])
+	{
+		bool symbolInAll = true;
+		for (size_t i = 0; i < autCnt; ++i)
+		{
+			auto it = leaves[i].find(symbolListPair.first);
+			if (leaves[i].end() == it)
+			{
+				symbolInAll = false;
+				break;
+			}
+
+			lists[i] = &it->second;
+		}
+
+		if (!symbolInAll)
+		{
+			continue;
+		}
+
+		bool found = foreachCombination(lists, combination,
+			[&](const std::vector<const TransitionPtr*>& transitions) -> bool
+			{
+				StateTuple parent;
+				for (const TransitionPtr* trans : transitions)
+				{
+					parent.push_back((*trans)->state());
+				}
+
+				return deriveF(std::move(parent), symbolListPair.first, StateTuple());
+			});
+
+		if (found)
+		{
+			break;
+		}
+	}
+
+	while ((static_cast<size_t>(-1) == acceptingState) && !workset.empty())
+	{
+		size_t productId = workset.back();
+		workset.pop_back();
+
+		// copy the product state (the vector of product states may be modified)
+		const StateTuple productState = *productStates[productId];
+
+		std::vector<const SymbolToIndexedTransitionListMap*> symbolMaps(autCnt);
+		bool stateInAll = true;
+		for (size_t i = 0; i < autCnt; ++i)
+		{
+			auto it = indices[i].find(productState[i]);
+			if (indices[i].end() == it)
+			{
+				stateInAll = false;
+				break;
+			}
+
+			symbolMaps[i] = &it->second;
+		}
+
+		if (!stateInAll)
+		{
+			continue;
+		}
+
+		for (const auto& symbolIndexedListPair : *symbolMaps[0])
+		{
+			const SymbolType& symbol = symbolIndexedListPair.first;
+
+			std::vector<const IndexedTransitionList*> indexedLists(autCnt);
+			bool symbolInAll = true;
+			for (size_t i = 0; i < autCnt; ++i)
+			{
+				auto it = symbolMaps[i]->find(symbol);
+				if (symbolMaps[i]->end() == it)
+				{
+					symbolInAll = false;
+					break;
+				}
+
+				indexedLists[i] = &it->second;
+			}
+
+			if (!symbolInAll)
+			{
+				continue;
+			}
+
+			for (size_t pos = 0; pos < indexedLists[0]->size(); ++pos)
+			{	// the product state is the child at position 'pos'
+				bool posInAll = true;
+				for (size_t i = 0; i < autCnt; ++i)
+				{
+					if (indexedLists[i]->size() <= pos)
+					{
+						posInAll = false;
+						break;
+					}
+
+					lists[i] = &(*indexedLists[i])[pos];
+				}
+
+				if (!posInAll)
+				{
+					continue;
+				}
+
+				bool found = foreachCombination(lists, combination,
+					[&](const std::vector<const TransitionPtr*>& transitions) -> bool
+					{
+						const size_t arity = (*transitions[0])->children().size();
+
+						StateTuple children;
+						StateTuple componentState(autCnt);
+						for (size_t childPos = 0; childPos < arity; ++childPos)
+						{
+							for (size_t i = 0; i < autCnt; ++i)
+							{
+								const StateTuple& autChildren = (*transitions[i])->children();
+								if (autChildren.size() != arity)
+								{
+									return false;
+								}
+
+								componentState[i] = autChildren[childPos];
+							}
+
+							auto it = productMap.find(componentState);
+							if (productMap.end() == it)
+							{	// the child has not been derived yet
+								return false;
+							}
+
+							children.push_back(it->second);
+						}
+
+						StateTuple parent;
+						for (const TransitionPtr* trans : transitions)
+						{
+							parent.push_back((*trans)->state());
+						}
+
+						return deriveF(std::move(parent), symbol, std::move(children));
+					});
+
+				if (found)
+				{
+					break;
+				}
+			}
+
+			if (static_cast<size_t>(-1) != acceptingState)
+			{
+				break;
+			}
+		}
+	}
+
+	if (static_cast<size_t>(-1) == acceptingState)
+	{
+		return true;
+	}
+
+	if (nullptr != pWitness)
+	{	// reconstruct the witness tree from the transitions of product states
+		ExplicitTreeAutCore witness(*auts[0], false, false);
+		witness.SetStateFinal(acceptingState);
+
+		std::vector<bool> processed(productStates.size(), false);
+		std::vector<size_t> stack = {acceptingState};
+		while (!stack.empty())
+		{
+			size_t state = stack.back();
+			stack.pop_back();
+
+			if (processed[state])
+			{
+				continue;
+			}
+
+			processed[state] = true;
+
+			const ProductTransition& trans = productTransitions[state];
+			witness.AddTransition(trans.children_, trans.symbol_, state);
+			stack.insert(stack.end(), trans.children_.begin(), trans.children_.end());
+		}
+
+		*pWitness = witness;
+	}
+
+	return false;
+}
+
+
+bool ExplicitTreeAutCore::IsIntersectionEmpty(
+	const ExplicitTreeAutCore&           lhs,
+	const ExplicitTreeAutCore&           rhs,
+	ExplicitTreeAutCore*                 pWitness)
+{
+	return ExplicitTreeAutCore::IsIntersectionEmpty(
+		std::vector<const ExplicitTreeAutCore*>({&lhs, &rhs}), pWitness);
+}
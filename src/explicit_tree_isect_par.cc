@@ -0,0 +1,139 @@
+/*****************************************************************************
+ *  VATA Tree Automata Library
+ *
+ *  Copyright (c) 2015  Ondra Lengal <ilengal@fit.vutbr.cz>
+ *
+ *  Description:
+ *    Implementation of parallel Intersection() on explicit tree automata.
+ *
+ *****************************************************************************/
+
+// VATA headers
+#include <vata/vata.hh>
+
+// Standard library headers
+#include <atomic>
+#include <vector>
+
+#include <boost/functional/hash.hpp>
+
+#include "explicit_tree_aut_core.hh"
+#include "util/concurrent_map.hh"
+#include "util/parallel_worklist.hh"
+
+using VATA::ExplicitTreeAutCore;
+
+ExplicitTreeAutCore ExplicitTreeAutCore::IntersectionParallel(
+	const ExplicitTreeAutCore&           lhs,
+	const ExplicitTreeAutCore&           rhs,
+	size_t                               numThreads,
+	VATA::AutBase::ProductTranslMap*     pTranslMap)
+{
+	using StatePair    = std::pair<StateType, StateType>;
+	using ProductState = std::pair<StatePair, StateType>;
+	using ProductMap   = Util::ConcurrentMap<StatePair, StateType, boost::hash<StatePair>>;
+
+	numThreads = Util::GetNumThreads(numThreads);
+
+	ProductMap productMap;
+	std::atomic<StateType> stateCnt(0);
+	auto newStateF = [&stateCnt](){ return stateCnt++; };
+
+	Util::ParallelWorklist<ProductState> worklist(numThreads);
+
+	ExplicitTreeAutCore res(lhs.cache_);
+
+	for (const StateType& s : lhs.finalStates_)
+	{
+		for (const StateType& t : rhs.finalStates_)
+		{
+			StatePair statePair(s, t);
+			auto u = productMap.insert(statePair, newStateF);
+
+			res.SetStateFinal(u.first);
+
+			if (u.second)
+			{
+				worklist.Push(0, std::make_pair(statePair, u.first));
+			}
+		}
+	}
+
+	// transitions are collected separately for every worker (the tuple cache
+	// is not thread-safe) and added to the result at the end
+	std::vector<std::vector<Transition>> workerTransitions(numThreads);
+
+	worklist.Run([&](size_t workerId, const ProductState& p)
+		{
+			auto leftCluster = ExplicitTreeAutCore::genericLookup(
+				*lhs.clusterMap(), p.first.first);
+
+			if (!leftCluster)
+			{
+				return;
+			}
+
+			auto rightCluster = ExplicitTreeAutCore::genericLookup(
+				*rhs.clusterMap(), p.first.second);
+
+			if (!rightCluster)
+			{
+				return;
+			}
+
+			std::vector<Transition>& transitions = workerTransitions[workerId];
+
+			for (auto& leftSymbolStateTupleSetPtr : *leftCluster)
+			{
+				auto rightTupleSet =
+					ExplicitTreeAutCore::genericLookup(
+						*rightCluster, leftSymbolStateTupleSetPtr.first);
+
+				if (!rightTupleSet)
+				{
+					continue;
+				}
+
+				for (auto& leftTuplePtr : *leftSymbolStateTupleSetPtr.second)
+				{
+					for (auto& rightTuplePtr : *rightTupleSet)
+					{
+						assert(leftTuplePtr->size() == rightTuplePtr->size());
+
+						StateTuple children;
+
+						for (size_t i = 0; i < leftTuplePtr->size(); ++i)
+						{
+							StatePair statePair((*leftTuplePtr)[i], (*rightTuplePtr)[i]);
+							auto u = productMap.insert(statePair, newStateF);
+
+							if (u.second)
+							{
+								worklist.Push(workerId, std::make_pair(statePair, u.first));
+							}
+
+							children.push_back(u.first);
+						}
+
+						transitions.push_back(Transition(
+							p.second, leftSymbolStateTupleSetPtr.first, children));
+					}
+				}
+			}
+		});
+
+	for (const std::vector<Transition>& transitions : workerTransitions)
+	{
+		res.AddTransitions(transitions);
+	}
+
+	if (nullptr != pTranslMap)
+	{
+		productMap.foreach([pTranslMap](const StatePair& key, const StateType& value)
+			{
+				pTranslMap->insert(std::make_pair(key, value));
+			});
+	}
+
+	return res;
+}
@@ -0,0 +1,294 @@
+/*****************************************************************************
+ *  VATA Tree Automata Library
+ *
+ *  Copyright (c) 2015  Ondra Lengal <ilengal@fit.vutbr.cz>
+ *
+ *  Description:
+ *    Implementation of Minimize() on explicit tree automata.
+ *
+ *****************************************************************************/
+
+// VATA headers
+#include <vata/vata.hh>
+
+// Standard library headers
+#include <cassert>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+
+#include <boost/functional/hash.hpp>
+
+#include "explicit_tree_aut_core.hh"
+#include "util/refinable_partition.hh"
+
+using VATA::ExplicitTreeAutCore;
+using VATA::Util::RefinablePartition;
+
+
+ExplicitTreeAutCore ExplicitTreeAutCore::Minimize() const
+{
+	// check that the automaton is deterministic
+	std::unordered_map<std::pair<SymbolType, const StateTuple*>, StateType,
+		boost::hash<std::pair<SymbolType, const StateTuple*>>> lhsToParent;
+	for (const auto& stateClusterPair : *this->clusterMap())
+	{
+		assert(stateClusterPair.second);
+
+		for (const auto& symbolTupleSetPair : *stateClusterPair.second)
+		{
+			assert(symbolTupleSetPair.second);
+
+			for (const TuplePtr& tuple : *symbolTupleSetPair.second)
+			{
+				auto insRes = lhsToParent.insert(std::make_pair(
+					std::make_pair(symbolTupleSetPair.first, tuple.get()),
+					stateClusterPair.first));
+				if (!insRes.second && (insRes.first->second != stateClusterPair.first))
+				{
+					throw std::runtime_error(
+						"Minimize(): the automaton is not deterministic");
+				}
+			}
+		}
+	}
+
+	// in a trimmed automaton, no state is equivalent to the (implicit) sink
+	// state, so missing transitions distinguish states
+	ExplicitTreeAutCore trimmed = this->RemoveUselessStates();
+
+	ExplicitTreeAutCore res(*this, false, false);
+
+	// assign consecutive numbers to states
+	std::unordered_map<StateType, size_t> stateIndex;
+	auto indexF = [&stateIndex](const StateType& state) -> size_t
+	{
+		return stateIndex.insert(std::make_pair(state, stateIndex.size())).first->second;
+	};
+
+	struct IndexedTransition
+	{
+		SymbolType symbol_;
+		std::vector<size_t> children_;
+		size_t parent_;
+	};
+
+	std::vector<IndexedTransition> transitions;
+	for (const auto& stateClusterPair : *trimmed.clusterMap())
+	{
+		for (const auto& symbolTupleSetPair : *stateClusterPair.second)
+		{
+			for (const TuplePtr& tuple : *symbolTupleSetPair.second)
+			{
+				std::vector<size_t> children;
+				for (const StateType& child : *tuple)
+				{
+					children.push_back(indexF(child));
+				}
+
+				transitions.push_back(IndexedTransition{
+					symbolTupleSetPair.first, std::move(children),
+					indexF(stateClusterPair.first)});
+			}
+		}
+	}
+
+	const size_t stateCnt = stateIndex.size();
+	if (0 == stateCnt)
+	{
+		return res;
+	}
+
+	// Minimization is reduced to the minimization of a partial DFA: a context
+	// of a transition at position i (the symbol, i, and the other children as
+	// states) is a letter, read on the edge from the i-th child to the parent.
+	// Two states are equivalent iff they agree on finality and every context
+	// is either undefined for both of them or leads them to equivalent
+	// states.  Using states (not blocks) of the other children makes the
+	// letters independent of the partition, so Hopcroft's "skip the larger
+	// part" rule is sound.
+	std::unordered_map<std::vector<size_t>, size_t,
+		boost::hash<std::vector<size_t>>> contextIndex;
+	std::vector<size_t> edgeSource;
+	std::vector<size_t> edgeTarget;
+	std::vector<size_t> edgeLabel;
+	for (const IndexedTransition& trans : transitions)
+	{
+		std::vector<size_t> context;
+		context.reserve(trans.children_.size() + 2);
+		context.push_back(trans.symbol_);
+		context.push_back(0);
+		context.insert(context.end(), trans.children_.begin(), trans.children_.end());
+
+		for (size_t pos = 0; pos < trans.children_.size(); ++pos)
+		{
+			context[1] = pos;
+			context[pos + 2] = stateCnt;
+			edgeLabel.push_back(contextIndex.insert(
+				std::make_pair(context, contextIndex.size())).first->second);
+			context[pos + 2] = trans.children_[pos];
+
+			edgeSource.push_back(trans.children_[pos]);
+			edgeTarget.push_back(trans.parent_);
+		}
+	}
+
+	const size_t edgeCnt = edgeLabel.size();
+
+	// incoming edges of states
+	std::vector<size_t> inFirst(stateCnt + 1, 0);
+	std::vector<size_t> inEdges(edgeCnt);
+	for (size_t edge = 0; edge < edgeCnt; ++edge)
+	{
+		++inFirst[edgeTarget[edge] + 1];
+	}
+
+	for (size_t state = 0; state < stateCnt; ++state)
+	{
+		inFirst[state + 1] += inFirst[state];
+	}
+
+	{
+		std::vector<size_t> inNext(inFirst.begin(), inFirst.end() - 1);
+		for (size_t edge = 0; edge < edgeCnt; ++edge)
+		{
+			inEdges[inNext[edgeTarget[edge]]++] = edge;
+		}
+	}
+
+	// the initial partition distinguishes final and non-final states, and
+	// edges are partitioned into cords according to their labels
+	std::vector<std::vector<size_t>> initBlocks(2);
+	for (const auto& stateIndexPair : stateIndex)
+	{
+		initBlocks[trimmed.IsStateFinal(stateIndexPair.first)? 0 : 1].push_back(
+			stateIndexPair.second);
+	}
+
+	std::vector<std::vector<size_t>> initCords(contextIndex.size());
+	for (size_t edge = 0; edge < edgeCnt; ++edge)
+	{
+		initCords[edgeLabel[edge]].push_back(edge);
+	}
+
+	RefinablePartition blocks(initBlocks, stateCnt);
+	RefinablePartition cords(initCords, edgeCnt);
+
+	// Blocks split blocks and cords split cords: a cord is split according to
+	// the blocks of the targets of its edges, and a block according to whether
+	// its states are sources of edges of a cord.  Once a set has been used as a
+	// splitter, it suffices to use the smaller part when it is split, as the
+	// other part is then determined (for a cord, thanks to determinism, every
+	// source has a single edge in the cord).
+	std::vector<size_t> blockSplitters;
+	std::vector<bool> isBlockSplitter(blocks.sets(), false);
+	if (2 == blocks.sets())
+	{
+		blockSplitters.push_back((blocks.size(0) <= blocks.size(1))? 0 : 1);
+		isBlockSplitter[blockSplitters.back()] = true;
+	}
+
+	std::vector<size_t> cordSplitters;
+	std::vector<bool> isCordSplitter(cords.sets(), true);
+	for (size_t cord = 0; cord < cords.sets(); ++cord)
+	{
+		cordSplitters.push_back(cord);
+	}
+
+	auto newSetF = [](const RefinablePartition& partition,
+		std::vector<size_t>& splitters, std::vector<bool>& isSplitter,
+		size_t oldSet, size_t newSet)
+	{
+		assert(isSplitter.size() == newSet);
+
+		if (isSplitter[oldSet])
+		{
+			isSplitter.push_back(true);
+			splitters.push_back(newSet);
+		}
+		else
+		{
+			const bool newSmaller = partition.size(newSet) <= partition.size(oldSet);
+			isSplitter.push_back(newSmaller);
+			isSplitter[oldSet] = !newSmaller;
+			splitters.push_back(newSmaller? newSet : oldSet);
+		}
+	};
+
+	auto newBlockF = [&](size_t oldBlock, size_t newBlock)
+	{
+		newSetF(blocks, blockSplitters, isBlockSplitter, oldBlock, newBlock);
+	};
+
+	auto newCordF = [&](size_t oldCord, size_t newCord)
+	{
+		newSetF(cords, cordSplitters, isCordSplitter, oldCord, newCord);
+	};
+
+	while (!blockSplitters.empty() || !cordSplitters.empty())
+	{
+		if (!blockSplitters.empty())
+		{
+			const size_t splitter = blockSplitters.back();
+			blockSplitters.pop_back();
+			isBlockSplitter[splitter] = false;
+
+			for (const size_t* it = blocks.begin(splitter); it != blocks.end(splitter); ++it)
+			{
+				for (size_t i = inFirst[*it]; i < inFirst[*it + 1]; ++i)
+				{
+					cords.mark(inEdges[i]);
+				}
+			}
+
+			cords.split(newCordF);
+		}
+		else
+		{
+			const size_t splitter = cordSplitters.back();
+			cordSplitters.pop_back();
+			isCordSplitter[splitter] = false;
+
+			for (const size_t* it = cords.begin(splitter); it != cords.end(splitter); ++it)
+			{
+				blocks.mark(edgeSource[*it]);
+			}
+
+			blocks.split(newBlockF);
+		}
+	}
+
+	std::vector<size_t> blockOf(stateCnt);
+	for (size_t state = 0; state < stateCnt; ++state)
+	{
+		blockOf[state] = blocks.setOf(state);
+	}
+
+	// build the quotient automaton
+	std::vector<Transition> quotientTransitions;
+	quotientTransitions.reserve(transitions.size());
+	for (const IndexedTransition& trans : transitions)
+	{
+		StateTuple children;
+		for (size_t child : trans.children_)
+		{
+			children.push_back(blockOf[child]);
+		}
+
+		quotientTransitions.push_back(
+			Transition(blockOf[trans.parent_], trans.symbol_, children));
+	}
+
+	res.AddTransitions(quotientTransitions);
+
+	for (const StateType& state : trimmed.GetFinalStates())
+	{
+		auto it = stateIndex.find(state);
+		if (stateIndex.end() != it)
+		{
+			res.SetStateFinal(blockOf[it->second]);
+		}
+	}
+
+	return res;
+}
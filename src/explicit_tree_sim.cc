@@ -13,6 +13,7 @@
 #include <vata/aut_base.hh>
 
 #include "explicit_tree_aut_core.hh"
+#include "explicit_tree_sim_cache.hh"
 #include "explicit_tree_transl.hh"
 
 using VATA::AutBase;
@@ -20,10 +21,50 @@ using VATA::ExplicitTreeAutCore;
 
 using StateBinaryRelation  = AutBase::StateBinaryRelation;
 using StateDiscontBinaryRelation  = AutBase::StateDiscontBinaryRelation;
+using StateSparseDiscontBinaryRelation  = AutBase::StateSparseDiscontBinaryRelation;
+
+
+void ExplicitTreeAutCore::EnableSimulationCache()
+{
+	if (!simCache_)
+	{
+		simCache_ = SimulationCachePtr(new SimulationCache());
+	}
+}
+
+
+void ExplicitTreeAutCore::clearSimulationCache()
+{
+	if (simCache_)
+	{
+		simCache_->Clear();
+	}
+}
 
 
 StateDiscontBinaryRelation ExplicitTreeAutCore::ComputeSimulation(
 	const VATA::SimParam&                  params) const
+{
+	if (!simCache_)
+	{
+		return this->computeSimulationUncached(params);
+	}
+
+	SimulationCache::SimulationPtr sim =
+		simCache_->FindSimulation(params, this->clusterMap());
+	if (!sim)
+	{
+		sim = SimulationCache::SimulationPtr(
+			new StateDiscontBinaryRelation(this->computeSimulationUncached(params)));
+		simCache_->StoreSimulation(params, this->clusterMap(), sim);
+	}
+
+	return *sim;
+}
+
+
+StateDiscontBinaryRelation ExplicitTreeAutCore::computeSimulationUncached(
+	const VATA::SimParam&                  params) const
 {
 	switch (params.GetRelation())
 	{
@@ -49,7 +90,8 @@ StateDiscontBinaryRelation ExplicitTreeAutCore::ComputeUpwardSimulation(
 	assert(SimParam::e_sim_relation::TA_UPWARD == params.GetRelation());
 	if (params.GetNumStates() != static_cast<size_t>(-1))
 	{
-		return this->ComputeUpwardSimulation(params.GetNumStates());
+		return this->ComputeUpwardSimulation(
+			params.GetNumStates(), params.GetNumThreads(), params.GetCancellationToken());
 	}
 	else
 	{
@@ -59,7 +101,9 @@ StateDiscontBinaryRelation ExplicitTreeAutCore::ComputeUpwardSimulation(
 
 
 StateDiscontBinaryRelation ExplicitTreeAutCore::ComputeUpwardSimulation(
-	size_t                                 size) const
+	size_t                                 size,
+	size_t                                 numThreads,
+	const CancellationToken*               cancel) const
 {
 	std::vector<std::vector<size_t>> partition;
 
@@ -71,7 +115,8 @@ StateDiscontBinaryRelation ExplicitTreeAutCore::ComputeUpwardSimulation(
 		{return stateCnt++;});
 
 	ExplicitLTS lts = this->TranslateUpward(partition, relation, VATA::Util::Identity(size), transl);
-	StateBinaryRelation ltsSim = lts.computeSimulation(partition, relation, size);
+	StateBinaryRelation ltsSim =
+		lts.computeSimulation(partition, relation, size, numThreads, cancel);
 	return StateDiscontBinaryRelation(ltsSim, translMap);
 }
 
@@ -82,7 +127,8 @@ StateDiscontBinaryRelation ExplicitTreeAutCore::ComputeDownwardSimulation(
 	assert(SimParam::e_sim_relation::TA_DOWNWARD == params.GetRelation());
 	if (params.GetNumStates() != static_cast<size_t>(-1))
 	{
-		return this->ComputeDownwardSimulation(params.GetNumStates());
+		return this->ComputeDownwardSimulation(
+			params.GetNumStates(), params.GetNumThreads(), params.GetCancellationToken());
 	}
 	else
 	{
@@ -93,7 +139,9 @@ StateDiscontBinaryRelation ExplicitTreeAutCore::ComputeDownwardSimulation(
 
 
 StateDiscontBinaryRelation ExplicitTreeAutCore::ComputeDownwardSimulation(
-	size_t                                 size) const
+	size_t                                 size,
+	size_t                                 numThreads,
+	const CancellationToken*               cancel) const
 {
 	StateToStateMap translMap;
 	size_t stateCnt = 0;
@@ -101,6 +149,187 @@ StateDiscontBinaryRelation ExplicitTreeAutCore::ComputeDownwardSimulation(
 		{return stateCnt++;});
 
 	ExplicitLTS lts = this->TranslateDownward(size, transl);
-	StateBinaryRelation ltsSim = lts.computeSimulation(size);
+	StateBinaryRelation ltsSim = lts.computeSimulation(size, numThreads, cancel);
 	return StateDiscontBinaryRelation(ltsSim, translMap);
 }
+
+
+StateSparseDiscontBinaryRelation ExplicitTreeAutCore::ComputeSparseSimulation(
+	const SimParam&                        params) const
+{
+	if (!simCache_)
+	{
+		return this->computeSparseSimulationUncached(params);
+	}
+
+	SimulationCache::SparseSimulationPtr sim =
+		simCache_->FindSparseSimulation(params, this->clusterMap());
+	if (!sim)
+	{
+		sim = SimulationCache::SparseSimulationPtr(new StateSparseDiscontBinaryRelation(
+			this->computeSparseSimulationUncached(params)));
+		simCache_->StoreSparseSimulation(params, this->clusterMap(), sim);
+	}
+
+	return *sim;
+}
+
+
+StateSparseDiscontBinaryRelation ExplicitTreeAutCore::computeSparseSimulationUncached(
+	const SimParam&                        params) const
+{
+	if (params.GetNumStates() == static_cast<size_t>(-1))
+	{
+		throw NotImplementedException(__func__);
+	}
+
+	const size_t size = params.GetNumStates();
+
+	StateToStateMap translMap;
+	size_t stateCnt = 0;
+	StateToStateTranslWeak transl(translMap, [&stateCnt](const StateType&)
+		{return stateCnt++;});
+
+	switch (params.GetRelation())
+	{
+		case SimParam::e_sim_relation::TA_UPWARD:
+		{
+			std::vector<std::vector<size_t>> partition;
+			AutBase::StateBinaryRelation relation;
+
+			ExplicitLTS lts = this->TranslateUpward(
+				partition, relation, VATA::Util::Identity(size), transl);
+			return StateSparseDiscontBinaryRelation(
+				lts.computeSparseSimulation(
+					partition, relation, size, params.GetNumThreads(),
+					params.GetCancellationToken()),
+				translMap);
+		}
+		case SimParam::e_sim_relation::TA_DOWNWARD:
+		{
+			ExplicitLTS lts = this->TranslateDownward(size, transl);
+			return StateSparseDiscontBinaryRelation(
+				lts.computeSparseSimulation(
+					size, params.GetNumThreads(), params.GetCancellationToken()),
+				translMap);
+		}
+		default:
+		{
+			throw std::runtime_error("Unknown simulation parameters: " + params.toString());
+		}
+	}
+}
+
+
+ExplicitTreeAutCore ExplicitTreeAutCore::reduceWithBisimulation(
+	const CancellationToken*      cancel) const
+{
+	size_t stateCnt = 0;
+	StateToStateMap stateMap;
+	StateToStateTranslWeak stateTranslator(stateMap, [&stateCnt](const StateType&)
+		{return stateCnt++;});
+
+	this->BuildStateIndex(stateTranslator);
+
+	ExplicitLTS lts = this->TranslateDownward(stateCnt, stateTranslator);
+
+	// states of the LTS standing for tuples are never bisimilar to states of
+	// the automaton
+	std::vector<std::vector<size_t>> partition(2);
+	for (size_t i = 0; i < lts.states(); ++i)
+	{
+		partition[(i < stateCnt)? 0 : 1].push_back(i);
+	}
+
+	std::vector<size_t> classOf = lts.computeBisimulation(partition, cancel);
+
+	std::unordered_map<size_t, StateType> classRepr;
+	StateToStateMap collapseMap;
+	for (const auto& stateIndexPair : stateMap)
+	{
+		assert(stateIndexPair.second < stateCnt);
+
+		collapseMap[stateIndexPair.first] = classRepr.insert(std::make_pair(
+			classOf[stateIndexPair.second], stateIndexPair.first)).first->second;
+	}
+
+	ExplicitTreeAutCore aut = this->CollapseStates(collapseMap);
+
+	return aut.RemoveUnreachableStates();
+}
+
+StateDiscontBinaryRelation ExplicitTreeAutCore::computeInclusionSimulation(
+	const ExplicitTreeAutCore&             smaller,
+	const VATA::InclParam&                 params) const
+{
+	ExplicitTreeAutCore unionAut = ExplicitTreeAutCore::UnionDisjointStates(smaller, *this);
+
+	StateType maxState = 0;
+	for (const StateType& state : unionAut.GetUsedStates())
+	{
+		maxState = std::max(maxState, state);
+	}
+
+	SimParam sp;
+	sp.SetRelation((InclParam::e_direction::upward == params.GetDirection())?
+		SimParam::e_sim_relation::TA_UPWARD : SimParam::e_sim_relation::TA_DOWNWARD);
+	sp.SetNumStates(maxState + 1);
+	sp.SetCancellationToken(params.GetCancellationToken());
+
+	return unionAut.computeSimulationUncached(sp);
+}
+
+
+ExplicitTreeAutCore::InclusionSimulationPtr ExplicitTreeAutCore::getInclusionSimulation(
+	const ExplicitTreeAutCore&             smaller,
+	const VATA::InclParam&                 params) const
+{
+	const SimParam::e_sim_relation relation =
+		(InclParam::e_direction::upward == params.GetDirection())?
+		SimParam::e_sim_relation::TA_UPWARD : SimParam::e_sim_relation::TA_DOWNWARD;
+
+	InclusionSimulationPtr inclSim;
+	if (simCache_)
+	{
+		inclSim = simCache_->FindInclusionSimulation(relation, this->clusterMap(),
+			finalStates_, smaller.clusterMap(), smaller.finalStates_);
+	}
+
+	if (inclSim)
+	{
+		return inclSim;
+	}
+
+	ExplicitTreeAutCore newSmaller = smaller;
+	ExplicitTreeAutCore newBigger = *this;
+
+	AutBase::SanitizeAutsForInclusion(newSmaller, newBigger);
+
+	// sanitization creates new automata, keep them frozen if the input was
+	if (smaller.IsFrozen())
+	{
+		newSmaller.Freeze();
+	}
+
+	if (this->IsFrozen())
+	{
+		newBigger.Freeze();
+	}
+
+	StateDiscontBinaryRelation sim;
+	if (!newSmaller.GetTransitions()->empty())
+	{	// otherwise, the inclusion holds trivially
+		sim = newBigger.computeInclusionSimulation(newSmaller, params);
+	}
+
+	inclSim = InclusionSimulationPtr(new InclusionSimulation{
+		std::move(newSmaller), std::move(newBigger), std::move(sim)});
+
+	if (simCache_)
+	{
+		simCache_->StoreInclusionSimulation(relation, this->clusterMap(), finalStates_,
+			smaller.clusterMap(), smaller.finalStates_, inclSim);
+	}
+
+	return inclSim;
+}
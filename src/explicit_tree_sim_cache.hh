@@ -0,0 +1,280 @@
+/*****************************************************************************
+ *  VATA Tree Automata Library
+ *
+ *  Copyright (c) 2015  Ondra Lengal <ilengal@fit.vutbr.cz>
+ *
+ *  Description:
+ *    Cache of simulations computed on an explicit tree automaton.
+ *
+ *****************************************************************************/
+
+#ifndef _VATA_EXPLICIT_TREE_SIM_CACHE_HH_
+#define _VATA_EXPLICIT_TREE_SIM_CACHE_HH_
+
+// VATA headers
+#include <vata/aut_base.hh>
+#include <vata/sim_param.hh>
+
+// Standard library headers
+#include <map>
+#include <memory>
+#include <mutex>
+#include <tuple>
+
+#include "explicit_tree_aut_core.hh"
+
+
+/**
+ * @brief  Sanitized automata for inclusion checking and their simulation
+ */
+struct VATA::ExplicitTreeAutCoreUtil::InclusionSimulation
+{
+	using StateDiscontBinaryRelation = AutBase::StateDiscontBinaryRelation;
+
+	ExplicitTreeAutCore smaller;
+	ExplicitTreeAutCore bigger;
+	StateDiscontBinaryRelation sim;
+};
+
+
+/**
+ * @brief  Simulations computed on an automaton with given transitions
+ *
+ * A simulation is stored under its relation, the number of states, and the
+ * transitions it was computed for.  The stored pointers to transitions keep the
+ * transitions alive, so the owner needs to call Clear() before modifying its
+ * own transitions or final states.
+ *
+ * Simulations used for inclusion checking are computed on the union of the
+ * sanitized automaton and another sanitized (smaller) automaton, so they are
+ * stored together with the sanitized automata, and they are valid only for the
+ * transitions and final states of both automata they were computed for.  Only
+ * the last such simulation is kept for every relation, so that checking
+ * inclusion of many automata (e.g., in a fixpoint computation) does not fill
+ * the cache.  The transitions of the other automaton are referenced weakly, so
+ * the cache neither keeps them alive nor makes the other automaton copy them
+ * on its next modification.
+ *
+ * The cache may be accessed from several threads.
+ */
+class VATA::ExplicitTreeAutCoreUtil::SimulationCache
+{
+public:   // data types
+
+	using StateDiscontBinaryRelation       = AutBase::StateDiscontBinaryRelation;
+	using StateSparseDiscontBinaryRelation = AutBase::StateSparseDiscontBinaryRelation;
+
+	using TransitionsPtr     = std::shared_ptr<StateToTransitionClusterMap>;
+
+	using SimulationPtr      = std::shared_ptr<const StateDiscontBinaryRelation>;
+	using SparseSimulationPtr= std::shared_ptr<const StateSparseDiscontBinaryRelation>;
+
+	using InclusionSimulationPtr = ExplicitTreeAutCoreUtil::InclusionSimulationPtr;
+
+private:  // data types
+
+	using Key = std::tuple<
+		SimParam::e_sim_relation,
+		size_t,
+		const StateToTransitionClusterMap*>;
+
+	template <class RelPtr>
+	struct Entry
+	{
+		TransitionsPtr transitions;
+		RelPtr sim;
+
+		Entry(
+			const TransitionsPtr&   transitions = TransitionsPtr(),
+			const RelPtr&           sim = RelPtr()) :
+			transitions(transitions),
+			sim(sim)
+		{ }
+	};
+
+	template <class RelPtr>
+	using EntryMap = std::map<Key, Entry<RelPtr>>;
+
+	struct InclusionEntry
+	{
+		TransitionsPtr transitions;
+		std::weak_ptr<StateToTransitionClusterMap> partnerTransitions;
+		FinalStateSet finalStates;
+		FinalStateSet partnerFinalStates;
+		InclusionSimulationPtr sim;
+
+		InclusionEntry(
+			const TransitionsPtr&          transitions = TransitionsPtr(),
+			const TransitionsPtr&          partnerTransitions = TransitionsPtr(),
+			const FinalStateSet&           finalStates = FinalStateSet(),
+			const FinalStateSet&           partnerFinalStates = FinalStateSet(),
+			const InclusionSimulationPtr&  sim = InclusionSimulationPtr()) :
+			transitions(transitions),
+			partnerTransitions(partnerTransitions),
+			finalStates(finalStates),
+			partnerFinalStates(partnerFinalStates),
+			sim(sim)
+		{ }
+	};
+
+private:  // data members
+
+	mutable std::mutex mutex_;
+
+	EntryMap<SimulationPtr> sims_;
+
+	EntryMap<SparseSimulationPtr> sparseSims_;
+
+	/// the last simulation for inclusion checking for every relation
+	std::map<SimParam::e_sim_relation, InclusionEntry> inclSims_;
+
+private:  // methods
+
+	static Key makeKey(
+		const SimParam&             params,
+		const TransitionsPtr&       transitions)
+	{
+		return Key(params.GetRelation(), params.GetNumStates(), transitions.get());
+	}
+
+	template <class RelPtr>
+	RelPtr find(
+		const EntryMap<RelPtr>&     entries,
+		const SimParam&             params,
+		const TransitionsPtr&       transitions) const
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+
+		auto it = entries.find(makeKey(params, transitions));
+		if (entries.end() == it)
+		{
+			return RelPtr();
+		}
+
+		return it->second.sim;
+	}
+
+	template <class RelPtr>
+	void store(
+		EntryMap<RelPtr>&           entries,
+		const SimParam&             params,
+		const TransitionsPtr&       transitions,
+		const RelPtr&               sim)
+	{
+		assert(nullptr != sim);
+
+		std::lock_guard<std::mutex> lock(mutex_);
+
+		entries[makeKey(params, transitions)] = Entry<RelPtr>(transitions, sim);
+	}
+
+public:   // methods
+
+	SimulationCache() :
+		mutex_(),
+		sims_(),
+		sparseSims_(),
+		inclSims_()
+	{ }
+
+	/**
+	 * @brief  Looks up a simulation
+	 *
+	 * @param[in]  params       Parameters of the simulation
+	 * @param[in]  transitions  Transitions of the automaton
+	 *
+	 * @returns  The simulation or @p nullptr if it is not in the cache
+	 */
+	SimulationPtr FindSimulation(
+		const SimParam&             params,
+		const TransitionsPtr&       transitions) const
+	{
+		return this->find(sims_, params, transitions);
+	}
+
+	void StoreSimulation(
+		const SimParam&             params,
+		const TransitionsPtr&       transitions,
+		const SimulationPtr&        sim)
+	{
+		this->store(sims_, params, transitions, sim);
+	}
+
+	/**
+	 * @brief  Looks up a simulation for inclusion checking
+	 *
+	 * @param[in]  relation            The relation of the simulation
+	 * @param[in]  transitions         Transitions of the (bigger) automaton
+	 * @param[in]  finalStates         Final states of the automaton
+	 * @param[in]  partnerTransitions  Transitions of the smaller automaton
+	 * @param[in]  partnerFinalStates  Final states of the smaller automaton
+	 *
+	 * @returns  The sanitized automata with their simulation or @p nullptr if
+	 *           they are not in the cache
+	 */
+	InclusionSimulationPtr FindInclusionSimulation(
+		SimParam::e_sim_relation    relation,
+		const TransitionsPtr&       transitions,
+		const FinalStateSet&        finalStates,
+		const TransitionsPtr&       partnerTransitions,
+		const FinalStateSet&        partnerFinalStates) const
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+
+		auto it = inclSims_.find(relation);
+		if ((inclSims_.end() == it) ||
+			(it->second.transitions != transitions) ||
+			// an expired pointer does not match any live transitions
+			(it->second.partnerTransitions.lock() != partnerTransitions) ||
+			(it->second.finalStates != finalStates) ||
+			(it->second.partnerFinalStates != partnerFinalStates))
+		{
+			return InclusionSimulationPtr();
+		}
+
+		return it->second.sim;
+	}
+
+	void StoreInclusionSimulation(
+		SimParam::e_sim_relation      relation,
+		const TransitionsPtr&         transitions,
+		const FinalStateSet&          finalStates,
+		const TransitionsPtr&         partnerTransitions,
+		const FinalStateSet&          partnerFinalStates,
+		const InclusionSimulationPtr& sim)
+	{
+		assert(nullptr != sim);
+
+		std::lock_guard<std::mutex> lock(mutex_);
+
+		// replaces the previous simulation for the relation
+		inclSims_[relation] = InclusionEntry(transitions, partnerTransitions,
+			finalStates, partnerFinalStates, sim);
+	}
+
+	SparseSimulationPtr FindSparseSimulation(
+		const SimParam&             params,
+		const TransitionsPtr&       transitions) const
+	{
+		return this->find(sparseSims_, params, transitions);
+	}
+
+	void StoreSparseSimulation(
+		const SimParam&             params,
+		const TransitionsPtr&       transitions,
+		const SparseSimulationPtr&  sim)
+	{
+		this->store(sparseSims_, params, transitions, sim);
+	}
+
+	void Clear()
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+
+		sims_.clear();
+		sparseSims_.clear();
+		inclSims_.clear();
+	}
+};
+
+#endif
@@ -0,0 +1,282 @@
+/*****************************************************************************
+ *  VATA Tree Automata Library
+ *
+ *  Copyright (c) 2015  Ondra Lengal <ilengal@fit.vutbr.cz>
+ *
+ *  Description:
+ *    Incremental recomputation of simulation on explicit tree automata.
+ *
+ *****************************************************************************/
+
+// VATA headers
+#include <vata/aut_base.hh>
+
+// Standard library headers
+#include <algorithm>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "explicit_tree_aut_core.hh"
+#include "explicit_tree_transl.hh"
+
+using VATA::AutBase;
+using VATA::ExplicitLTS;
+using VATA::ExplicitTreeAutCore;
+using VATA::SimParam;
+
+using StateDiscontBinaryRelation  = AutBase::StateDiscontBinaryRelation;
+
+namespace
+{
+	using StateSet = std::unordered_set<AutBase::StateType>;
+	using ParentMap = std::unordered_map<AutBase::StateType, StateSet>;
+
+	/**
+	 * @brief  Closes a set of states under the parent relation
+	 */
+	void addAncestors(
+		StateSet&             states,
+		const ParentMap&      parents)
+	{
+		std::vector<AutBase::StateType> workset(states.begin(), states.end());
+		while (!workset.empty())
+		{
+			AutBase::StateType state = workset.back();
+			workset.pop_back();
+
+			auto it = parents.find(state);
+			if (parents.end() == it)
+			{
+				continue;
+			}
+
+			for (const AutBase::StateType& parent : it->second)
+			{
+				if (states.insert(parent).second)
+				{
+					workset.push_back(parent);
+				}
+			}
+		}
+	}
+}
+
+
+StateDiscontBinaryRelation ExplicitTreeAutCore::RecomputeSimulation(
+	const SimParam&                        params,
+	const StateDiscontBinaryRelation&      oldSim,
+	const std::vector<Transition>&         addedTransitions,
+	const std::vector<Transition>&         removedTransitions) const
+{
+	if ((SimParam::e_sim_relation::TA_DOWNWARD != params.GetRelation()) ||
+		(static_cast<size_t>(-1) == params.GetNumStates()))
+	{
+		return this->ComputeSimulation(params);
+	}
+
+	// the index of parents contains also the removed transitions, so that
+	// ancestors in the original automaton are considered, too; symbols need to
+	// have a fixed arity (see below)
+	ParentMap parents;
+	std::unordered_map<SymbolType, size_t> arities;
+	bool ranked = true;
+
+	auto addParentF = [&parents, &arities, &ranked](
+		const StateType&      parent,
+		const SymbolType&     symbol,
+		const StateTuple&     children)
+	{
+		auto insRes = arities.insert(std::make_pair(symbol, children.size()));
+		ranked = ranked && (insRes.first->second == children.size());
+
+		for (const StateType& child : children)
+		{
+			parents[child].insert(parent);
+		}
+	};
+
+	for (const auto& stateClusterPair : *this->clusterMap())
+	{
+		assert(nullptr != stateClusterPair.second);
+
+		for (const auto& symbolTupleSetPair : *stateClusterPair.second)
+		{
+			assert(nullptr != symbolTupleSetPair.second);
+
+			for (const TuplePtr& tuple : *symbolTupleSetPair.second)
+			{
+				addParentF(stateClusterPair.first, symbolTupleSetPair.first, *tuple);
+			}
+		}
+	}
+
+	for (const Transition& trans : removedTransitions)
+	{
+		addParentF(trans.GetParent(), trans.GetSymbol(), trans.GetChildren());
+	}
+
+	if (!ranked)
+	{	// the LTS may relate states with tuples then, which the initial
+		// approximation below does not capture
+		return this->ComputeSimulation(params);
+	}
+
+	// states that may simulate more states than before (those with added
+	// transitions and their ancestors) ...
+	StateSet gaining;
+	for (const Transition& trans : addedTransitions)
+	{
+		gaining.insert(trans.GetParent());
+	}
+
+	addAncestors(gaining, parents);
+
+	// ... and states that may be simulated by more states than before (those
+	// with removed transitions and their ancestors)
+	StateSet losing;
+	for (const Transition& trans : removedTransitions)
+	{
+		losing.insert(trans.GetParent());
+	}
+
+	addAncestors(losing, parents);
+
+	const size_t size = params.GetNumStates();
+
+	StateToStateMap translMap;
+	size_t stateCnt = 0;
+	StateToStateTranslWeak transl(translMap, [&stateCnt](const StateType&)
+		{return stateCnt++;});
+
+	ExplicitLTS lts = this->TranslateDownward(size, transl);
+
+	if (0 == size)
+	{
+		return StateDiscontBinaryRelation(Util::BinaryRelation(), translMap);
+	}
+
+	// a state can only be simulated by states with all its symbols, which
+	// gives a preorder bounding the simulation
+	std::vector<std::vector<SymbolType>> symbols(size);
+	for (const auto& stateClusterPair : *this->clusterMap())
+	{
+		std::vector<SymbolType>& stateSymbols = symbols[transl(stateClusterPair.first)];
+		for (const auto& symbolTupleSetPair : *stateClusterPair.second)
+		{
+			stateSymbols.push_back(symbolTupleSetPair.first);
+		}
+
+		std::sort(stateSymbols.begin(), stateSymbols.end());
+	}
+
+	Util::BinaryRelation symbolIncl(size, false);
+	for (size_t i = 0; i < size; ++i)
+	{
+		for (size_t j = 0; j < size; ++j)
+		{
+			symbolIncl.set(i, j, std::includes(symbols[j].begin(), symbols[j].end(),
+				symbols[i].begin(), symbols[i].end()));
+		}
+	}
+
+	// the initial approximation: the original simulation extended with pairs
+	// that may have become valid; states unknown to the original simulation
+	// are only bounded by symbols
+	Util::BinaryRelation approx(size, false);
+
+	StateDiscontBinaryRelation::IndexType oldIndex;
+	oldSim.buildIndex(oldIndex);
+
+	std::vector<bool> freeRow(size, true);
+	std::vector<bool> freeCol(size, true);
+	for (const auto& stateIndexPair : translMap)
+	{
+		const StateType& state = stateIndexPair.first;
+		const size_t index = stateIndexPair.second;
+		assert(index < size);
+
+		auto oldIt = oldIndex.find(state);
+		if (oldIndex.end() == oldIt)
+		{
+			continue;
+		}
+
+		freeRow[index] = (losing.end() != losing.find(state));
+		freeCol[index] = (gaining.end() != gaining.find(state));
+
+		for (const StateType& image : oldIt->second)
+		{
+			auto translIt = translMap.find(image);
+			if (translMap.end() != translIt)
+			{
+				approx.set(index, translIt->second, true);
+			}
+		}
+	}
+
+	for (size_t i = 0; i < size; ++i)
+	{
+		for (size_t j = 0; j < size; ++j)
+		{
+			if (freeRow[i] || freeCol[j] || (i == j))
+			{
+				approx.set(i, j, true);
+			}
+		}
+	}
+
+	approx &= symbolIncl;
+
+	// the initial relation needs to be a preorder
+	for (size_t k = 0; k < size; ++k)
+	{
+		for (size_t i = 0; i < size; ++i)
+		{
+			if (approx.get(i, k))
+			{
+				approx.unionWith(i, k);
+			}
+		}
+	}
+
+	approx &= symbolIncl;
+
+	// blocks of the initial partition are the classes of the approximation;
+	// states of the LTS standing for tuples form a separate block
+	std::vector<size_t> classIndex;
+	std::vector<size_t> classHeads;
+	approx.buildClasses(classIndex, classHeads);
+
+	std::vector<std::vector<size_t>> partition(classHeads.size());
+	for (size_t i = 0; i < size; ++i)
+	{
+		partition[classIndex[i]].push_back(i);
+	}
+
+	const bool hasTuples = lts.states() > size;
+	Util::BinaryRelation relation(classHeads.size() + (hasTuples? 1 : 0), false);
+	for (size_t i = 0; i < classHeads.size(); ++i)
+	{
+		for (size_t j = 0; j < classHeads.size(); ++j)
+		{
+			relation.set(i, j, approx.get(classHeads[i], classHeads[j]));
+		}
+	}
+
+	if (hasTuples)
+	{
+		partition.push_back(std::vector<size_t>());
+		for (size_t i = size; i < lts.states(); ++i)
+		{
+			partition.back().push_back(i);
+		}
+
+		relation.set(classHeads.size(), classHeads.size(), true);
+	}
+
+	Util::BinaryRelation ltsSim =
+		lts.computeSimulation(
+			partition, relation, size, params.GetNumThreads(), params.GetCancellationToken());
+	return StateDiscontBinaryRelation(ltsSim, translMap);
+}
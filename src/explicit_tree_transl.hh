@@ -28,6 +28,11 @@ VATA::ExplicitLTS VATA::ExplicitTreeAutCore::TranslateDownward(
 	size_t        numStates,
 	Index&        stateIndex) const
 {
+	if (frozen_)
+	{
+		return this->translateDownwardFrozen(numStates, stateIndex);
+	}
+
 	std::unordered_map<SymbolType, size_t> symbolMap;
 	std::unordered_map<const StateTuple*, size_t> lhsMap;
 
@@ -35,8 +40,6 @@ VATA::ExplicitLTS VATA::ExplicitTreeAutCore::TranslateDownward(
 	Util::TranslatorWeak2<std::unordered_map<SymbolType, size_t>>
 		symbolTranslator(symbolMap, [&symbolCnt](const SymbolType&){ return symbolCnt++; });
 
-	assert(nullptr != transitions_);
-
 	size_t lhsCnt = numStates;
 	Util::TranslatorWeak2<std::unordered_map<const StateTuple*, size_t>>
 		lhsTranslator(lhsMap, [&lhsCnt](const StateTuple*){ return lhsCnt++; });
@@ -53,7 +56,7 @@ VATA::ExplicitLTS VATA::ExplicitTreeAutCore::TranslateDownward(
 	 * Iterate through all transitions and adds them
 	 * to the LTS.
 	 */
-	for (auto& stateClusterPair : *transitions_)
+	for (auto& stateClusterPair : *this->clusterMap())
 	{
 		assert(nullptr != stateClusterPair.second);
 
@@ -107,6 +110,92 @@ VATA::ExplicitLTS VATA::ExplicitTreeAutCore::TranslateDownward(
 }
 
 
+template <class Index>
+VATA::ExplicitLTS VATA::ExplicitTreeAutCore::translateDownwardFrozen(
+	size_t        numStates,
+	Index&        stateIndex) const
+{
+	assert(nullptr != frozen_);
+
+	const FrozenTransitions& frozen = frozen_->GetTransitions();
+
+	std::unordered_map<SymbolType, size_t> symbolMap;
+
+	size_t symbolCnt = 0;
+	Util::TranslatorWeak2<std::unordered_map<SymbolType, size_t>>
+		symbolTranslator(symbolMap, [&symbolCnt](const SymbolType&){ return symbolCnt++; });
+
+	// tuples in the frozen storage are identified by integers, so the
+	// translation of tuples to LTS states is a plain vector
+	const size_t NoState = FrozenTransitions::NotFound;
+	std::vector<size_t> lhsMap(frozen.TupleCount(), NoState);
+	std::vector<size_t> lhsTuples;
+
+	size_t lhsCnt = numStates;
+
+	ExplicitLTS result(numStates);
+
+	// start with getting tranlation for final states
+	for (const StateType finState : this->GetFinalStates())
+	{
+		stateIndex[finState];
+	}
+
+	for (size_t p = 0; p < frozen.ParentCount(); ++p)
+	{
+		size_t state = stateIndex[frozen.GetParent(p)];
+
+		for (size_t s = frozen.SymbolsBegin(p); s < frozen.SymbolsEnd(p); ++s)
+		{
+			size_t symbol = symbolTranslator(frozen.GetSymbol(s));
+
+			for (size_t t = frozen.TuplesBegin(s); t < frozen.TuplesEnd(s); ++t)
+			{
+				FrozenTransitions::TupleRef tuple = frozen.GetTuple(t);
+
+				size_t dest;
+				if (1 == tuple.size())
+				{ // a(p) -> q ... inline lhs of size 1 >:-)
+					dest = stateIndex[tuple[0]];
+					assert(dest < numStates);
+				}
+				else
+				{ // a(p,r) -> q
+					size_t& lhs = lhsMap[frozen.GetTupleId(t)];
+					if (NoState == lhs)
+					{
+						lhs = lhsCnt++;
+						lhsTuples.push_back(frozen.GetTupleId(t));
+					}
+
+					dest = lhs;
+				}
+
+				result.addTransition(state, symbol, dest);
+			}
+		}
+	}
+
+	for (size_t tupleId : lhsTuples)
+	{	// for n-ary transition (n > 1), decompose the hyperedge into n ordinary
+		// edges
+		size_t i = 0;
+		for (const StateType& state : frozen.GetTupleById(tupleId))
+		{
+			size_t dest = stateIndex[state];
+			assert(dest < numStates);
+
+			result.addTransition(lhsMap[tupleId], symbolMap.size() + i, dest);
+			++i;
+		}
+	}
+
+	result.init();
+
+	return result;
+}
+
+
 template <
 	class Rel,
 	class Index>
@@ -198,17 +287,16 @@ VATA::ExplicitLTS VATA::ExplicitTreeAutCore::TranslateUpward(
 		}
 	};
 
-	assert(nullptr != transitions_);
 //	assert(aut.transitions_->size() == param.size());
 
 	size_t symbolCnt = 0;
-	size_t stateCnt = transitions_->size() + 1; // leaf state
+	size_t stateCnt = this->clusterMap()->size() + 1; // leaf state
 
 	std::unordered_map<SymbolType, size_t> symbolMap;
 	std::unordered_map<Env, size_t, env_hash> envMap;
 
 	size_t base = ((0 < finalStates_.size()) &&
-		(finalStates_.size() < transitions_->size())) ? 3 : 2;
+		(finalStates_.size() < this->clusterMap()->size())) ? 3 : 2;
 
 	partition.clear();
 	partition.resize(base);
@@ -245,10 +333,10 @@ VATA::ExplicitLTS VATA::ExplicitTreeAutCore::TranslateUpward(
 			}
 	);
 
-	for (auto& stateClusterPair : *transitions_)
+	for (auto& stateClusterPair : *this->clusterMap())
 	{
 		assert(stateClusterPair.second);
-		assert(stateIndex[stateClusterPair.first] < transitions_->size());
+		assert(stateIndex[stateClusterPair.first] < this->clusterMap()->size());
 
 		partition[
 			this->IsStateFinal(stateClusterPair.first)?(0):(base - 2)
@@ -262,11 +350,11 @@ VATA::ExplicitLTS VATA::ExplicitTreeAutCore::TranslateUpward(
 		}
 	}
 
-	partition[base - 1].push_back(transitions_->size()); // leaf state
+	partition[base - 1].push_back(this->clusterMap()->size()); // leaf state
 
 	ExplicitLTS result;
 
-	for (auto& stateClusterPair : *transitions_)
+	for (auto& stateClusterPair : *this->clusterMap())
 	{
 		assert(stateClusterPair.second);
 
@@ -285,7 +373,7 @@ VATA::ExplicitLTS VATA::ExplicitTreeAutCore::TranslateUpward(
 				if (tuple->empty())
 				{
 					// take care of leaves
-					result.addTransition(transitions_->size(), symbol, state);
+					result.addTransition(this->clusterMap()->size(), symbol, state);
 					continue;
 				}
 
@@ -52,10 +52,10 @@ ExplicitTreeAutCore ExplicitTreeAutCore::UnionDisjointStates(
 {
 	ExplicitTreeAutCore res(lhs);
 
-	assert(rhs.transitions_);
-
-	res.uniqueClusterMap()->insert(rhs.transitions_->begin(), rhs.transitions_->end());
-	assert(lhs.transitions_->size() + rhs.transitions_->size() == res.transitions_->size());
+	// the clusters of rhs (and their tuples) are shared
+	res.cache_->retain(rhs.cache_);
+	res.uniqueClusterMap()->insert(rhs.clusterMap()->begin(), rhs.clusterMap()->end());
+	assert(lhs.clusterMap()->size() + rhs.clusterMap()->size() == res.clusterMap()->size());
 
 	res.finalStates_.insert(rhs.finalStates_.begin(), rhs.finalStates_.end());
 	assert(lhs.finalStates_.size() + rhs.finalStates_.size() == res.finalStates_.size());
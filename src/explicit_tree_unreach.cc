@@ -25,12 +25,17 @@ using VATA::AutBase;
 ExplicitTreeAutCore ExplicitTreeAutCore::RemoveUnreachableStates(
 	AutBase::StateToStateMap*            pTranslMap) const
 {
-	std::unordered_set<StateType> reachableStates(this->GetFinalStates());
+	// the number of states with transitions bounds the number of reachable
+	// states (up to final states without transitions)
+	std::unordered_set<StateType> reachableStates;
+	reachableStates.reserve(this->clusterMap()->size() + finalStates_.size());
+	reachableStates.insert(finalStates_.begin(), finalStates_.end());
+
 	std::vector<StateType> newStates(reachableStates.begin(), reachableStates.end());
 
 	while (!newStates.empty())
 	{
-		auto cluster = ExplicitTreeAutCore::genericLookup(*transitions_, newStates.back());
+		auto cluster = ExplicitTreeAutCore::genericLookup(*this->clusterMap(), newStates.back());
 
 		newStates.pop_back();
 
@@ -66,7 +71,7 @@ ExplicitTreeAutCore ExplicitTreeAutCore::RemoveUnreachableStates(
 		}
 	}
 
-	if (reachableStates.size() == transitions_->size())
+	if (reachableStates.size() == this->clusterMap()->size())
 	{
 		return *this;
 	}
@@ -80,9 +85,9 @@ ExplicitTreeAutCore ExplicitTreeAutCore::RemoveUnreachableStates(
 
 	for (const StateType& state : reachableStates)
 	{
-		auto iter = transitions_->find(state);
+		auto iter = this->clusterMap()->find(state);
 
-		if (iter == transitions_->end())
+		if (iter == this->clusterMap()->end())
 		{
 			continue;
 		}
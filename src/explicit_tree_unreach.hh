@@ -106,9 +106,9 @@ VATA::ExplicitTreeAutCore VATA::ExplicitTreeAutCore::RemoveUnreachableStates(
 
 		newStates.pop_back();
 
-		auto stateClusterIter = transitions_->find(state);
+		auto stateClusterIter = this->clusterMap()->find(state);
 
-		if (stateClusterIter == transitions_->end())
+		if (stateClusterIter == this->clusterMap()->end())
 		{
 			continue;
 		}
@@ -171,7 +171,7 @@ VATA::ExplicitTreeAutCore VATA::ExplicitTreeAutCore::RemoveUnreachableStates(
 		newTransitions->insert(std::make_pair(state, transitionCluster));
 	}
 
-	if (!transitionsModified && (reachableStates.size() == transitions_->size()) &&
+	if (!transitionsModified && (reachableStates.size() == this->clusterMap()->size()) &&
 		(finalStates.data().size() == finalStates_.size()))
 	{
 		return *this;
@@ -181,9 +181,10 @@ VATA::ExplicitTreeAutCore VATA::ExplicitTreeAutCore::RemoveUnreachableStates(
 
 	result.finalStates_.insert(finalStates.data().begin(), finalStates.data().end());
 
-	if (!transitionsModified && (reachableStates.size() == transitions_->size()))
+	if (!transitionsModified && (reachableStates.size() == this->clusterMap()->size()))
 	{
 		result.transitions_ = transitions_;
+		result.frozen_ = frozen_;
 
 		return result;
 	}
@@ -15,6 +15,7 @@
 #include <vector>
 #include <unordered_map>
 #include <unordered_set>
+#include <algorithm>
 
 #include "explicit_tree_aut_core.hh"
 
@@ -23,151 +24,241 @@ using VATA::ExplicitTreeAutCore;
 
 using StateToStateMap    = VATA::AutBase::StateToStateMap;
 
-ExplicitTreeAutCore ExplicitTreeAutCore::RemoveUselessStates(
-	StateToStateMap*            pTranslMap) const
+bool ExplicitTreeAutCore::computeBottomUpReachable(
+	std::unordered_set<StateType>&      reachable,
+	bool                                stopAtFinal) const
 {
-	struct TransitionInfo
-	{
-		TuplePtr children_;
-		SymbolType symbol_;
-		StateType state_;
-
-		std::set<StateType> childrenSet_;
-
-		TransitionInfo(
-			const TuplePtr&      children,
-			const SymbolType&    symbol,
-			const StateType&     state) :
-			children_(children),
-			symbol_(symbol),
-			state_(state),
-			childrenSet_(children->begin(), children->end())
-		{ }
-
-		bool reachedBy(const StateType& state)
-		{
-			assert(childrenSet_.count(state));
-
-			childrenSet_.erase(state);
-
-			return childrenSet_.empty();
-		}
-	};
-
-	typedef std::shared_ptr<TransitionInfo> TransitionInfoPtr;
-
-	std::unordered_map<StateType, std::vector<TransitionInfoPtr>> stateMap;
-	std::unordered_set<StateType> reachableStates;
-	std::vector<TransitionInfoPtr> reachableTransitions;
-	std::vector<StateType> newStates;
+	// for every distinct tuple the parents of its transitions (regardless of
+	// the symbol) and the number of its distinct children not reached yet
+	std::vector<std::vector<StateType>> tupleParents;
+	std::vector<size_t> tupleRemaining;
 
-	assert(nullptr != transitions_);
+	// for every state the tuples in which it occurs
+	std::unordered_map<StateType, std::vector<size_t>> stateTuples;
 
-	size_t remaining = 0;
-
-	for (auto& stateClusterPair : *transitions_) {
+	std::vector<StateType> children;
+	auto addTupleF = [&](const StateType* begin, const StateType* end)
+	{
+		size_t tupleIdx = tupleRemaining.size();
 
-		assert(stateClusterPair.second);
+		children.assign(begin, end);
+		std::sort(children.begin(), children.end());
+		children.erase(std::unique(children.begin(), children.end()), children.end());
 
-		for (auto& symbolTupleSetPair : *stateClusterPair.second) {
+		tupleParents.push_back(std::vector<StateType>());
+		tupleRemaining.push_back(children.size());
 
-			assert(symbolTupleSetPair.second);
+		for (const StateType& child : children)
+		{
+			stateTuples[child].push_back(tupleIdx);
+		}
+	};
 
-			for (auto& tuple : *symbolTupleSetPair.second) {
+	if (frozen_)
+	{	// the tuples of the frozen storage are already numbered
+		const FrozenTransitions& frozen = frozen_->GetTransitions();
 
-				assert(tuple);
+		for (size_t t = 0; t < frozen.TupleCount(); ++t)
+		{
+			FrozenTransitions::TupleRef tuple = frozen.GetTupleById(t);
+			addTupleF(tuple.begin(), tuple.end());
+		}
 
-				auto transitionInfoPtr = TransitionInfoPtr(
-					new TransitionInfo(tuple, symbolTupleSetPair.first, stateClusterPair.first)
-				);
+		frozen.ForeachTransition([&tupleParents](
+			const StateType&                   parent,
+			const SymbolType&                  /* symbol */,
+			size_t                             tupleId,
+			const FrozenTransitions::TupleRef& /* tuple */)
+			{
+				tupleParents[tupleId].push_back(parent);
+			});
+	}
+	else
+	{
+		std::unordered_map<const StateTuple*, size_t> tupleIndex;
 
-				if (tuple->empty()) {
+		for (auto& stateClusterPair : *this->clusterMap())
+		{
+			assert(stateClusterPair.second);
 
-					reachableTransitions.push_back(transitionInfoPtr);
+			for (auto& symbolTupleSetPair : *stateClusterPair.second)
+			{
+				assert(symbolTupleSetPair.second);
 
-					if (reachableStates.insert(stateClusterPair.first).second)
-						newStates.push_back(stateClusterPair.first);
+				for (auto& tuple : *symbolTupleSetPair.second)
+				{
+					assert(tuple);
 
-					continue;
+					auto insRes = tupleIndex.insert(
+						std::make_pair(tuple.get(), tupleRemaining.size()));
+					if (insRes.second)
+					{
+						addTupleF(tuple->data(), tuple->data() + tuple->size());
+					}
 
+					tupleParents[insRes.first->second].push_back(stateClusterPair.first);
 				}
+			}
+		}
+	}
 
-				for (auto& s : transitionInfoPtr->childrenSet_) {
-
-					stateMap.insert(
-						std::make_pair(s, std::vector<TransitionInfoPtr>())
-					).first->second.push_back(transitionInfoPtr);
-
-					++remaining;
+	std::vector<StateType> newStates;
 
-				}
+	// returns true if the computation is to be stopped
+	auto fireTupleF = [&](size_t tupleIdx) -> bool
+	{
+		for (const StateType& parent : tupleParents[tupleIdx])
+		{
+			if (!reachable.insert(parent).second)
+			{
+				continue;
+			}
 
+			if (stopAtFinal && this->IsStateFinal(parent))
+			{
+				return true;
 			}
 
+			newStates.push_back(parent);
 		}
 
-	}
+		return false;
+	};
 
-	while (!newStates.empty()) {
+	for (size_t t = 0; t < tupleRemaining.size(); ++t)
+	{
+		if ((0 == tupleRemaining[t]) && fireTupleF(t))
+		{
+			return true;
+		}
+	}
 
-		auto i = stateMap.find(newStates.back());
+	while (!newStates.empty())
+	{
+		auto it = stateTuples.find(newStates.back());
 
 		newStates.pop_back();
 
-		if (i == stateMap.end())
+		if (stateTuples.end() == it)
+		{
 			continue;
+		}
 
-		for (auto& info : i->second) {
+		for (size_t t : it->second)
+		{
+			assert(0 < tupleRemaining[t]);
 
-			assert(info);
+			if ((0 == --tupleRemaining[t]) && fireTupleF(t))
+			{
+				return true;
+			}
+		}
+	}
 
-			if (!info->reachedBy(i->first))
-				continue;
+	return false;
+}
 
-			reachableTransitions.push_back(info);
 
-			--remaining;
+ExplicitTreeAutCore ExplicitTreeAutCore::RemoveUselessStates(
+	StateToStateMap*            pTranslMap) const
+{
+	std::unordered_set<StateType> reachableStates;
+	this->computeBottomUpReachable(reachableStates, false);
 
-			if (reachableStates.insert(info->state_).second)
-				newStates.push_back(info->state_);
+	ExplicitTreeAutCore result(cache_);
 
+	for (auto& state : finalStates_)
+	{
+		if (reachableStates.cend() != reachableStates.find(state))
+		{
+			result.SetStateFinal(state);
 		}
-
 	}
-/*
-	if (pTranslMap) {
 
-		for (auto& state : reachableStates)
-			pTranslMap->insert(std::make_pair(state, state));
+	// a transition is useful iff all its children are reachable (then the
+	// parent is reachable, too)
+	auto isUsefulF = [&reachableStates](const StateTuple& tuple) -> bool
+	{
+		for (const StateType& state : tuple)
+		{
+			if (reachableStates.cend() == reachableStates.find(state))
+			{
+				return false;
+			}
+		}
 
-	}
-*/
-	ExplicitTreeAutCore result(cache_);
+		return true;
+	};
 
-	for (auto& state : finalStates_) {
+	// clusters and tuple sets without useless transitions are shared with this
+	// automaton
+	StateToTransitionClusterMapPtr usefulTransitions(new StateToTransitionClusterMap());
+	bool uselessFound = false;
 
-		if (reachableStates.cend() != reachableStates.find(state))
+	for (auto& stateClusterPair : *this->clusterMap())
+	{
+		assert(stateClusterPair.second);
+
+		if (reachableStates.cend() == reachableStates.find(stateClusterPair.first))
 		{
-			result.SetStateFinal(state);
+			uselessFound = true;
+			continue;
 		}
-	}
 
-	if (!remaining) {
+		TransitionClusterPtr cluster = stateClusterPair.second;
 
-		result.transitions_ = transitions_;
+		for (auto& symbolTupleSetPair : *stateClusterPair.second)
+		{
+			assert(symbolTupleSetPair.second);
 
-		return result.RemoveUnreachableStates(pTranslMap);
+			const TuplePtrSet& tupleSet = *symbolTupleSetPair.second;
+			if (std::all_of(tupleSet.begin(), tupleSet.end(),
+				[&isUsefulF](const TuplePtr& tuple){ return isUsefulF(*tuple); }))
+			{
+				continue;
+			}
 
-	}
+			uselessFound = true;
 
-	for (auto& info : reachableTransitions) {
+			if (cluster == stateClusterPair.second)
+			{
+				cluster = TransitionClusterPtr(new TransitionCluster(*cluster));
+			}
 
-		assert(info);
+			TuplePtrSetPtr usefulTupleSet(new TuplePtrSet());
+			for (const TuplePtr& tuple : tupleSet)
+			{
+				if (isUsefulF(*tuple))
+				{
+					usefulTupleSet->insert(tuple);
+				}
+			}
 
-		result.internalAddTransition(info->children_, info->symbol_, info->state_);
+			if (usefulTupleSet->empty())
+			{
+				cluster->erase(symbolTupleSetPair.first);
+			}
+			else
+			{
+				(*cluster)[symbolTupleSetPair.first] = usefulTupleSet;
+			}
+		}
 
+		if (!cluster->empty())
+		{
+			usefulTransitions->insert(std::make_pair(stateClusterPair.first, cluster));
+		}
 	}
 
-	return result.RemoveUnreachableStates(pTranslMap);
+	if (uselessFound)
+	{
+		result.transitions_ = usefulTransitions;
+	}
+	else
+	{
+		result.transitions_ = transitions_;
+		result.frozen_ = frozen_;
+	}
 
+	return result.RemoveUnreachableStates(pTranslMap);
 }
@@ -46,5 +46,11 @@ std::string VATA::InclParam::toString() const
 	result += "Use simulation: ";
 	result += Convert::ToString(this->GetUseSimulation()) + "\n";
 
+	result += "Number of threads: ";
+	result += Convert::ToString(this->GetNumThreads()) + "\n";
+
+	result += "Dense macrostate limit: ";
+	result += Convert::ToString(this->GetDenseMacroStateLimit()) + "\n";
+
 	return result;
 }
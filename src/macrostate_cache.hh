@@ -15,9 +15,12 @@
 // VATA headers
 #include <vata/vata.hh>
 
+#include "util/dense_state_set.hh"
+
 // Standard library headers
 #include <list>
 #include <unordered_map>
+#include <utility>
 
 namespace VATA {
 	template<class Aut> class MacroStateCache;
@@ -25,17 +28,41 @@ namespace VATA {
 
 /*
  * Cache for caching macro state
+ *
+ * If dense macrostates are used, every cached macrostate has also its dense
+ * representation (see GetDense()), which is used for comparing macrostates
+ * in the cache, and the keys given to insert() are replaced by the hashes of
+ * the dense representations.
  */
 template<class Aut>
 class VATA::MacroStateCache {
 private:
 	typedef typename Aut::StateSet StateSet;
-	typedef std::list<StateSet> SetList;
+	typedef VATA::Util::DenseStateSet DenseStateSet;
+
+	// Cached macrostate together with its dense representation (if used)
+GCC_DIAG_OFF(effc++)
+	class CachedMacroState : public StateSet {
+GCC_DIAG_ON(effc++)
+	public:
+		DenseStateSet dense;
+
+		CachedMacroState(const StateSet& set, DenseStateSet&& dense) :
+			StateSet(set),
+			dense(std::move(dense))
+		{}
+	};
+
+	typedef std::list<CachedMacroState> SetList;
 	typedef std::unordered_map<size_t,SetList> CacheMap;
 
 	CacheMap cacheMap;
+	bool useDense;
 public:
-	MacroStateCache() : cacheMap(){}
+	explicit MacroStateCache(bool useDense = false) :
+		cacheMap(),
+		useDense(useDense)
+	{}
 
 	// Function inserts a new element to macrostate cache, when
 	// the element is already presented it will return pointer to it
@@ -56,10 +83,14 @@ public:
 			return true;
 	 };
 
+		if (useDense) {
+			return insertDense(value);
+		}
+
 		auto iter = cacheMap.find(key);
 		if (iter == cacheMap.end()) { // new value
 			auto& list = cacheMap.insert(std::make_pair(key,SetList())).first->second;
-			list.push_back(StateSet(value));
+			list.push_back(CachedMacroState(value,DenseStateSet()));
 			return list.back();
 		}
 		else {
@@ -68,11 +99,38 @@ public:
 					return set;
 				}
 			}
-			iter->second.push_back(StateSet(value));
+			iter->second.push_back(CachedMacroState(value,DenseStateSet()));
 			return iter->second.back();
 		}
 	}
 
+	bool UsesDense() const {
+		return useDense;
+	}
+
+	// Returns the dense representation of a macrostate returned by insert()
+	const DenseStateSet& GetDense(const StateSet& set) const {
+		assert(useDense);
+
+		return static_cast<const CachedMacroState&>(set).dense;
+	}
+
+private:
+
+	// Inserts the element comparing the dense representations of macrostates
+	StateSet& insertDense(StateSet& value) {
+		DenseStateSet dense(value);
+
+		auto& list = cacheMap[dense.Hash()];
+		for (auto& set : list) { // set already cached
+			if (set.dense == dense) {
+				return set;
+			}
+		}
+
+		list.push_back(CachedMacroState(value,std::move(dense)));
+		return list.back();
+	}
 };
 
 #endif
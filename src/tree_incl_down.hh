@@ -14,6 +14,7 @@
 
 // VATA headers
 #include <vata/vata.hh>
+#include <vata/cancellation_token.hh>
 
 namespace VATA
 {
@@ -24,14 +25,14 @@ namespace VATA
 		class Rel
 	>
 	bool CheckDownwardTreeInclusion(const Aut& smaller, const Aut& bigger,
-		const Rel& preorder);
+		const Rel& preorder, const CancellationToken* cancel = nullptr);
 }
 
 /**
  * @brief  Checks language inclusion on tree automata downwards
  *
  * This is a general method for tree automata to check language inclusion
- * downward.
+ * downward.  If @p cancel is given, it is polled in every expansion.
  *
  * @todo  Write this documentation
  */
@@ -44,7 +45,8 @@ template
 bool VATA::CheckDownwardTreeInclusion(
 	const Aut&     smaller,
 	const Aut&     bigger,
-	const Rel&     preorder)
+	const Rel&     preorder,
+	const CancellationToken* cancel)
 {
 	typedef DownwardInclFctor<Aut, Rel> InclFctor;
 
@@ -81,6 +83,7 @@ bool VATA::CheckDownwardTreeInclusion(
 	InclFctor downFctor(smaller, bigger, biggerTypeCache, workset, incl, nonIncl,
 		preorder, preorderSmaller, preorderBigger, compSmaller, compBigger,
 		antecedent, consequent);
+	downFctor.SetCancellationToken(cancel);
 
 	StateSet finalStatesBigger(bigger.GetFinalStates().begin(),
 		bigger.GetFinalStates().end());
@@ -0,0 +1,248 @@
+/*****************************************************************************
+ *  VATA Tree Automata Library
+ *
+ *  Copyright (c) 2015  Ondra Lengal <ilengal@fit.vutbr.cz>
+ *
+ *  Description:
+ *    Arena template header file.
+ *
+ *****************************************************************************/
+
+#ifndef _VATA_ARENA_HH_
+#define _VATA_ARENA_HH_
+
+
+// standard library headers
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <unordered_set>
+#include <vector>
+
+
+// Boost headers
+#include <boost/functional/hash.hpp>
+
+
+// insert class to proper namespace
+namespace VATA { namespace Util {
+	template <class T> class Arena;
+}}
+
+
+/**
+ * @brief  An arena interning objects
+ *
+ * This class maps an object of the type @p T on a unique instance stored
+ * inside the arena and hands out handles (Ptr) of the instance.  The objects
+ * are stored in a deque, so they are never moved, and a handle is the address
+ * of the instance.  Copying, comparing and hashing handles are therefore
+ * operations on a single integer, with no reference counting.
+ *
+ * Objects are not released one by one: all memory of the arena is freed at
+ * once when the arena is destroyed, so the arena needs to outlive its handles.
+ * Users share the arena by ArenaPtr; handles of another arena can be kept
+ * valid by retain().
+ *
+ * Interning is not thread-safe; dereferencing handles is.
+ */
+template <class T>
+class VATA::Util::Arena
+{
+public:   // data types
+
+	using ArenaPtr         = std::shared_ptr<Arena>;
+
+	/**
+	 * @brief  Handle of an object interned in an arena
+	 *
+	 * Handles are equal iff they refer to the same instance, i.e., iff the
+	 * objects are equal and come from the same arena.  The order of handles is
+	 * the order of the addresses of the instances.
+	 */
+	class Ptr
+	{
+	private:  // data members
+
+		const T* ptr_;
+
+	private:  // methods
+
+		friend class Arena;
+
+		explicit Ptr(
+			const T*              ptr) :
+			ptr_(ptr)
+		{ }
+
+	public:   // methods
+
+		Ptr() :
+			ptr_(nullptr)
+		{ }
+
+		Ptr(
+			std::nullptr_t) :
+			ptr_(nullptr)
+		{ }
+
+		const T& operator*() const
+		{
+			assert(nullptr != ptr_);
+			return *ptr_;
+		}
+
+		const T* operator->() const
+		{
+			assert(nullptr != ptr_);
+			return ptr_;
+		}
+
+		const T* get() const
+		{
+			return ptr_;
+		}
+
+		explicit operator bool() const
+		{
+			return nullptr != ptr_;
+		}
+
+		friend bool operator==(const Ptr& lhs, const Ptr& rhs)
+		{
+			return lhs.ptr_ == rhs.ptr_;
+		}
+
+		friend bool operator!=(const Ptr& lhs, const Ptr& rhs)
+		{
+			return lhs.ptr_ != rhs.ptr_;
+		}
+
+		friend bool operator<(const Ptr& lhs, const Ptr& rhs)
+		{
+			return std::less<const T*>()(lhs.ptr_, rhs.ptr_);
+		}
+
+		friend size_t hash_value(const Ptr& ptr)
+		{
+			return boost::hash_value(ptr.ptr_);
+		}
+	};
+
+private:  // data types
+
+	struct DerefHash
+	{
+		size_t operator()(const T* x) const
+		{
+			return boost::hash<T>()(*x);
+		}
+	};
+
+	struct DerefEqual
+	{
+		bool operator()(const T* lhs, const T* rhs) const
+		{
+			return *lhs == *rhs;
+		}
+	};
+
+	using IndexSet         = std::unordered_set<const T*, DerefHash, DerefEqual>;
+
+private:  // data members
+
+	/// the interned objects
+	std::deque<T> objects_;
+
+	/// index of interned objects
+	IndexSet index_;
+
+	/// arenas whose handles are used together with the handles of this arena
+	std::vector<ArenaPtr> retained_;
+
+private:  // methods
+
+	Arena(const Arena&);
+	Arena& operator=(const Arena&);
+
+public:   // methods
+
+	Arena() :
+		objects_(),
+		index_(),
+		retained_()
+	{ }
+
+	/**
+	 * @brief  Interns an object
+	 *
+	 * @param[in]  x  The object
+	 *
+	 * @returns  The handle of the unique instance of @p x in the arena
+	 */
+	Ptr lookup(
+		const T&                  x)
+	{
+		auto it = index_.find(&x);
+		if (index_.end() != it)
+		{
+			return Ptr(*it);
+		}
+
+		objects_.push_back(x);
+		index_.insert(&objects_.back());
+
+		return Ptr(&objects_.back());
+	}
+
+	/**
+	 * @brief  Finds an object
+	 *
+	 * @returns  The handle of the unique instance of @p x in the arena, or a null
+	 *           handle if @p x is not in the arena
+	 */
+	Ptr find(
+		const T&                  x) const
+	{
+		auto it = index_.find(&x);
+
+		return (index_.end() == it)? Ptr() : Ptr(*it);
+	}
+
+	/**
+	 * @brief  Keeps another arena alive as long as this arena exists
+	 *
+	 * This needs to be called when handles of @p arena are stored together with
+	 * handles of this arena.  Arenas must not retain each other in a cycle.
+	 */
+	void retain(
+		const ArenaPtr&           arena)
+	{
+		assert(nullptr != arena);
+
+		if ((this != arena.get()) &&
+			(retained_.end() == std::find(retained_.begin(), retained_.end(), arena)))
+		{
+			retained_.push_back(arena);
+		}
+	}
+
+	/**
+	 * @brief  The number of objects in the arena
+	 */
+	size_t size() const
+	{
+		return index_.size();
+	}
+
+	bool empty() const
+	{
+		return index_.empty();
+	}
+};
+
+
+#endif
@@ -102,6 +102,19 @@ public:
 		storeMap2_.erase(i);
 	}
 
+	/**
+	 * @brief  Looks up a value without computing it
+	 *
+	 * @returns  The cached value for (@p x, @p y) or @p nullptr if there is
+	 *           none
+	 */
+	const V* find(const T1& x, const T2& y) const
+	{
+		auto it = store_.find(std::make_pair(x, y));
+
+		return (store_.end() == it)? nullptr : &it->second;
+	}
+
 	template <class F>
 	V lookup(const T1& x, const T2& y, F f)
 	{
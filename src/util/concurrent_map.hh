@@ -0,0 +1,126 @@
+/*****************************************************************************
+ *  VATA Tree Automata Library
+ *
+ *  Copyright (c) 2015  Ondra Lengal <ilengal@fit.vutbr.cz>
+ *
+ *  Description:
+ *    Hash map that may be accessed concurrently.
+ *
+ *****************************************************************************/
+
+#ifndef _VATA_CONCURRENT_MAP_HH_
+#define _VATA_CONCURRENT_MAP_HH_
+
+// standard library headers
+#include <cassert>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+
+// insert class to proper namespace
+namespace VATA { namespace Util {
+	template <class Key, class Value, class Hash> class ConcurrentMap;
+}}
+
+
+/**
+ * @brief  Hash map that may be accessed concurrently
+ *
+ * The map is split into a number of shards (chosen according to the hash of
+ * the key), each of them guarded by its own mutex, so that threads accessing
+ * different shards do not block each other.
+ */
+template <
+	class Key,
+	class Value,
+	class Hash = std::hash<Key>>
+class VATA::Util::ConcurrentMap
+{
+private:  // data types
+
+	using MapType = std::unordered_map<Key, Value, Hash>;
+
+	struct Shard
+	{
+		std::mutex mutex_;
+		MapType map_;
+
+		Shard() :
+			mutex_(),
+			map_()
+		{ }
+	};
+
+private:  // data members
+
+	Hash hash_;
+
+	std::vector<Shard> shards_;
+
+private:  // methods
+
+	ConcurrentMap(const ConcurrentMap&);
+	ConcurrentMap& operator=(const ConcurrentMap&);
+
+	Shard& getShard(const Key& key)
+	{
+		return shards_[hash_(key) % shards_.size()];
+	}
+
+public:   // methods
+
+	explicit ConcurrentMap(size_t numShards = 64) :
+		hash_(),
+		shards_(numShards)
+	{
+		assert(0 < numShards);
+	}
+
+	/**
+	 * @brief  Inserts a value for a key if the key is not present
+	 *
+	 * The value is obtained by calling @p valueGen() (under the lock of the
+	 * shard), so it is generated only if the key is not present.
+	 *
+	 * @returns  The pair of the value of @p key and a flag whether it was
+	 *           inserted
+	 */
+	template <class ValueGen>
+	std::pair<Value, bool> insert(
+		const Key&           key,
+		ValueGen             valueGen)
+	{
+		Shard& shard = this->getShard(key);
+		std::lock_guard<std::mutex> lock(shard.mutex_);
+
+		auto it = shard.map_.find(key);
+		if (shard.map_.end() != it)
+		{
+			return std::make_pair(it->second, false);
+		}
+
+		Value value = valueGen();
+		shard.map_.insert(std::make_pair(key, value));
+		return std::make_pair(value, true);
+	}
+
+	/**
+	 * @brief  Calls @p func(key, value) for every element
+	 *
+	 * Must not be called concurrently with insertion.
+	 */
+	template <class Func>
+	void foreach(Func func) const
+	{
+		for (const Shard& shard : shards_)
+		{
+			for (const auto& keyValuePair : shard.map_)
+			{
+				func(keyValuePair.first, keyValuePair.second);
+			}
+		}
+	}
+};
+
+#endif
@@ -0,0 +1,135 @@
+/*****************************************************************************
+ *  VATA Tree Automata Library
+ *
+ *  Copyright (c) 2015  Ondra Lengal <ilengal@fit.vutbr.cz>
+ *
+ *  Description:
+ *    Dense (bit vector) representation of sets of states.
+ *
+ *****************************************************************************/
+
+#ifndef _VATA_DENSE_STATE_SET_HH_
+#define _VATA_DENSE_STATE_SET_HH_
+
+#include <cstdint>
+#include <vector>
+
+namespace VATA { namespace Util {
+	class DenseStateSet;
+}}
+
+
+/**
+ * @brief  A set of states represented as a bit vector
+ *
+ * The set is meant for automata with a small number of states, where the
+ * operations on sets (inclusion, equality, hashing) are done on whole words
+ * instead of single states.  The vector never ends with a zero word, so equal
+ * sets have equal vectors.
+ */
+class VATA::Util::DenseStateSet
+{
+public:
+
+	typedef uint64_t Word;
+
+private:
+
+	static const size_t WORD_BITS = 64;
+
+	std::vector<Word> words_;
+
+public:
+
+	DenseStateSet() :
+		words_()
+	{ }
+
+	/**
+	 * @brief  Constructs the dense representation of a set of states
+	 */
+	template <
+		class StateSet>
+	explicit DenseStateSet(
+		const StateSet&        set) :
+		words_()
+	{
+		for (const auto& state : set)
+		{
+			this->Insert(state);
+		}
+	}
+
+	void Insert(size_t state)
+	{
+		const size_t word = state / WORD_BITS;
+		if (words_.size() <= word)
+		{
+			words_.resize(word + 1, 0);
+		}
+
+		words_[word] |= static_cast<Word>(1) << (state % WORD_BITS);
+	}
+
+	/**
+	 * @brief  Inserts all states of another set
+	 */
+	void InsertAll(const DenseStateSet& set)
+	{
+		if (words_.size() < set.words_.size())
+		{
+			words_.resize(set.words_.size(), 0);
+		}
+
+		for (size_t i = 0; i < set.words_.size(); ++i)
+		{
+			words_[i] |= set.words_[i];
+		}
+	}
+
+	bool Contains(size_t state) const
+	{
+		const size_t word = state / WORD_BITS;
+		return (word < words_.size()) &&
+			(words_[word] & (static_cast<Word>(1) << (state % WORD_BITS)));
+	}
+
+	/**
+	 * @brief  Checks whether the set is a subset of @p rhs
+	 */
+	bool IsSubsetOf(const DenseStateSet& rhs) const
+	{
+		if (words_.size() > rhs.words_.size())
+		{	// the last word is not zero
+			return false;
+		}
+
+		for (size_t i = 0; i < words_.size(); ++i)
+		{
+			if (words_[i] & ~rhs.words_[i])
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	bool operator==(const DenseStateSet& rhs) const
+	{
+		return words_ == rhs.words_;
+	}
+
+	size_t Hash() const
+	{
+		size_t result = words_.size();
+		for (const Word& word : words_)
+		{	// the combination of boost::hash_combine
+			result ^= static_cast<size_t>(word) + 0x9e3779b9 + (result << 6) + (result >> 2);
+		}
+
+		return result;
+	}
+};
+
+#endif
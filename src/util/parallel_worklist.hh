@@ -0,0 +1,234 @@
+/*****************************************************************************
+ *  VATA Tree Automata Library
+ *
+ *  Copyright (c) 2015  Ondra Lengal <ilengal@fit.vutbr.cz>
+ *
+ *  Description:
+ *    Work-stealing worklist processed by a pool of threads.
+ *
+ *****************************************************************************/
+
+#ifndef _VATA_PARALLEL_WORKLIST_HH_
+#define _VATA_PARALLEL_WORKLIST_HH_
+
+// standard library headers
+#include <atomic>
+#include <cassert>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+// insert class to proper namespace
+namespace VATA { namespace Util {
+	template <class Item> class ParallelWorklist;
+
+	/**
+	 * @brief  Returns the number of threads to be used
+	 *
+	 * @param[in]  requested  The requested number of threads (0 denotes the
+	 *                        number of hardware threads)
+	 */
+	inline size_t GetNumThreads(size_t requested)
+	{
+		if (0 != requested)
+		{
+			return requested;
+		}
+
+		size_t hwThreads = std::thread::hardware_concurrency();
+		return (0 == hwThreads)? 1 : hwThreads;
+	}
+}}
+
+
+/**
+ * @brief  Work-stealing worklist
+ *
+ * Every worker thread owns a queue of items.  A worker takes items from the
+ * back of its own queue (so that it proceeds in the depth-first manner) and,
+ * in case its queue is empty, steals items from the front of the queues of
+ * other workers.  The processing terminates when there is no pending item,
+ * i.e., all queues are empty and no item is being processed, or when
+ * processing is stopped by Stop().
+ *
+ * The processing function is called as @p func(workerId, item) and may add new
+ * items using Push(workerId, item).
+ */
+template <class Item>
+class VATA::Util::ParallelWorklist
+{
+private:  // data types
+
+	struct WorkQueue
+	{
+		std::mutex mutex_;
+		std::deque<Item> items_;
+
+		WorkQueue() :
+			mutex_(),
+			items_()
+		{ }
+	};
+
+private:  // data members
+
+	std::vector<WorkQueue> queues_;
+
+	/// the number of items that are queued or being processed
+	std::atomic<size_t> pending_;
+
+	std::atomic<bool> stopped_;
+
+private:  // methods
+
+	ParallelWorklist(const ParallelWorklist&);
+	ParallelWorklist& operator=(const ParallelWorklist&);
+
+	bool popOwn(size_t workerId, Item& item)
+	{
+		WorkQueue& queue = queues_[workerId];
+		std::lock_guard<std::mutex> lock(queue.mutex_);
+		if (queue.items_.empty())
+		{
+			return false;
+		}
+
+		item = std::move(queue.items_.back());
+		queue.items_.pop_back();
+		return true;
+	}
+
+	bool steal(size_t workerId, Item& item)
+	{
+		for (size_t i = 1; i < queues_.size(); ++i)
+		{
+			WorkQueue& queue = queues_[(workerId + i) % queues_.size()];
+			std::lock_guard<std::mutex> lock(queue.mutex_);
+			if (!queue.items_.empty())
+			{
+				item = std::move(queue.items_.front());
+				queue.items_.pop_front();
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	template <class ProcessFunc>
+	void work(size_t workerId, ProcessFunc& func)
+	{
+		Item item;
+		while (!stopped_)
+		{
+			if (this->popOwn(workerId, item) || this->steal(workerId, item))
+			{
+				func(workerId, item);
+				--pending_;
+			}
+			else if (0 == pending_)
+			{
+				return;
+			}
+			else
+			{
+				std::this_thread::yield();
+			}
+		}
+	}
+
+public:   // methods
+
+	explicit ParallelWorklist(size_t numWorkers) :
+		queues_(numWorkers),
+		pending_(0),
+		stopped_(false)
+	{
+		assert(0 < numWorkers);
+	}
+
+	size_t GetNumWorkers() const
+	{
+		return queues_.size();
+	}
+
+	void Push(size_t workerId, const Item& item)
+	{
+		assert(workerId < queues_.size());
+
+		++pending_;
+		WorkQueue& queue = queues_[workerId];
+		std::lock_guard<std::mutex> lock(queue.mutex_);
+		queue.items_.push_back(item);
+	}
+
+	/**
+	 * @brief  Stops the processing
+	 *
+	 * The workers finish the items being processed and terminate; the
+	 * remaining items are not processed.
+	 */
+	void Stop()
+	{
+		stopped_ = true;
+	}
+
+	bool IsStopped() const
+	{
+		return stopped_;
+	}
+
+	/**
+	 * @brief  Processes the worklist using all workers
+	 *
+	 * The first exception thrown by @p func stops the processing and is
+	 * rethrown from this method.
+	 */
+	template <class ProcessFunc>
+	void Run(ProcessFunc func)
+	{
+		std::exception_ptr error = nullptr;
+		std::mutex errorMutex;
+
+		auto worker = [&](size_t workerId)
+		{
+			try
+			{
+				this->work(workerId, func);
+			}
+			catch (...)
+			{
+				std::lock_guard<std::mutex> lock(errorMutex);
+				if (nullptr == error)
+				{
+					error = std::current_exception();
+				}
+
+				this->Stop();
+			}
+		};
+
+		std::vector<std::thread> threads;
+		for (size_t i = 1; i < queues_.size(); ++i)
+		{
+			threads.push_back(std::thread(worker, i));
+		}
+
+		worker(0);
+
+		for (std::thread& thread : threads)
+		{
+			thread.join();
+		}
+
+		if (nullptr != error)
+		{
+			std::rethrow_exception(error);
+		}
+	}
+};
+
+#endif
@@ -0,0 +1,153 @@
+/*****************************************************************************
+ *  VATA Tree Automata Library
+ *
+ *  Copyright (c) 2015  Ondra Lengal <ilengal@fit.vutbr.cz>
+ *
+ *  Description:
+ *    Partition of a set of consecutive numbers whose sets can be split.
+ *
+ *****************************************************************************/
+
+#ifndef _VATA_REFINABLE_PARTITION_HH_
+#define _VATA_REFINABLE_PARTITION_HH_
+
+// standard library headers
+#include <cassert>
+#include <utility>
+#include <vector>
+
+
+// insert class to proper namespace
+namespace VATA { namespace Util { class RefinablePartition; } }
+
+
+/**
+ * @brief  Partition of {0, ..., n-1} whose sets can be split
+ *
+ * Elements of a set are stored contiguously; marked elements are moved to
+ * the beginning of their set, so that splitting a set into its marked and
+ * unmarked part takes time proportional to the number of marked elements.
+ */
+class VATA::Util::RefinablePartition
+{
+private:  // data members
+
+	std::vector<size_t> elems_;
+	std::vector<size_t> loc_;
+	std::vector<size_t> setOf_;
+
+	std::vector<size_t> first_;
+	std::vector<size_t> mid_;
+	std::vector<size_t> end_;
+
+	/// sets with marked elements
+	std::vector<size_t> touched_;
+
+public:   // methods
+
+	RefinablePartition(
+		const std::vector<std::vector<size_t>>&   partition,
+		size_t                                    size) :
+		elems_(),
+		loc_(size),
+		setOf_(size),
+		first_(),
+		mid_(),
+		end_(),
+		touched_()
+	{
+		for (const std::vector<size_t>& block : partition)
+		{
+			if (block.empty())
+			{
+				continue;
+			}
+
+			first_.push_back(elems_.size());
+			mid_.push_back(elems_.size());
+
+			for (size_t elem : block)
+			{
+				assert(elem < size);
+
+				loc_[elem] = elems_.size();
+				setOf_[elem] = first_.size() - 1;
+				elems_.push_back(elem);
+			}
+
+			end_.push_back(elems_.size());
+		}
+
+		assert(elems_.size() == size);
+	}
+
+	size_t sets() const { return first_.size(); }
+
+	size_t setOf(size_t elem) const { return setOf_[elem]; }
+
+	size_t size(size_t set) const { return end_[set] - first_[set]; }
+
+	const size_t* begin(size_t set) const { return elems_.data() + first_[set]; }
+
+	const size_t* end(size_t set) const { return elems_.data() + end_[set]; }
+
+	void mark(size_t elem)
+	{
+		const size_t set = setOf_[elem];
+		const size_t i = loc_[elem];
+		const size_t j = mid_[set];
+		if (i < j)
+		{	// already marked
+			return;
+		}
+
+		if (j == first_[set])
+		{
+			touched_.push_back(set);
+		}
+
+		std::swap(elems_[i], elems_[j]);
+		loc_[elems_[i]] = i;
+		loc_[elems_[j]] = j;
+		++mid_[set];
+	}
+
+	/**
+	 * @brief  Splits the marked elements from their sets
+	 *
+	 * The marked elements form a new set (unless they form a whole set),
+	 * which is announced by calling @p newSetF(oldSet, newSet).  All marks
+	 * are removed.
+	 */
+	template <
+		class NewSetF>
+	void split(NewSetF newSetF)
+	{
+		for (size_t set : touched_)
+		{
+			if (mid_[set] == end_[set])
+			{	// everything is marked
+				mid_[set] = first_[set];
+				continue;
+			}
+
+			const size_t newSet = first_.size();
+			first_.push_back(first_[set]);
+			mid_.push_back(first_[set]);
+			end_.push_back(mid_[set]);
+
+			for (size_t i = first_[set]; i < mid_[set]; ++i)
+			{
+				setOf_[elems_[i]] = newSet;
+			}
+
+			first_[set] = mid_[set];
+
+			newSetF(set, newSet);
+		}
+
+		touched_.clear();
+	}
+};
+
+#endif
@@ -0,0 +1,150 @@
+/*****************************************************************************
+ *  VATA Tree Automata Library
+ *
+ *  Copyright (c) 2015  Ondra Lengal <ilengal@fit.vutbr.cz>
+ *
+ *  Description:
+ *    Test suite for the arena interning objects.
+ *
+ *****************************************************************************/
+
+// VATA headers
+#include <vata/vata.hh>
+
+#include "../src/util/arena.hh"
+
+// Standard library headers
+#include <set>
+#include <vector>
+
+// Boost headers
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE Arena
+#include <boost/test/unit_test.hpp>
+
+// testing headers
+#include "log_fixture.hh"
+
+
+/******************************************************************************
+ *                                  Fixtures                                  *
+ ******************************************************************************/
+
+class ArenaFixture : public LogFixture
+{
+protected:// data types
+
+	using Tuple       = std::vector<size_t>;
+	using TupleArena  = VATA::Util::Arena<Tuple>;
+	using TuplePtr    = TupleArena::Ptr;
+	using ArenaPtr    = TupleArena::ArenaPtr;
+
+	/**
+	 * @brief  An object counting its living instances
+	 */
+	struct Counted
+	{
+		static size_t living;
+
+		size_t value;
+
+		explicit Counted(size_t v) : value(v) { ++living; }
+		Counted(const Counted& rhs) : value(rhs.value) { ++living; }
+		~Counted() { --living; }
+
+		bool operator==(const Counted& rhs) const { return value == rhs.value; }
+
+		friend size_t hash_value(const Counted& x) { return x.value; }
+	};
+};
+
+size_t ArenaFixture::Counted::living = 0;
+
+
+/******************************************************************************
+ *                                 Test cases                                 *
+ ******************************************************************************/
+
+BOOST_FIXTURE_TEST_SUITE(suite, ArenaFixture)
+
+BOOST_AUTO_TEST_CASE(interning)
+{
+	TupleArena arena;
+	BOOST_CHECK(arena.empty());
+
+	TuplePtr first = arena.lookup(Tuple({1, 2}));
+	TuplePtr second = arena.lookup(Tuple({1, 2}));
+	TuplePtr other = arena.lookup(Tuple({2, 1}));
+
+	BOOST_CHECK(first == second);
+	BOOST_CHECK(first != other);
+	BOOST_CHECK((first < other) != (other < first));
+	BOOST_CHECK(*first == Tuple({1, 2}));
+	BOOST_CHECK(*other == Tuple({2, 1}));
+	BOOST_CHECK_EQUAL(arena.size(), 2);
+
+	BOOST_CHECK(arena.find(Tuple({2, 1})) == other);
+	BOOST_CHECK(arena.find(Tuple({3})) == nullptr);
+	BOOST_CHECK(!TuplePtr());
+}
+
+BOOST_AUTO_TEST_CASE(stable_handles)
+{
+	TupleArena arena;
+
+	std::vector<TuplePtr> ptrs;
+	for (size_t i = 0; i < 10000; ++i)
+	{
+		ptrs.push_back(arena.lookup(Tuple({i, i + 1})));
+	}
+
+	// handles do not change when the arena grows
+	std::set<TuplePtr> distinct(ptrs.begin(), ptrs.end());
+	BOOST_CHECK_EQUAL(distinct.size(), ptrs.size());
+
+	for (size_t i = 0; i < ptrs.size(); ++i)
+	{
+		BOOST_REQUIRE(arena.lookup(Tuple({i, i + 1})) == ptrs[i]);
+		BOOST_REQUIRE(*ptrs[i] == Tuple({i, i + 1}));
+	}
+
+	BOOST_CHECK_EQUAL(arena.size(), ptrs.size());
+}
+
+BOOST_AUTO_TEST_CASE(bulk_free)
+{
+	{
+		VATA::Util::Arena<Counted> arena;
+		for (size_t i = 0; i < 100; ++i)
+		{
+			arena.lookup(Counted(i % 50));
+		}
+
+		BOOST_CHECK_EQUAL(arena.size(), 50);
+		BOOST_CHECK_EQUAL(Counted::living, 50);
+	}
+
+	// the objects are freed together with the arena
+	BOOST_CHECK_EQUAL(Counted::living, 0);
+}
+
+BOOST_AUTO_TEST_CASE(retained_arenas)
+{
+	ArenaPtr retained(new TupleArena());
+	TuplePtr ptr = retained->lookup(Tuple({5, 6, 7}));
+
+	ArenaPtr arena(new TupleArena());
+	arena->retain(retained);
+	arena->retain(retained);
+	arena->retain(arena);
+	BOOST_CHECK_EQUAL(retained.use_count(), 2);
+	BOOST_CHECK_EQUAL(arena.use_count(), 1);
+
+	// handles of different arenas differ even for equal objects
+	BOOST_CHECK(arena->lookup(Tuple({5, 6, 7})) != ptr);
+
+	retained.reset();
+	BOOST_CHECK(*ptr == Tuple({5, 6, 7}));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
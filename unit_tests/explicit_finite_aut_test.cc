@@ -0,0 +1,187 @@
+/*****************************************************************************
+ *  VATA Tree Automata Library
+ *
+ *  Copyright (c) 2015  Ondra Lengal <ilengal@fit.vutbr.cz>
+ *
+ *  Description:
+ *    Test suite for inclusion of explicitly represented finite automata.
+ *
+ *****************************************************************************/
+
+// VATA headers
+#include <vata/vata.hh>
+#include <vata/explicit_finite_aut.hh>
+#include <vata/incl_param.hh>
+
+// Standard library headers
+#include <random>
+#include <vector>
+
+// Boost headers
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE ExplicitFiniteAut
+#include <boost/test/unit_test.hpp>
+
+// testing headers
+#include "log_fixture.hh"
+
+
+/******************************************************************************
+ *                                  Fixtures                                  *
+ ******************************************************************************/
+
+class ExplicitFiniteAutFixture : public LogFixture
+{
+protected:// data types
+
+	using AutType     = VATA::ExplicitFiniteAut;
+	using InclParam   = VATA::InclParam;
+
+protected:// methods
+
+	/**
+	 * @brief  Parameters of all compared inclusion checks
+	 *
+	 * Antichains and congruences (in both search orders) are checked with
+	 * macrostates stored as sets and as bit vectors.
+	 */
+	static std::vector<InclParam> inclParams()
+	{
+		std::vector<InclParam> result;
+		for (size_t denseLimit : {static_cast<size_t>(0), static_cast<size_t>(4096)})
+		{
+			InclParam antichains;
+			antichains.SetDenseMacroStateLimit(denseLimit);
+			result.push_back(antichains);
+
+			for (InclParam::e_search_order order :
+				{InclParam::e_search_order::depth, InclParam::e_search_order::breadth})
+			{
+				InclParam congr;
+				congr.SetAlgorithm(InclParam::e_algorithm::congruences);
+				congr.SetSearchOrder(order);
+				congr.SetDenseMacroStateLimit(denseLimit);
+				result.push_back(congr);
+			}
+		}
+
+		return result;
+	}
+
+	/**
+	 * @brief  Generates a random automaton
+	 *
+	 * The states of the automaton are @p offset, ..., @p offset + @p numStates
+	 * - 1, where @p offset is initial.
+	 */
+	static AutType randomAut(
+		std::mt19937&          gen,
+		size_t                 numStates,
+		size_t                 offset,
+		size_t                 numTrans,
+		size_t                 numSymbols)
+	{
+		AutType aut;
+
+		aut.SetStateStart(offset, 0);
+		if (gen() % 2)
+		{
+			aut.SetStateStart(offset + gen() % numStates, 0);
+		}
+
+		for (size_t i = 0; i < numTrans; ++i)
+		{
+			const size_t lhs = offset + gen() % numStates;
+			const size_t symbol = gen() % numSymbols;
+			const size_t rhs = offset + gen() % numStates;
+			aut.AddTransition(lhs, symbol, rhs);
+		}
+
+		const size_t numFinal = 1 + gen() % (numStates / 3 + 1);
+		for (size_t i = 0; i < numFinal; ++i)
+		{
+			aut.SetStateFinal(offset + gen() % numStates);
+		}
+
+		return aut;
+	}
+};
+
+
+/******************************************************************************
+ *                                 Test cases                                 *
+ ******************************************************************************/
+
+BOOST_FIXTURE_TEST_SUITE(suite, ExplicitFiniteAutFixture)
+
+BOOST_AUTO_TEST_CASE(inclusion_dense_macrostates)
+{
+	// the check of dense macrostates used to loop on this pair
+	AutType smaller;
+	smaller.SetStateStart(0, 0);
+	smaller.AddTransition(2, 0, 2);
+	smaller.AddTransition(2, 0, 0);
+	smaller.AddTransition(0, 1, 2);
+	smaller.AddTransition(0, 1, 0);
+	smaller.AddTransition(2, 1, 2);
+	smaller.AddTransition(2, 1, 1);
+	smaller.SetStateFinal(0);
+
+	AutType bigger;
+	bigger.SetStateStart(10000, 0);
+	bigger.SetStateStart(10001, 0);
+	bigger.AddTransition(10001, 1, 10001);
+	bigger.AddTransition(10003, 0, 10001);
+	bigger.AddTransition(10000, 0, 10000);
+	bigger.AddTransition(10001, 1, 10000);
+	bigger.AddTransition(10000, 0, 10004);
+	bigger.AddTransition(10004, 0, 10000);
+	bigger.AddTransition(10003, 1, 10000);
+	bigger.AddTransition(10000, 1, 10000);
+	bigger.AddTransition(10000, 1, 10003);
+	bigger.AddTransition(10003, 1, 10001);
+	bigger.SetStateFinal(10000);
+	bigger.SetStateFinal(10003);
+
+	for (const InclParam& ip : inclParams())
+	{
+		BOOST_CHECK_MESSAGE(AutType::CheckInclusion(smaller, bigger, ip),
+			"Inclusion does not hold for " + ip.toString());
+	}
+}
+
+BOOST_AUTO_TEST_CASE(inclusion_random)
+{
+	const size_t numStates = 6;
+	const size_t numSymbols = 2;
+
+	std::mt19937 gen(11);
+	const std::vector<InclParam> params = inclParams();
+
+	for (size_t i = 0; i < 300; ++i)
+	{
+		const size_t smallerStates = numStates / 2 + gen() % numStates;
+		const size_t biggerStates = numStates / 2 + gen() % numStates;
+
+		AutType smaller = randomAut(
+			gen, smallerStates, 0, 2 * smallerStates, numSymbols);
+		AutType bigger = randomAut(
+			gen, biggerStates, 10000, 2 * biggerStates, numSymbols);
+
+		if (gen() % 2)
+		{
+			bigger = AutType::UnionDisjointStates(bigger, randomAut(
+				gen, smallerStates, 20000, 2 * smallerStates, numSymbols));
+		}
+
+		const bool expected = AutType::CheckInclusion(smaller, bigger, params[0]);
+		for (const InclParam& ip : params)
+		{
+			BOOST_CHECK_MESSAGE(
+				expected == AutType::CheckInclusion(smaller, bigger, ip),
+				"Wrong inclusion result for " + ip.toString());
+		}
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -66,6 +66,23 @@ BOOST_AUTO_TEST_CASE(aut_down_inclusion_nonrec_sim)
 	testInclusion(ip);
 }
 
+BOOST_AUTO_TEST_CASE(aut_down_inclusion_nonrec_nosim_parallel)
+{
+	VATA::InclParam ip;
+	ip.SetDirection(InclParam::e_direction::downward);
+	ip.SetNumThreads(4);
+	testInclusion(ip);
+}
+
+BOOST_AUTO_TEST_CASE(aut_down_inclusion_nonrec_sim_parallel)
+{
+	VATA::InclParam ip;
+	ip.SetDirection(InclParam::e_direction::downward);
+	ip.SetUseSimulation(true);
+	ip.SetNumThreads(4);
+	testInclusion(ip);
+}
+
 BOOST_AUTO_TEST_CASE(aut_down_inclusion_rec_sim)
 {
 	VATA::InclParam ip;
@@ -100,6 +117,39 @@ BOOST_AUTO_TEST_CASE(aut_up_inclusion_sim)
 	testInclusion(ip);
 }
 
+BOOST_AUTO_TEST_CASE(aut_up_inclusion_parallel)
+{
+	VATA::InclParam ip;
+	ip.SetDirection(InclParam::e_direction::upward);
+	ip.SetNumThreads(4);
+	testInclusion(ip);
+}
+
+BOOST_AUTO_TEST_CASE(aut_up_inclusion_sim_parallel)
+{
+	VATA::InclParam ip;
+	ip.SetDirection(InclParam::e_direction::upward);
+	ip.SetUseSimulation(true);
+	ip.SetNumThreads(4);
+	testInclusion(ip);
+}
+
+BOOST_AUTO_TEST_CASE(aut_congr_inclusion)
+{
+	VATA::InclParam ip;
+	ip.SetAlgorithm(InclParam::e_algorithm::congruences);
+	ip.SetSearchOrder(InclParam::e_search_order::depth);
+	testInclusion(ip);
+}
+
+BOOST_AUTO_TEST_CASE(aut_congr_inclusion_breadth)
+{
+	VATA::InclParam ip;
+	ip.SetAlgorithm(InclParam::e_algorithm::congruences);
+	ip.SetSearchOrder(InclParam::e_search_order::breadth);
+	testInclusion(ip);
+}
+
 BOOST_AUTO_TEST_CASE(iterators)
 {
 	this->runOnAutomataSet(
@@ -646,4 +696,1123 @@ BOOST_AUTO_TEST_CASE(complement)
 		});
 }
 
+BOOST_AUTO_TEST_CASE(frozen_storage)
+{
+	this->runOnAutomataSet(
+		[](const AutType& aut, const StateDict& stateDict, const std::string& filename)
+		{
+			BOOST_TEST_MESSAGE("Checking frozen storage for " + filename + "...");
+
+			AutType frozenAut(aut);
+			frozenAut.Freeze();
+			BOOST_REQUIRE_MESSAGE(frozenAut.IsFrozen(), "Freeze() has no effect");
+			BOOST_REQUIRE_MESSAGE(!aut.IsFrozen(), "Freeze() affects a copy");
+
+			AutDescription descUseless =
+				aut.RemoveUselessStates().DumpToAutDesc(stateDict);
+			AutDescription descFrozenUseless =
+				frozenAut.RemoveUselessStates().DumpToAutDesc(stateDict);
+
+			BOOST_REQUIRE_MESSAGE(descUseless == descFrozenUseless,
+				"\n\nInvalid removal of useless states on a frozen automaton.\n\n"
+				"Expected:\n===========\n" +
+				TimbukSerializer().Serialize(descUseless) + "\nGot:\n===========\n" +
+				TimbukSerializer().Serialize(descFrozenUseless) + "\n===========");
+
+			SimParam sp;
+			sp.SetRelation(VATA::SimParam::e_sim_relation::TA_DOWNWARD);
+			sp.SetNumStates(stateDict.size());
+			StateDiscontBinaryRelation sim = aut.ComputeSimulation(sp);
+			StateDiscontBinaryRelation frozenSim = frozenAut.ComputeSimulation(sp);
+
+			for (const auto& firstStringStatePair : stateDict)
+			{
+				for (const auto& secondStringStatePair : stateDict)
+				{
+					const StateType& firstState = firstStringStatePair.second;
+					const StateType& secondState = secondStringStatePair.second;
+
+					BOOST_REQUIRE_MESSAGE(sim.get(firstState, secondState) ==
+						frozenSim.get(firstState, secondState),
+						"Invalid simulation value on a frozen automaton for (" +
+						firstStringStatePair.first + ", " + secondStringStatePair.first + ")");
+				}
+			}
+
+			// queries do not drop the frozen storage
+			BOOST_REQUIRE_MESSAGE(aut.AreTransitionsEmpty() == frozenAut.AreTransitionsEmpty(),
+				"Invalid emptiness of transitions of a frozen automaton");
+
+			AutDescription descFrozen = frozenAut.DumpToAutDesc(stateDict);
+			BOOST_REQUIRE_MESSAGE(aut.DumpToAutDesc(stateDict) == descFrozen,
+				"\n\nInvalid transitions of a frozen automaton.\n\n"
+				"Got:\n===========\n" +
+				TimbukSerializer().Serialize(descFrozen) + "\n===========");
+
+			BOOST_REQUIRE_MESSAGE(frozenAut.IsFrozen(),
+				"A query on a frozen automaton drops the frozen storage");
+
+			// modification drops the frozen storage
+			frozenAut.AddTransition(StateTuple(), 0, 0);
+			BOOST_REQUIRE_MESSAGE(!frozenAut.IsFrozen(),
+				"Modification of a frozen automaton does not drop the frozen storage");
+		});
+}
+
+BOOST_AUTO_TEST_CASE(frozen_intersection)
+{
+	this->runOnSmallAutomataSet(
+		[](const AutType& aut, const StateDict& /* stateDict */, const std::string& filename)
+		{
+			BOOST_TEST_MESSAGE("Checking intersection of frozen automata for " + filename + "...");
+
+			AutType autCmpl = aut.Complement();
+			AutType isectAut = AutType::Intersection(aut, aut);
+
+			AutType frozenAut(aut);
+			frozenAut.Freeze();
+			autCmpl.Freeze();
+
+			AutType frozenIsectAut = AutType::Intersection(frozenAut, frozenAut);
+			BOOST_REQUIRE_MESSAGE(
+				AutType::CheckInclusion(isectAut, frozenIsectAut) &&
+				AutType::CheckInclusion(frozenIsectAut, isectAut),
+				"The language of the intersection of frozen automata differs");
+
+			BOOST_REQUIRE_MESSAGE(
+				AutType::Intersection(frozenAut, autCmpl).IsLangEmpty(),
+				"The language of the intersection with the complement needs to be empty");
+		});
+}
+
+BOOST_AUTO_TEST_CASE(frozen_inclusion)
+{
+	auto testfileContent = ParseTestFile(INCLUSION_TIMBUK_FILE.string());
+
+	for (auto testcase : testfileContent)
+	{
+		BOOST_REQUIRE_MESSAGE(testcase.size() == 3, "Invalid format of a testcase: " +
+			Convert::ToString(testcase));
+
+		std::string inputSmallerFile = (AUT_DIR / testcase[0]).string();
+		std::string inputBiggerFile = (AUT_DIR / testcase[1]).string();
+		bool expectedResult = static_cast<bool>(
+			Convert::FromString<unsigned>(testcase[2]));
+
+		BOOST_TEST_MESSAGE("Testing inclusion of frozen automata " +
+			inputSmallerFile + " <= " + inputBiggerFile  + "...");
+
+		AutType autSmaller;
+		readAut(autSmaller, VATA::Util::ReadFile(inputSmallerFile));
+		autSmaller.Freeze();
+
+		AutType autBigger;
+		readAut(autBigger, VATA::Util::ReadFile(inputBiggerFile));
+		autBigger.Freeze();
+
+		for (auto direction : {InclParam::e_direction::downward, InclParam::e_direction::upward})
+		{
+			VATA::InclParam ip;
+			ip.SetDirection(direction);
+
+			bool doesInclusionHold = AutType::CheckInclusion(autSmaller, autBigger, ip);
+			BOOST_CHECK_MESSAGE(expectedResult == doesInclusionHold,
+				"\n\nError checking inclusion " + inputSmallerFile + " <= " +
+				inputBiggerFile + ": expected " + Convert::ToString(expectedResult) +
+				", got " + Convert::ToString(doesInclusionHold));
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE(bulk_adding_transitions)
+{
+	this->runOnAutomataSet(
+		[](const AutType& aut, const StateDict& /* stateDict */, const std::string& filename)
+		{
+			BOOST_TEST_MESSAGE("Checking AddTransitions() for " + filename + "...");
+
+			std::vector<Transition> transitions;
+			for (const Transition& trans : aut)
+			{
+				transitions.push_back(trans);
+			}
+
+			// the first half is added to a nonempty automaton, with duplicates
+			std::vector<Transition> firstHalf(transitions.begin(),
+				transitions.begin() + transitions.size() / 2);
+			std::vector<Transition> secondHalf(
+				transitions.begin() + transitions.size() / 2, transitions.end());
+			firstHalf.insert(firstHalf.end(), transitions.begin(), transitions.end());
+
+			AutType bulkAut;
+			bulkAut.AddTransitions(secondHalf);
+			bulkAut.AddTransitions(firstHalf);
+
+			size_t transCnt = 0;
+			for (const Transition& trans : bulkAut)
+			{
+				BOOST_REQUIRE_MESSAGE(aut.ContainsTransition(trans),
+					"The transition " + aut.ToString(trans) + " was not added");
+				++transCnt;
+			}
+
+			BOOST_REQUIRE_MESSAGE(transitions.size() == transCnt,
+				"Invalid number of transitions: expected " +
+				Convert::ToString(transitions.size()) + ", got " +
+				Convert::ToString(transCnt));
+		});
+}
+
+BOOST_AUTO_TEST_CASE(parallel_intersection)
+{
+	this->runOnSmallAutomataSet(
+		[](const AutType& aut, const StateDict& /* stateDict */, const std::string& filename)
+		{
+			BOOST_TEST_MESSAGE("Checking parallel intersection for " + filename + "...");
+
+			VATA::IsectParam ip;
+			ip.SetAlgorithm(VATA::IsectParam::e_isect_algorithm::TOP_DOWN_PARALLEL);
+			ip.SetNumThreads(4);
+
+			AutType isectAut = AutType::Intersection(aut, aut);
+			AutType parIsectAut = AutType::Intersection(aut, aut, ip);
+
+			size_t transCnt = 0;
+			for (const Transition& trans : isectAut) { (void)trans; ++transCnt; }
+			size_t parTransCnt = 0;
+			for (const Transition& trans : parIsectAut) { (void)trans; ++parTransCnt; }
+
+			BOOST_REQUIRE_MESSAGE(transCnt == parTransCnt,
+				"Invalid number of transitions of the parallel intersection: expected " +
+				Convert::ToString(transCnt) + ", got " + Convert::ToString(parTransCnt));
+			BOOST_REQUIRE_MESSAGE(
+				isectAut.GetFinalStates().size() == parIsectAut.GetFinalStates().size(),
+				"Invalid number of final states of the parallel intersection");
+			BOOST_REQUIRE_MESSAGE(
+				AutType::CheckInclusion(isectAut, parIsectAut) &&
+				AutType::CheckInclusion(parIsectAut, isectAut),
+				"The language of the parallel intersection differs");
+
+			AutType autCmpl = aut.Complement();
+			BOOST_REQUIRE_MESSAGE(
+				AutType::Intersection(aut, autCmpl, ip).IsLangEmpty(),
+				"The language of the intersection with the complement needs to be empty");
+		});
+}
+
+BOOST_AUTO_TEST_CASE(intersection_emptiness)
+{
+	this->runOnSmallAutomataSet(
+		[](const AutType& aut, const StateDict& /* stateDict */, const std::string& filename)
+		{
+			BOOST_TEST_MESSAGE("Checking emptiness of intersection for " + filename + "...");
+
+			AutType witness;
+			bool isEmpty = AutType::IsIntersectionEmpty(aut, aut, &witness);
+			BOOST_REQUIRE_MESSAGE(isEmpty == aut.IsLangEmpty(),
+				"Invalid result of the emptiness check of the intersection");
+			BOOST_REQUIRE_MESSAGE(
+				isEmpty == AutType::IsIntersectionEmpty({&aut, &aut, &aut}),
+				"Invalid result of the emptiness check of the ternary intersection");
+
+			if (!isEmpty)
+			{
+				BOOST_REQUIRE_MESSAGE(!witness.IsLangEmpty(),
+					"The witness of the intersection needs to be non-empty");
+				BOOST_REQUIRE_MESSAGE(AutType::CheckInclusion(witness, aut),
+					"The witness of the intersection needs to be accepted");
+			}
+
+			AutType autCmpl = aut.Complement();
+			BOOST_REQUIRE_MESSAGE(AutType::IsIntersectionEmpty(aut, autCmpl),
+				"The intersection with the complement needs to be empty");
+		});
+}
+
+BOOST_AUTO_TEST_CASE(sparse_simulation)
+{
+	this->runOnSmallAutomataSet(
+		[](const AutType& aut, const StateDict& stateDict, const std::string& filename)
+		{
+			BOOST_TEST_MESSAGE("Checking sparse simulation for " + filename + "...");
+
+			std::vector<SimParam::e_sim_relation> relations =
+				{SimParam::e_sim_relation::TA_DOWNWARD};
+			if (aut.begin() != aut.end())
+			{	// upward simulation is not computed for automata without transitions
+				relations.push_back(SimParam::e_sim_relation::TA_UPWARD);
+			}
+
+			for (SimParam::e_sim_relation relation : relations)
+			{
+				SimParam sp;
+				sp.SetRelation(relation);
+				sp.SetNumStates(stateDict.size());
+				StateDiscontBinaryRelation sim = aut.ComputeSimulation(sp);
+				AutBase::StateSparseDiscontBinaryRelation sparseSim =
+					aut.ComputeSparseSimulation(sp);
+
+				for (const auto& firstStringStatePair : stateDict)
+				{
+					for (const auto& secondStringStatePair : stateDict)
+					{
+						const StateType& firstState = firstStringStatePair.second;
+						const StateType& secondState = secondStringStatePair.second;
+
+						BOOST_REQUIRE_MESSAGE(sim.get(firstState, secondState) ==
+							sparseSim.get(firstState, secondState),
+							"Invalid value of the sparse simulation for (" +
+							firstStringStatePair.first + ", " + secondStringStatePair.first + ")");
+					}
+				}
+			}
+
+			// inclusion with the sparse simulation
+			AutType smaller(aut);
+			AutType bigger(aut);
+			AutBase::StateType states = AutBase::SanitizeAutsForInclusion(smaller, bigger);
+			AutType unionAut = AutType::UnionDisjointStates(smaller, bigger);
+
+			SimParam sp;
+			sp.SetRelation(VATA::SimParam::e_sim_relation::TA_DOWNWARD);
+			sp.SetNumStates(states);
+			AutBase::StateSparseDiscontBinaryRelation sparseSim =
+				unionAut.ComputeSparseSimulation(sp);
+
+			InclParam ip;
+			ip.SetDirection(InclParam::e_direction::downward);
+			ip.SetUseSimulation(true);
+			ip.SetSimulation(&sparseSim);
+			BOOST_REQUIRE_MESSAGE(AutType::CheckInclusion(smaller, bigger, ip),
+				"Inclusion with a sparse simulation does not hold for " + filename);
+		});
+}
+
+BOOST_AUTO_TEST_CASE(parallel_simulation)
+{
+	this->runOnSmallAutomataSet(
+		[](const AutType& aut, const StateDict& stateDict, const std::string& filename)
+		{
+			BOOST_TEST_MESSAGE("Checking parallel simulation for " + filename + "...");
+
+			std::vector<SimParam::e_sim_relation> relations =
+				{SimParam::e_sim_relation::TA_DOWNWARD};
+			if (aut.begin() != aut.end())
+			{	// upward simulation is not computed for automata without transitions
+				relations.push_back(SimParam::e_sim_relation::TA_UPWARD);
+			}
+
+			for (SimParam::e_sim_relation relation : relations)
+			{
+				SimParam sp;
+				sp.SetRelation(relation);
+				sp.SetNumStates(stateDict.size());
+				StateDiscontBinaryRelation sim = aut.ComputeSimulation(sp);
+
+				sp.SetNumThreads(4);
+				StateDiscontBinaryRelation parSim = aut.ComputeSimulation(sp);
+
+				for (const auto& firstStringStatePair : stateDict)
+				{
+					for (const auto& secondStringStatePair : stateDict)
+					{
+						const StateType& firstState = firstStringStatePair.second;
+						const StateType& secondState = secondStringStatePair.second;
+
+						BOOST_REQUIRE_MESSAGE(sim.get(firstState, secondState) ==
+							parSim.get(firstState, secondState),
+							"Invalid value of the parallel simulation for (" +
+							firstStringStatePair.first + ", " + secondStringStatePair.first + ")");
+					}
+				}
+			}
+		});
+}
+
+BOOST_AUTO_TEST_CASE(simulation_cache)
+{
+	this->runOnSmallAutomataSet(
+		[](const AutType& aut, const StateDict& stateDict, const std::string& filename)
+		{
+			BOOST_TEST_MESSAGE("Checking simulation cache for " + filename + "...");
+
+			if (aut.begin() == aut.end())
+			{
+				return;
+			}
+
+			AutType cachedAut(aut);
+			cachedAut.EnableSimulationCache();
+			BOOST_REQUIRE(cachedAut.IsSimulationCacheEnabled());
+
+			SimParam sp;
+			sp.SetRelation(VATA::SimParam::e_sim_relation::TA_DOWNWARD);
+			sp.SetNumStates(stateDict.size());
+
+			auto checkSimF = [&stateDict, &filename, &sp](
+				const AutType& cached, const std::string& msg)
+			{
+				// a copy does not share the cache
+				AutType uncached(cached);
+				BOOST_REQUIRE(!uncached.IsSimulationCacheEnabled());
+
+				StateDiscontBinaryRelation sim = uncached.ComputeSimulation(sp);
+				StateDiscontBinaryRelation first = cached.ComputeSimulation(sp);
+				StateDiscontBinaryRelation second = cached.ComputeSimulation(sp);
+
+				for (const auto& firstStringStatePair : stateDict)
+				{
+					for (const auto& secondStringStatePair : stateDict)
+					{
+						const StateType& firstState = firstStringStatePair.second;
+						const StateType& secondState = secondStringStatePair.second;
+
+						BOOST_REQUIRE_MESSAGE(
+							(sim.get(firstState, secondState) == first.get(firstState, secondState)) &&
+							(sim.get(firstState, secondState) == second.get(firstState, secondState)),
+							"Invalid value of the cached simulation " + msg + " for " +
+							filename + " (" + firstStringStatePair.first + ", " +
+							secondStringStatePair.first + ")");
+					}
+				}
+			};
+
+			checkSimF(cachedAut, "");
+
+			// the modification needs to invalidate the cache
+			const Transition trans = *aut.begin();
+			cachedAut.AddTransition(trans.GetChildren(), trans.GetSymbol(),
+				stateDict.begin()->second);
+			checkSimF(cachedAut, "after modification");
+
+			// the upward simulation depends on final states, so their
+			// modification needs to invalidate the cache too
+			AutType upCachedAut(aut);
+			upCachedAut.EnableSimulationCache();
+			sp.SetRelation(VATA::SimParam::e_sim_relation::TA_UPWARD);
+			checkSimF(upCachedAut, "upward");
+			for (const auto& stringStatePair : stateDict)
+			{
+				if (!upCachedAut.IsStateFinal(stringStatePair.second))
+				{
+					upCachedAut.SetStateFinal(stringStatePair.second);
+					checkSimF(upCachedAut, "upward after adding a final state");
+
+					upCachedAut.EraseFinalStates();
+					upCachedAut.SetStatesFinal(std::set<StateType>(
+						aut.GetFinalStates().begin(), aut.GetFinalStates().end()));
+					checkSimF(upCachedAut, "upward after erasing final states");
+					break;
+				}
+			}
+
+			// inclusion computes the simulation itself
+			AutType smaller(aut);
+			AutType bigger(aut);
+			AutBase::SanitizeAutsForInclusion(smaller, bigger);
+			bigger.EnableSimulationCache();
+
+			for (InclParam::e_direction dir :
+				{InclParam::e_direction::upward, InclParam::e_direction::downward})
+			{
+				InclParam ip;
+				ip.SetDirection(dir);
+				ip.SetUseSimulation(true);
+				BOOST_REQUIRE_MESSAGE(AutType::CheckInclusion(smaller, bigger, ip) &&
+					AutType::CheckInclusion(smaller, bigger, ip),
+					"Inclusion with a cached simulation does not hold for " + filename);
+
+				if ((smaller.begin() == smaller.end()) || bigger.GetFinalStates().empty())
+				{
+					continue;
+				}
+
+				// the cache keeps only the last simulation for inclusion, and the
+				// modification of the smaller automaton makes it stale
+				AutType modified(smaller);
+				const Transition trans = *smaller.begin();
+				modified.AddTransition(trans.GetChildren(), trans.GetSymbol(),
+					*bigger.GetFinalStates().begin());
+
+				AutType uncachedBigger(bigger);
+				for (const AutType* partner : {&modified, &smaller, &modified})
+				{
+					BOOST_REQUIRE_MESSAGE(
+						AutType::CheckInclusion(*partner, bigger, ip) ==
+						AutType::CheckInclusion(*partner, uncachedBigger, ip),
+						"Invalid inclusion with a cached simulation for " + filename);
+				}
+			}
+		});
+}
+
+BOOST_AUTO_TEST_CASE(inclusion_computed_simulation)
+{
+	auto testfileContent = ParseTestFile(INCLUSION_TIMBUK_FILE.string());
+
+	for (auto testcase : testfileContent)
+	{
+		BOOST_REQUIRE_MESSAGE(testcase.size() == 3, "Invalid format of a testcase: " +
+			Convert::ToString(testcase));
+
+		std::string inputSmallerFile = (AUT_DIR / testcase[0]).string();
+		std::string inputBiggerFile = (AUT_DIR / testcase[1]).string();
+		bool expectedResult = static_cast<bool>(
+			Convert::FromString<unsigned>(testcase[2]));
+
+		BOOST_TEST_MESSAGE("Testing inclusion with a computed simulation " +
+			inputSmallerFile + " <= " + inputBiggerFile  + "...");
+
+		// the automata are not sanitized, their states may overlap
+		AutType autSmaller;
+		readAut(autSmaller, VATA::Util::ReadFile(inputSmallerFile));
+
+		AutType autBigger;
+		readAut(autBigger, VATA::Util::ReadFile(inputBiggerFile));
+		autBigger.EnableSimulationCache();
+
+		for (InclParam::e_direction dir :
+			{InclParam::e_direction::upward, InclParam::e_direction::downward})
+		{
+			InclParam ip;
+			ip.SetDirection(dir);
+			ip.SetUseSimulation(true);
+
+			BOOST_REQUIRE_MESSAGE(
+				(expectedResult == AutType::CheckInclusion(autSmaller, autBigger, ip)) &&
+				(expectedResult == AutType::CheckInclusion(autSmaller, autBigger, ip)),
+				"Error checking inclusion with a computed simulation " +
+				inputSmallerFile + " <= " + inputBiggerFile);
+
+			BOOST_REQUIRE_MESSAGE(AutType::CheckInclusion(autBigger, autBigger, ip),
+				"Inclusion with a computed simulation does not hold for " +
+				inputBiggerFile + " <= " + inputBiggerFile);
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE(incremental_simulation)
+{
+	this->runOnSmallAutomataSet(
+		[](const AutType& aut, const StateDict& stateDict, const std::string& filename)
+		{
+			BOOST_TEST_MESSAGE("Checking incremental simulation for " + filename + "...");
+
+			// split the transitions into kept and modified ones
+			std::vector<Transition> kept;
+			std::vector<Transition> modified;
+			size_t i = 0;
+			for (const Transition& trans : aut)
+			{
+				((0 == i++ % 3)? modified : kept).push_back(trans);
+			}
+
+			AutType smallAut;
+			std::set<StateType> smallStates;
+			for (const Transition& trans : kept)
+			{
+				smallAut.AddTransition(trans);
+				smallStates.insert(trans.GetParent());
+				smallStates.insert(trans.GetChildren().begin(), trans.GetChildren().end());
+			}
+
+			for (const StateType& state : aut.GetFinalStates())
+			{
+				smallAut.SetStateFinal(state);
+			}
+
+			SimParam sp;
+			sp.SetRelation(VATA::SimParam::e_sim_relation::TA_DOWNWARD);
+			sp.SetNumStates(stateDict.size());
+
+			StateDiscontBinaryRelation smallSim = smallAut.ComputeSimulation(sp);
+			StateDiscontBinaryRelation sim = aut.ComputeSimulation(sp);
+
+			// adding, then removing the transitions
+			StateDiscontBinaryRelation addedSim =
+				aut.RecomputeSimulation(sp, smallSim, modified);
+			StateDiscontBinaryRelation removedSim =
+				smallAut.RecomputeSimulation(sp, sim, {}, modified);
+
+			for (const auto& firstStringStatePair : stateDict)
+			{
+				for (const auto& secondStringStatePair : stateDict)
+				{
+					const StateType& firstState = firstStringStatePair.second;
+					const StateType& secondState = secondStringStatePair.second;
+
+					BOOST_REQUIRE_MESSAGE(sim.get(firstState, secondState) ==
+						addedSim.get(firstState, secondState),
+						"Invalid value of the simulation after adding transitions for (" +
+						firstStringStatePair.first + ", " + secondStringStatePair.first + ")");
+
+					if (!smallStates.count(firstState) || !smallStates.count(secondState))
+					{	// the states do not occur in the smaller automaton
+						continue;
+					}
+
+					BOOST_REQUIRE_MESSAGE(smallSim.get(firstState, secondState) ==
+						removedSim.get(firstState, secondState),
+						"Invalid value of the simulation after removing transitions for (" +
+						firstStringStatePair.first + ", " + secondStringStatePair.first + ")");
+				}
+			}
+		});
+}
+
+BOOST_AUTO_TEST_CASE(determinization)
+{
+	this->runOnSmallAutomataSet(
+		[](const AutType& aut, const StateDict& stateDict, const std::string& filename)
+		{
+			BOOST_TEST_MESSAGE("Checking determinization for " + filename + "...");
+
+			std::vector<AutType> detAuts;
+			detAuts.push_back(aut.Determinize());
+
+			if (aut.begin() != aut.end())
+			{	// upward simulation is not computed for automata without transitions
+				SimParam sp;
+				sp.SetRelation(VATA::SimParam::e_sim_relation::TA_UPWARD);
+				sp.SetNumStates(stateDict.size());
+				StateDiscontBinaryRelation sim = aut.ComputeSimulation(sp);
+
+				detAuts.push_back(aut.Determinize(sim));
+			}
+
+			for (const AutType& detAut : detAuts)
+			{
+				std::set<std::pair<SymbolType, StateTuple>> lhsSides;
+				for (const Transition& trans : detAut)
+				{
+					BOOST_REQUIRE_MESSAGE(lhsSides.insert(
+						std::make_pair(trans.GetSymbol(), trans.GetChildren())).second,
+						"The determinized automaton is not deterministic: " +
+						detAut.ToString(trans));
+				}
+
+				BOOST_REQUIRE_MESSAGE(AutType::CheckInclusion(aut, detAut) &&
+					AutType::CheckInclusion(detAut, aut),
+					"The language of the determinized automaton differs");
+			}
+		});
+}
+
+BOOST_AUTO_TEST_CASE(minimization)
+{
+	this->runOnSmallAutomataSet(
+		[](const AutType& aut, const StateDict& /* stateDict */, const std::string& filename)
+		{
+			BOOST_TEST_MESSAGE("Checking minimization for " + filename + "...");
+
+			AutType detAut = aut.Determinize();
+			AutType minAut = detAut.Minimize();
+
+			BOOST_REQUIRE_MESSAGE(AutType::CheckInclusion(aut, minAut) &&
+				AutType::CheckInclusion(minAut, aut),
+				"The language of the minimized automaton differs");
+
+			size_t detStates = detAut.RemoveUselessStates().GetUsedStates().size();
+			size_t minStates = minAut.GetUsedStates().size();
+			BOOST_REQUIRE_MESSAGE(minStates <= detStates,
+				"The minimized automaton has more states than the deterministic one");
+
+			// the minimal automaton of the language is unique
+			size_t minMinStates = minAut.Determinize().Minimize().GetUsedStates().size();
+			BOOST_REQUIRE_MESSAGE(minStates == minMinStates,
+				"Invalid number of states of the minimized automaton: expected " +
+				Convert::ToString(minStates) + ", got " + Convert::ToString(minMinStates));
+		});
+
+	// leaves 1 and 2 are equivalent iff they can be exchanged at any position
+	AutType pairAut;
+	pairAut.AddTransition(StateTuple(), 0, 1);
+	pairAut.AddTransition(StateTuple(), 1, 2);
+	pairAut.AddTransition(StateTuple({1, 2}), 2, 3);
+	pairAut.AddTransition(StateTuple({2, 1}), 2, 3);
+	pairAut.AddTransition(StateTuple({1, 1}), 2, 3);
+	pairAut.SetStateFinal(3);
+	BOOST_CHECK_EQUAL(pairAut.Minimize().GetUsedStates().size(), 3);
+
+	pairAut.AddTransition(StateTuple({2, 2}), 2, 3);
+	BOOST_CHECK_EQUAL(pairAut.Minimize().GetUsedStates().size(), 2);
+
+	AutType nondetAut;
+	nondetAut.AddTransition(StateTuple(), 0, 1);
+	nondetAut.AddTransition(StateTuple(), 0, 2);
+	BOOST_CHECK_THROW(nondetAut.Minimize(), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(reduction)
+{
+	using VATA::ReduceParam;
+
+	this->runOnSmallAutomataSet(
+		[](const AutType& aut, const StateDict& /* stateDict */, const std::string& filename)
+		{
+			BOOST_TEST_MESSAGE("Checking reduction for " + filename + "...");
+
+			for (ReduceParam::e_reduce_relation relation :
+				{ReduceParam::e_reduce_relation::TA_DOWNWARD,
+				ReduceParam::e_reduce_relation::TA_UPWARD,
+				ReduceParam::e_reduce_relation::TA_DOWNWARD_UPWARD,
+				ReduceParam::e_reduce_relation::TA_BISIMULATION})
+			{
+				ReduceParam params;
+				params.SetRelation(relation);
+				AutType redAut = aut.Reduce(params);
+
+				BOOST_REQUIRE_MESSAGE(AutType::CheckInclusion(aut, redAut) &&
+					AutType::CheckInclusion(redAut, aut),
+					"The language of the reduced automaton differs for " +
+					params.toString() + " on " + filename);
+			}
+		});
+
+	AutType aut;
+	aut.AddTransition(StateTuple(), 0, 1);
+	aut.AddTransition(StateTuple(), 0, 2);
+	aut.AddTransition(StateTuple({1}), 1, 3);
+	aut.AddTransition(StateTuple({2}), 1, 4);
+	aut.AddTransition(StateTuple({3, 4}), 2, 5);
+	aut.SetStateFinal(5);
+
+	ReduceParam params;
+	params.SetRelation(ReduceParam::e_reduce_relation::TA_BISIMULATION);
+	BOOST_CHECK_EQUAL(aut.Reduce(params).GetUsedStates().size(), 3);
+
+	// states 0, 6 and 7 are useless, so the states of the trimmed automaton are
+	// not numbered contiguously; the reduced automaton keeps the numbers
+	aut.AddTransition(StateTuple(), 0, 0);
+	aut.AddTransition(StateTuple({0}), 1, 6);
+	aut.AddTransition(StateTuple({6, 5}), 2, 7);
+	aut.AddTransition(StateTuple({5}), 1, 8);
+	aut.SetStateFinal(8);
+
+	params.SetRelation(ReduceParam::e_reduce_relation::TA_UPWARD);
+	AutType upRedAut = aut.Reduce(params);
+	BOOST_CHECK(AutType::CheckInclusion(aut, upRedAut) &&
+		AutType::CheckInclusion(upRedAut, aut));
+	for (const size_t& state : upRedAut.GetUsedStates())
+	{
+		BOOST_CHECK((state != 0) && (state <= 8));
+	}
+}
+
+BOOST_AUTO_TEST_CASE(incremental_reachability)
+{
+	this->runOnSmallAutomataSet(
+		[](const AutType& aut, const StateDict& /* stateDict */, const std::string& filename)
+		{
+			BOOST_TEST_MESSAGE("Checking incremental reachability for " + filename + "...");
+
+			std::vector<Transition> transitions;
+			for (const Transition& trans : aut)
+			{
+				transitions.push_back(trans);
+			}
+
+			// transitions are added top-down so that states become productive late
+			std::reverse(transitions.begin(), transitions.end());
+
+			AutType incrAut(aut, false, true);
+			incrAut.EnableIncrementalReachability();
+			BOOST_REQUIRE(incrAut.IsIncrementalReachabilityEnabled());
+
+			AutType batchAut(aut, false, true);
+
+			auto checkF = [&]()
+			{
+				BOOST_REQUIRE_MESSAGE(incrAut.IsLangEmpty() == batchAut.IsLangEmpty(),
+					"Invalid result of the incremental emptiness check");
+
+				for (const StateType& state : aut.GetUsedStates())
+				{
+					BOOST_REQUIRE_MESSAGE(
+						incrAut.IsStateProductive(state) == batchAut.IsStateProductive(state),
+						"Invalid productivity of the state " + Convert::ToString(state));
+				}
+			};
+
+			for (size_t i = 0; i < transitions.size(); ++i)
+			{
+				incrAut.AddTransition(transitions[i]);
+				batchAut.AddTransition(transitions[i]);
+
+				if (transitions.size() / 2 == i)
+				{
+					checkF();
+				}
+			}
+
+			checkF();
+			BOOST_REQUIRE(incrAut.IsLangEmpty() == aut.IsLangEmpty());
+
+			// the productive final states are counted also when final states change
+			incrAut.EraseFinalStates();
+			batchAut.EraseFinalStates();
+			BOOST_REQUIRE(incrAut.IsLangEmpty());
+
+			for (const StateType& state : aut.GetFinalStates())
+			{
+				incrAut.SetStateFinal(state);
+				incrAut.SetStateFinal(state);
+				batchAut.SetStateFinal(state);
+				checkF();
+			}
+
+			BOOST_REQUIRE(incrAut.IsLangEmpty() == aut.IsLangEmpty());
+		});
+}
+
+BOOST_AUTO_TEST_CASE(inclusion_portfolio)
+{
+	auto testfileContent = ParseTestFile(INCLUSION_TIMBUK_FILE.string());
+
+	const size_t numConfigs = AutType::GetDefaultInclusionPortfolio().size();
+
+	for (auto testcase : testfileContent)
+	{
+		BOOST_REQUIRE_MESSAGE(testcase.size() == 3, "Invalid format of a testcase: " +
+			Convert::ToString(testcase));
+
+		std::string inputSmallerFile = (AUT_DIR / testcase[0]).string();
+		std::string inputBiggerFile = (AUT_DIR / testcase[1]).string();
+		bool expectedResult = static_cast<bool>(
+			Convert::FromString<unsigned>(testcase[2]));
+
+		BOOST_TEST_MESSAGE("Testing portfolio inclusion " +
+			inputSmallerFile + " <= " + inputBiggerFile  + "...");
+
+		AutType autSmaller;
+		readAut(autSmaller, VATA::Util::ReadFile(inputSmallerFile));
+
+		AutType autBigger;
+		readAut(autBigger, VATA::Util::ReadFile(inputBiggerFile));
+
+		// the portfolio sanitizes the automata itself
+		BOOST_CHECK_MESSAGE(expectedResult == AutType::CheckInclusionPortfolio(
+			autSmaller, autBigger, AutType::GetDefaultInclusionPortfolio()),
+			"\n\nError checking inclusion of unsanitized automata " +
+			inputSmallerFile + " <= " + inputBiggerFile);
+		BOOST_CHECK(AutType::CheckInclusionPortfolio(autBigger, autBigger,
+			AutType::GetDefaultInclusionPortfolio()));
+
+		AutBase::SanitizeAutsForInclusion(autSmaller, autBigger);
+
+		size_t winner = numConfigs;
+		bool doesInclusionHold = AutType::CheckInclusionPortfolio(autSmaller,
+			autBigger, AutType::GetDefaultInclusionPortfolio(), &winner);
+		BOOST_CHECK_MESSAGE(expectedResult == doesInclusionHold,
+			"\n\nError checking inclusion " + inputSmallerFile + " <= " +
+			inputBiggerFile + ": expected " + Convert::ToString(expectedResult) +
+			", got " + Convert::ToString(doesInclusionHold));
+		BOOST_CHECK(winner < numConfigs);
+
+		// a cancelled check does not give an answer
+		VATA::CancellationToken cancel;
+		cancel.Cancel();
+
+		VATA::InclParam ip;
+		ip.SetDirection(InclParam::e_direction::downward);
+		ip.SetCancellationToken(&cancel);
+
+		if (!autSmaller.GetFinalStates().empty())
+		{
+			BOOST_CHECK_THROW(AutType::CheckInclusion(autSmaller, autBigger, ip),
+				VATA::OperationCancelledException);
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE(inclusion_batch)
+{
+	auto testfileContent = ParseTestFile(INCLUSION_TIMBUK_FILE.string());
+
+	std::vector<VATA::InclParam> configs(4);
+	configs[0].SetDirection(InclParam::e_direction::upward);
+	configs[1].SetDirection(InclParam::e_direction::downward);
+	configs[1].SetUseSimulation(true);
+	configs[2].SetDirection(InclParam::e_direction::downward);
+	configs[2].SetUseRecursion(true);
+	configs[3].SetDirection(InclParam::e_direction::upward);
+	configs[3].SetUseSimulation(true);
+	configs[3].SetNumThreads(4);
+
+	for (auto testcase : testfileContent)
+	{
+		BOOST_REQUIRE_MESSAGE(testcase.size() == 3, "Invalid format of a testcase: " +
+			Convert::ToString(testcase));
+
+		std::string inputSmallerFile = (AUT_DIR / testcase[0]).string();
+		std::string inputBiggerFile = (AUT_DIR / testcase[1]).string();
+		bool expectedResult = static_cast<bool>(
+			Convert::FromString<unsigned>(testcase[2]));
+
+		BOOST_TEST_MESSAGE("Testing batch inclusion " +
+			inputSmallerFile + " <= " + inputBiggerFile  + "...");
+
+		AutType autSmaller;
+		readAut(autSmaller, VATA::Util::ReadFile(inputSmallerFile));
+
+		AutType autBigger;
+		readAut(autBigger, VATA::Util::ReadFile(inputBiggerFile));
+
+		// the automata are not sanitized, the batch check does it itself
+		std::vector<AutType> biggers = {autBigger, autSmaller, autBigger};
+
+		for (const VATA::InclParam& ip : configs)
+		{
+			std::vector<bool> expected = {expectedResult, true, expectedResult};
+			BOOST_CHECK_MESSAGE(expected ==
+				AutType::CheckInclusionBatch(autSmaller, biggers, ip),
+				"\n\nError checking batch inclusion " + inputSmallerFile + " <= " +
+				inputBiggerFile + " with " + ip.toString());
+
+			expected = {expectedResult, !expectedResult, false};
+			BOOST_CHECK_MESSAGE(expected ==
+				AutType::CheckInclusionBatch(autSmaller, biggers, ip, true),
+				"\n\nError checking batch inclusion (stopping at the first success) " +
+				inputSmallerFile + " <= " + inputBiggerFile + " with " + ip.toString());
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE(inclusion_counterexample)
+{
+	auto testfileContent = ParseTestFile(INCLUSION_TIMBUK_FILE.string());
+
+	std::vector<VATA::InclParam> configs(6);
+	configs[0].SetDirection(InclParam::e_direction::upward);
+	configs[1].SetDirection(InclParam::e_direction::upward);
+	configs[1].SetUseSimulation(true);
+	configs[2].SetDirection(InclParam::e_direction::downward);
+	configs[2].SetUseSimulation(true);
+	configs[3].SetDirection(InclParam::e_direction::downward);
+	configs[3].SetUseRecursion(true);
+	configs[4].SetAlgorithm(InclParam::e_algorithm::congruences);
+	configs[4].SetSearchOrder(InclParam::e_search_order::depth);
+	configs[5].SetAlgorithm(InclParam::e_algorithm::congruences);
+	configs[5].SetSearchOrder(InclParam::e_search_order::breadth);
+
+	for (auto testcase : testfileContent)
+	{
+		BOOST_REQUIRE_MESSAGE(testcase.size() == 3, "Invalid format of a testcase: " +
+			Convert::ToString(testcase));
+
+		std::string inputSmallerFile = (AUT_DIR / testcase[0]).string();
+		std::string inputBiggerFile = (AUT_DIR / testcase[1]).string();
+		bool expectedResult = static_cast<bool>(
+			Convert::FromString<unsigned>(testcase[2]));
+
+		BOOST_TEST_MESSAGE("Testing inclusion counterexample " +
+			inputSmallerFile + " <= " + inputBiggerFile  + "...");
+
+		AutType autSmaller;
+		readAut(autSmaller, VATA::Util::ReadFile(inputSmallerFile));
+
+		AutType autBigger;
+		readAut(autBigger, VATA::Util::ReadFile(inputBiggerFile));
+
+		AutBase::SanitizeAutsForInclusion(autSmaller, autBigger);
+
+		for (const VATA::InclParam& ip : configs)
+		{
+			AutType counterexample;
+			BOOST_REQUIRE(expectedResult ==
+				AutType::CheckInclusion(autSmaller, autBigger, ip, &counterexample));
+
+			if (expectedResult)
+			{
+				continue;
+			}
+
+			// the counterexample is a tree of the smaller automaton which the
+			// bigger one does not accept
+			BOOST_CHECK_MESSAGE(!counterexample.IsLangEmpty() &&
+				AutType::CheckInclusion(counterexample, autSmaller) &&
+				!AutType::CheckInclusion(counterexample, autBigger),
+				"\n\nWrong counterexample to inclusion " + inputSmallerFile + " <= " +
+				inputBiggerFile + " with " + ip.toString());
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE(equivalence)
+{
+	auto testfileContent = ParseTestFile(INCLUSION_TIMBUK_FILE.string());
+
+	std::vector<VATA::InclParam> configs(2);
+	configs[0].SetSearchOrder(InclParam::e_search_order::depth);
+	configs[1].SetSearchOrder(InclParam::e_search_order::breadth);
+
+	for (auto testcase : testfileContent)
+	{
+		BOOST_REQUIRE_MESSAGE(testcase.size() == 3, "Invalid format of a testcase: " +
+			Convert::ToString(testcase));
+
+		std::string inputLhsFile = (AUT_DIR / testcase[0]).string();
+		std::string inputRhsFile = (AUT_DIR / testcase[1]).string();
+
+		BOOST_TEST_MESSAGE("Testing equivalence " +
+			inputLhsFile + " == " + inputRhsFile  + "...");
+
+		AutType autLhs;
+		readAut(autLhs, VATA::Util::ReadFile(inputLhsFile));
+
+		AutType autRhs;
+		readAut(autRhs, VATA::Util::ReadFile(inputRhsFile));
+
+		// the reference are two inclusion checks
+		bool expectedResult = true;
+		for (auto autPair : {std::make_pair(autLhs, autRhs), std::make_pair(autRhs, autLhs)})
+		{
+			AutBase::SanitizeAutsForInclusion(autPair.first, autPair.second);
+			expectedResult = expectedResult &&
+				AutType::CheckInclusion(autPair.first, autPair.second);
+		}
+
+		AutType autLhsUnion = AutType::Union(autLhs, autLhs);
+
+		for (const VATA::InclParam& ip : configs)
+		{
+			BOOST_CHECK_MESSAGE(expectedResult ==
+				AutType::CheckEquivalence(autLhs, autRhs, ip),
+				"\n\nError checking equivalence " + inputLhsFile + " == " +
+				inputRhsFile + " with " + ip.toString());
+
+			BOOST_CHECK_MESSAGE(AutType::CheckEquivalence(autLhsUnion, autLhs, ip),
+				"\n\nError checking equivalence of " + inputLhsFile +
+				" and its union with itself with " + ip.toString());
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE(cancellation_budgets)
+{
+	using VATA::CancellationToken;
+	using VATA::OperationCancelledException;
+	using VATA::ReduceParam;
+
+	auto checkCancelled = [](
+		const std::function<void()>&          operation,
+		OperationCancelledException::e_reason reason,
+		const std::string&                    message)
+	{
+		try
+		{
+			operation();
+			BOOST_ERROR("The operation was not cancelled: " + message);
+		}
+		catch (const OperationCancelledException& ex)
+		{
+			BOOST_CHECK_MESSAGE(reason == ex.GetReason(),
+				"Invalid reason of cancellation: " + message);
+		}
+	};
+
+	this->runOnSmallAutomataSet(
+		[&checkCancelled](const AutType& aut, const StateDict& stateDict,
+			const std::string& filename)
+		{
+			BOOST_TEST_MESSAGE("Checking cancellation for " + filename + "...");
+
+			if (stateDict.size() == 0)
+			{
+				return;
+			}
+
+			CancellationToken noSteps;
+			noSteps.SetStepBudget(0);
+
+			checkCancelled([&]{ aut.Complement(&noSteps); },
+				OperationCancelledException::e_reason::steps, "complement of " + filename);
+			BOOST_CHECK(noSteps.IsCancelled());
+
+			SimParam sp;
+			sp.SetRelation(VATA::SimParam::e_sim_relation::TA_DOWNWARD);
+			sp.SetNumStates(stateDict.size());
+			sp.SetCancellationToken(&noSteps);
+			checkCancelled([&]{ aut.ComputeSimulation(sp); },
+				OperationCancelledException::e_reason::steps, "simulation of " + filename);
+
+			CancellationToken expired;
+			expired.SetDeadline(CancellationToken::Clock::now() - std::chrono::seconds(1));
+
+			ReduceParam rp;
+			rp.SetRelation(ReduceParam::e_reduce_relation::TA_DOWNWARD);
+			rp.SetCancellationToken(&expired);
+			checkCancelled([&]{ aut.Reduce(rp); },
+				OperationCancelledException::e_reason::deadline, "reduction of " + filename);
+
+			if (!aut.IsLangEmpty())
+			{	// a child token is cancelled with its parent
+				CancellationToken child(&expired);
+				VATA::InclParam ip;
+				ip.SetDirection(InclParam::e_direction::upward);
+				ip.SetUseSimulation(true);
+				ip.SetCancellationToken(&child);
+				checkCancelled([&]{ AutType::CheckInclusion(aut, aut, ip); },
+					OperationCancelledException::e_reason::deadline, "inclusion of " + filename);
+				BOOST_CHECK(OperationCancelledException::e_reason::deadline == child.GetReason());
+
+				// the non-recursive downward inclusion polls the token itself
+				for (size_t threads : {1, 2})
+				{
+					CancellationToken downExpired;
+					downExpired.SetDeadline(CancellationToken::Clock::now() - std::chrono::seconds(1));
+
+					VATA::InclParam downParam;
+					downParam.SetDirection(InclParam::e_direction::downward);
+					downParam.SetUseRecursion(false);
+					downParam.SetNumThreads(threads);
+					downParam.SetCancellationToken(&downExpired);
+					checkCancelled([&]{ AutType::CheckInclusion(aut, aut, downParam); },
+						OperationCancelledException::e_reason::deadline,
+						"downward inclusion of " + filename);
+				}
+			}
+
+			// sufficient budgets do not change the result
+			CancellationToken generous;
+			generous.SetTimeout(std::chrono::hours(1));
+			generous.SetMemoryBudget(static_cast<size_t>(1) << 40);
+			AutType autCmpl = aut.Complement(&generous);
+			BOOST_CHECK(AutType::Intersection(aut, autCmpl).IsLangEmpty());
+			BOOST_CHECK(!generous.IsCancelled());
+			BOOST_CHECK(generous.GetSteps() > 0);
+
+			// the states of the automata overlap, the simulation needs to be
+			// computed on the sanitized automata
+			for (InclParam::e_direction dir :
+				{InclParam::e_direction::upward, InclParam::e_direction::downward})
+			{
+				VATA::InclParam ip;
+				ip.SetDirection(dir);
+				ip.SetUseSimulation(true);
+				ip.SetCancellationToken(&generous);
+				BOOST_CHECK_MESSAGE(AutType::CheckInclusion(aut, aut, ip),
+					"Inclusion with a budget does not hold for " + filename);
+			}
+			BOOST_CHECK(!generous.IsCancelled());
+		});
+
+	AutType aut;
+	aut.AddTransition(StateTuple(), 0, 1);
+	aut.AddTransition(StateTuple(), 0, 2);
+	aut.AddTransition(StateTuple({1}), 1, 3);
+	aut.AddTransition(StateTuple({2}), 1, 4);
+	aut.AddTransition(StateTuple({3, 4}), 2, 5);
+	aut.SetStateFinal(5);
+
+	CancellationToken cancelled;
+	cancelled.Cancel();
+
+	ReduceParam params;
+	params.SetRelation(ReduceParam::e_reduce_relation::TA_BISIMULATION);
+	params.SetCancellationToken(&cancelled);
+	checkCancelled([&]{ aut.Reduce(params); },
+		OperationCancelledException::e_reason::cancelled, "bisimulation reduction");
+}
+
 BOOST_AUTO_TEST_SUITE_END()